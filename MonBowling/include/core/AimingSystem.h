@@ -13,6 +13,12 @@
 #include <OgrePanelOverlayElement.h>
 #include <OgreInput.h>
 #include <OgreLogManager.h>
+#include <memory>
+#include <vector>
+
+class BowlingBall;
+class BowlingLane;
+class TrajectoryPredictor;
 
 // Constantes pour la puissance et le spin
 const float MIN_POWER = 0.0f;
@@ -70,6 +76,16 @@ class AimingSystem {
         float mSpinSensitivity;    // Sensibilité du contrôle de spin
         bool mShowSpinPreview;     // Option pour afficher un aperçu de la trajectoire
 
+        // Aperçu de la trajectoire : lancer simulé en arrière-plan, tracé en polyligne
+        std::unique_ptr<TrajectoryPredictor> mTrajectoryPredictor;
+        Ogre::SceneNode* mTrajectoryNode;
+        Ogre::ManualObject* mTrajectoryLine;
+        std::vector<Ogre::Vector3> mTrajectoryPath;
+        // Valeurs de la dernière demande (une nouvelle simulation seulement si elles changent)
+        Ogre::Vector3 mPreviewDirection;
+        float mPreviewPower;
+        float mPreviewSpin;
+
         // Variables pour la gestion des touches maintenues (optionnel, si on veut une augmentation continue)
         // bool mKeyUpPressed;
         // bool mKeyDownPressed;
@@ -82,12 +98,19 @@ class AimingSystem {
         void updatePowerBarDisplay(); 
         void updateSpinIndicatorDisplay(); 
         void updateTrajectoryPreview();
+        void createTrajectoryLine();
+        void rebuildTrajectoryLine();
+        void hideTrajectoryPreview();
 
     public:
         AimingSystem(Ogre::SceneManager* sceneMgr, Ogre::Camera* camera);
         ~AimingSystem();
 
         void initialize();
+        // Active l'aperçu de la trajectoire : monde fantôme (piste de même collider que lane,
+        // avec son motif d'huilage, + copie du corps de ball) partant de ballStart
+        void enableTrajectoryPreview(const Ogre::Vector3& ballStart, const BowlingBall& ball,
+                                     const BowlingLane& lane, float tickRate);
         void update(float deltaTime); 
 
         // Gestion des entrées (appelé par GameManager)
@@ -19,6 +19,7 @@
 #include "../../include/objects/BowlingBall.h"
 #include "../../include/objects/BowlingLane.h"
 #include "../../include/managers/AudioManager.h"
+#include "../../include/core/PhysicsStatsOverlay.h"
 
 // Inclusion FMOD (supposant chemin global configuré)
 #include <fmod.hpp>
@@ -47,6 +48,9 @@ class Application : public OgreBites::ApplicationContext, public OgreBites::Inpu
         // Boule de bowling
         std::unique_ptr<BowlingBall> ball;
 
+        // Mesures de la physique : panneau (F3) et fichier par frame (F4)
+        std::unique_ptr<PhysicsStatsOverlay> physicsStatsOverlay;
+
         // Retrait des états de touches (gérés par GameManager/AimingSystem)
         // bool mKeyW, mKeyA, mKeyS, mKeyD, mKeySpace, mKeyC;
 
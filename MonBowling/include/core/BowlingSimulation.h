@@ -0,0 +1,107 @@
+#ifndef BOWLING_SIMULATION_H
+#define BOWLING_SIMULATION_H
+
+#include <Ogre.h>
+#include <memory>
+
+#include "FrameLogic.h"
+#include "../managers/PhysicsManager.h"
+#include "../objects/BowlingBall.h"
+#include "../objects/BowlingLane.h"
+#include "../utils/RollSettleDetector.h"
+
+// Partie de bowling complète sans rendu ni audio : piste, boule, quilles,
+// progression des frames et score. Chaque lancer est simulé à pas fixes
+// jusqu'au repos de la boule et des quilles, aussi vite que le processeur le permet.
+//
+// Nécessite un Ogre::LogManager (pour les logs) mais ni Ogre::Root ni fenêtre.
+// Chaque instance peut utiliser son propre monde physique et son propre ScoreManager
+// (un par thread, voir LaneSession) ; sinon le score passe par le singleton.
+class GameReplay;
+class ScoreManager;
+
+class BowlingSimulation {
+    private:
+        PhysicsManager* physics;
+        ScoreManager* scores;
+        std::unique_ptr<BowlingLane> lane;
+        std::unique_ptr<BowlingBall> ball;
+        FrameLogic frameLogic;
+        RollSettleDetector settleDetector;
+        GameReplay* recorder;       // nullptr : pas d'enregistrement
+
+        // Durée maximale simulée pour un lancer (sécurité si rien ne s'immobilise jamais)
+        float maxRollTime;
+        // Temps simulé du dernier lancer, jusqu'au repos complet, et son nombre de pas
+        float lastRollTime;
+        int lastRollSteps;
+
+        // Lancer en cours (startThrow / stepThrow)
+        bool throwing;
+        float throwTime;
+        int throwSteps;
+        Ogre::Vector3 throwDirection;
+        float throwPower;
+        float throwSpin;
+
+        // Mêmes positions que Application::createScene
+        const Ogre::Vector3 LANE_ORIGIN = Ogre::Vector3(0.0f, 0.0f, 0.0f);
+        const float BALL_START_Z = 7.0f;
+
+    public:
+        // physics == nullptr : PhysicsManager::getInstance(), scores == nullptr : ScoreManager::getInstance()
+        explicit BowlingSimulation(PhysicsManager* physics = nullptr, ScoreManager* scores = nullptr);
+        ~BowlingSimulation();
+
+        // Crée le monde physique (sans rendu), la piste, les quilles et la boule.
+        // world : enregistrement du jeu dont le monde est recréé (GameReplay::applyWorld) ;
+        // la boule et les quilles sont alors placées par son journal (replayEvents)
+        void initialize(const GameReplay* world = nullptr);
+
+        // Nouvelle partie : score, frames, boule et quilles réinitialisés
+        void resetGame();
+
+        // Simule un lancer complet et retourne le résultat pour la logique des frames
+        RollResult roll(const Ogre::Vector3& direction, float power, float spin);
+
+        // Simule un lancer sur le jeu de quilles actuel, sans toucher au score ni aux frames.
+        // Retourne le masque des quilles couchées (voir BowlingLane::getKnockedDownMask).
+        int throwBall(const Ogre::Vector3& direction, float power, float spin);
+
+        // Même lancer, pas par pas (plusieurs pistes avancées à tour de rôle) : startThrow,
+        // stepThrow jusqu'à true (repos ou maxRollTime), puis finishRoll pour le compter
+        void startThrow(const Ogre::Vector3& direction, float power, float spin);
+        bool stepThrow();
+        // Compte le lancer terminé (frames, score, enregistrement) et prépare le suivant
+        RollResult finishRoll();
+        bool isThrowing() const { return throwing; }
+
+        // Boule au départ et dix quilles debout
+        void resetRack();
+
+        // Rejoue le journal d'un enregistrement du jeu dans un monde créé par initialize(&recorded),
+        // comme GameManager (détecteur de quilles, instantané de reprise) : chaque lancer compté
+        // est ajouté à replayed, déjà commencé. Retourne le nombre de pas simulés, -1 si le
+        // journal ne peut pas être suivi (reprise sans instantané).
+        int replayEvents(const GameReplay& recorded, GameReplay& replayed);
+
+        // Chaque lancer de roll() est ajouté à replay (entrées et quilles au repos), qui doit
+        // avoir été commencé (GameReplay::begin) ; le score final est noté en fin de partie
+        void setRecorder(GameReplay* replay) { recorder = replay; }
+
+        void setMaxRollTime(float seconds) { maxRollTime = seconds; }
+        RollSettleDetector& getSettleDetector() { return settleDetector; }
+        float getLastRollTime() const { return lastRollTime; }
+        // Pas physiques du dernier lancer, du lancement au pas où il s'est terminé
+        int getLastRollSteps() const { return lastRollSteps; }
+
+        bool isGameOver() const { return frameLogic.isGameOver(); }
+        int getScore() const;
+        const FrameLogic& getFrameLogic() const { return frameLogic; }
+        BowlingBall* getBall() const { return ball.get(); }
+        BowlingLane* getLane() const { return lane.get(); }
+        PhysicsManager* getPhysics() const { return physics; }
+        ScoreManager* getScores() const { return scores; }
+};
+
+#endif // BOWLING_SIMULATION_H
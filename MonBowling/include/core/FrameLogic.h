@@ -0,0 +1,42 @@
+#ifndef FRAME_LOGIC_H
+#define FRAME_LOGIC_H
+
+// Résultat d'un lancer vu par la logique des frames
+struct RollResult {
+    int pinsThisRoll = 0;   // Quilles abattues par ce lancer uniquement
+    bool strike = false;
+    bool spare = false;
+    bool resetRack = false; // Les quilles doivent être relevées avant le prochain lancer
+    bool frameOver = false;
+    bool gameOver = false;
+};
+
+// Progression des frames et des lancers d'une partie (sans Ogre, sans rendu).
+// Reçoit le nombre total de quilles couchées depuis le dernier relevage
+// et en déduit le lancer suivant, y compris les lancers bonus de la 10e frame.
+class FrameLogic {
+    private:
+        int currentFrame;
+        int currentRollInFrame;
+        int pinsDownInRack;        // Quilles déjà couchées dans le jeu de quilles actuel
+        bool firstBallInRack;      // Prochain lancer : premier sur un jeu de quilles complet
+        bool tenthFrameBonus;      // Strike ou spare obtenu dans la 10e frame
+        bool gameOver;
+
+    public:
+        static const int MAX_FRAMES = 10;
+
+        FrameLogic();
+
+        void reset();
+
+        // Enregistre un lancer à partir des quilles couchées depuis le dernier relevage
+        RollResult recordRoll(int totalPinsDownSinceReset);
+
+        int getCurrentFrame() const { return currentFrame; }
+        int getCurrentRollInFrame() const { return currentRollInFrame; }
+        int getPinsDownInRack() const { return pinsDownInRack; }
+        bool isGameOver() const { return gameOver; }
+};
+
+#endif // FRAME_LOGIC_H
@@ -0,0 +1,122 @@
+#ifndef GAME_HISTORY_H
+#define GAME_HISTORY_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../states/ScoreRules.h"
+#include "../utils/MappedFile.h"
+
+// Historique des parties terminées : journal en colonnes, en ajout seul, projeté en mémoire.
+// Un dossier contient un fichier par colonne (joueur, date, piste, lancers, scores des
+// frames, score final, paramètres de lancer, quilles laissées) et la liste des joueurs.
+// Les requêtes ne parcourent que les colonnes dont elles ont besoin ; le système ne charge
+// que les pages lues, l'historique n'est jamais copié en mémoire.
+//
+// Ajout : les enregistrements de toutes les colonnes sont écrits, puis leurs compteurs.
+// Une partie interrompue entre les deux (arrêt brutal) est ignorée puis écrasée.
+class GameHistory {
+    public:
+        // Entrées d'un lancer (AimingSystem : x de la direction normalisée, vitesse, spin)
+        struct Launch {
+            float aim = 0.0f;
+            float power = 0.0f;
+            float spin = 0.0f;
+        };
+
+        struct Record {
+            std::string player;
+            int64_t date = 0;           // Secondes depuis 1970 (UTC)
+            int lane = 1;
+            int rollCount = 0;
+            std::array<int, ScoreRules::MAX_ROLLS> rolls{};
+            std::array<int, ScoreRules::FRAME_COUNT> frameScores{};
+            int finalScore = 0;
+            std::array<Launch, ScoreRules::MAX_ROLLS> launches{};
+            // Quilles debout après la première boule de chaque frame (bit i = pins[i] de
+            // BowlingLane), 0 après un strike
+            std::array<uint16_t, ScoreRules::FRAME_COUNT> leaves{};
+        };
+
+        // Parties retenues par une requête (valeurs négatives : pas de filtre)
+        struct Filter {
+            int player;                 // Identifiant (findPlayer)
+            int lane;
+            int64_t from;               // Dates incluses
+            int64_t to;
+            Filter() : player(-1), lane(-1), from(-1), to(-1) {}
+        };
+
+        struct Summary {
+            int games = 0;
+            double averageScore = 0.0;
+            int highScore = 0;
+            int lowScore = 0;
+            MarkCounts marks;
+            double strikePercent() const { return marks.strikeChances ? 100.0 * marks.strikes / marks.strikeChances : 0.0; }
+            double sparePercent() const { return marks.spareChances ? 100.0 * marks.spares / marks.spareChances : 0.0; }
+        };
+
+        struct LaneSummary {
+            int lane = 0;
+            Summary summary;
+        };
+
+        // Première boule de chaque frame : leaves[masque des quilles debout] (0 : strike)
+        typedef std::array<uint32_t, 1 << 10> LeaveCounts;
+
+        static const int COLUMN_COUNT = 8;
+
+    private:
+        // Colonnes, dans l'ordre des fichiers
+        enum Column {
+            PLAYER, DATE, LANE, ROLLS, FRAME_SCORES, SCORE, LAUNCHES, LEAVES
+        };
+
+        MappedFile mColumns[COLUMN_COUNT];
+        std::string mDirectory;
+        size_t mCount;
+        std::vector<std::string> mPlayers;
+        std::unordered_map<std::string, int> mPlayerIds;
+
+        bool openColumn(Column column);
+        // Place pour une partie de plus dans chaque colonne (fichiers agrandis par blocs)
+        bool reserve(size_t count);
+        template <typename T> T* column(Column column);
+        template <typename T> const T* column(Column column) const;
+        void setColumnCount(Column column, size_t count);
+        int addPlayer(const std::string& name);
+        // visit(row) pour chaque partie retenue, dans l'ordre du journal ; seules les
+        // colonnes des critères actifs sont lues
+        template <typename Visit> void forEach(const Filter& filter, Visit visit) const;
+        static void accumulate(Summary& summary, int64_t& scoreSum, int score, const PackedGame& rolls);
+
+    public:
+        GameHistory();
+        ~GameHistory();
+
+        // Ouvre ou crée l'historique du dossier ; false si un fichier est illisible
+        bool open(const std::string& directory);
+        void close();
+        // false aussi après un agrandissement impossible (disque plein) : historique fermé
+        bool isOpen() const { return !mDirectory.empty(); }
+
+        bool append(const Record& record);
+        // Écriture sur disque des pages modifiées (sans attendre)
+        void flush();
+
+        size_t getGameCount() const { return mCount; }
+        // -1 si le joueur n'a aucune partie
+        int findPlayer(const std::string& name) const;
+        const std::vector<std::string>& getPlayers() const { return mPlayers; }
+        bool getRecord(size_t index, Record& record) const;
+
+        Summary summarize(const Filter& filter = Filter()) const;
+        std::vector<LaneSummary> summarizeLanes(const Filter& filter = Filter()) const;
+        void countLeaves(LeaveCounts& counts, const Filter& filter = Filter()) const;
+};
+
+#endif // GAME_HISTORY_H
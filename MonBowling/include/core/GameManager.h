@@ -6,9 +6,15 @@
 #include <string> // Pour std::string
 
 #include "AimingSystem.h"
+#include "FrameLogic.h"
+#include "GameHistory.h"
+#include "GameReplay.h"
+#include "GameState.h"
+#include "GameStateMachine.h"
 #include "../states/ScoreManager.h"
 #include "../utils/PinDetector.h"
 #include "../managers/CameraFollower.h"
+#include "../managers/PhysicsSnapshot.h"
 #include "../include/objects/BowlingBall.h"
 #include "../include/objects/BowlingLane.h"
 
@@ -24,17 +30,9 @@ namespace OgreBites {
     class KeyboardEvent;
 }
 
-// Enum pour les états de jeu
-enum class GameState {
-    AIMING,
-    POWER,
-    ROLLING,
-    SCORING,
-    // RESET, // Obsolète, géré par AIMING/resetGame
-    GAME_OVER
-};
-
-class GameManager {
+// Déroulement de la partie : GameStateMachine (table des transitions) ; GameManager
+// fournit les conditions et les actions d'entrée/sortie (caméra, visée, audio, score)
+class GameManager : private GameFlowHandler {
     private:
         // Constructeur/Destructeur privés (Singleton)
         GameManager();
@@ -48,7 +46,8 @@ class GameManager {
         static GameManager* instance;
 
         // --- Membres --- 
-        GameState gameState;
+        // Événements postés par les entrées et la détection, traités une fois par frame
+        GameStateMachine stateMachine;
         Ogre::SceneManager* sceneMgr;
         Ogre::Camera* camera;
         BowlingBall* ball; // Pointeur brut, durée de vie gérée par Application
@@ -60,21 +59,46 @@ class GameManager {
         std::unique_ptr<CameraFollower> cameraFollower;
         // ScoreManager est aussi un Singleton, pas besoin de le stocker ici
 
-        // Variables de suivi du jeu
-        int currentFrame;
-        int currentRollInFrame;
-        int pinsKnockedFirstRoll;
-        const int MAX_FRAMES = 10; // Déplacé ici depuis GameManager.cpp
-        int tmp=0;
+        // Suivi des frames et des lancers (logique partagée avec la simulation sans rendu)
+        FrameLogic frameLogic;
+        // Dernier lancer compté (condition GAME_FINISHED)
+        RollResult lastRoll;
 
-        // --- Méthodes privées pour la logique des états --- 
-        void handleAimingState(float deltaTime);
-        void handlePowerState(float deltaTime);
-        void handleRollingState(float deltaTime);
-        void handleScoringState(float deltaTime);
+        // Enregistrement de la partie en cours (écrit à la fin de la partie, voir REPLAY_FILE)
+        GameReplay replay;
+        // Entrées du lancer en cours, ajoutées à replay une fois le lancer compté
+        Ogre::Vector3 launchDirection;
+        float launchPower;
+        float launchSpin;
 
-        // Utilitaire pour convertir l'état en chaîne (pour les logs)
-        std::string gameStateToString(GameState state);
+        // Parties terminées, ajoutées au journal du dossier HISTORY_DIRECTORY
+        GameHistory history;
+
+        // État physique juste avant l'impact du lancer en cours (touche T : rejouer l'impact)
+        PhysicsSnapshot retrySnapshot;
+
+        // --- Conditions et actions de la machine d'états ---
+        bool checkGuard(GameGuard guard) override;
+        void onExit(GameState state) override;
+        void onTransition(GameState from, GameEvent event, GameState to) override;
+        void onEnter(GameState state) override;
+
+        // ROLLING : instantané de reprise, puis ROLL_SETTLED une fois tout au repos
+        void handleRollingState(float deltaTime);
+        // Entrée dans SCORING : compte le lancer (frames, score, relevage) puis poste ROLL_SCORED
+        void scoreRoll();
+        // Action de LAUNCH : lance la boule avec la visée, la puissance et le spin choisis
+        void launchBall();
+        // Action de RESET : frames, score, boule, quilles et systèmes remis à zéro
+        void resetSystems();
+        // Consomme les chocs publiés par PhysicsManager (sons de collision)
+        void handleImpacts();
+        // Capture retrySnapshot quand la boule arrive sur les quilles
+        void captureRetrySnapshot();
+        // Remet la boule et les quilles juste avant l'impact
+        void retryFromSnapshot();
+        // Ajoute la partie terminée (replay et ScoreManager) à l'historique
+        void recordHistory();
 
     public:
         // Méthode statique pour obtenir l'instance (Singleton)
@@ -86,18 +110,12 @@ class GameManager {
         // Mise à jour principale
         void update(float deltaTime);
 
-        // Réinitialisation complète du jeu
+        // Réinitialisation complète du jeu (événement RESET traité immédiatement)
         void resetGame();
 
-        // Lancement de la boule (appelé depuis handleKeyRelease)
-        void launchBall();
-
         // Obtient l'état actuel du jeu
         GameState getGameState() const;
 
-        // Change l'état du jeu
-        void changeState(GameState newState);
-
         // --- Gestionnaires d'événements d'entrée --- 
         bool handleMouseMove(const OgreBites::MouseMotionEvent& evt);
         bool handleMousePress(const OgreBites::MouseButtonEvent& evt);
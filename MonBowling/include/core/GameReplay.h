@@ -0,0 +1,142 @@
+#ifndef GAME_REPLAY_H
+#define GAME_REPLAY_H
+
+#include <Ogre.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../objects/BowlingLane.h"
+
+class PhysicsManager;
+class BowlingBall;
+
+// Enregistrement d'une partie : la configuration physique (dont le motif d'huilage), les entrées de chaque lancer
+// (ce que GameManager::launchBall lit dans AimingSystem) et leur résultat (pas physique
+// du repos, quilles abattues, position et orientation des dix quilles au repos), puis le
+// score final.
+//
+// Le jeu enregistre en plus tout ce qui agit sur le monde physique depuis sa création :
+// le monde lui-même (sol, maillage de la piste dans BvhCache, formes des quilles et de la
+// boule) et le journal de la session (pas physiques de chaque frame, lancers, instantané de
+// reprise, comptes, relevages). BowlingReplay recrée ce monde sans rendu et rejoue le
+// journal dans le même ordre : les lancers de la dernière partie sont comparés au bit près.
+//
+// Fichier texte ligne par ligne ; les flottants sont écrits en hexadécimal (%a) pour être
+// relus au bit près. Rejoué sans rendu par BowlingReplay (tools/ReplayGames.cpp).
+class GameReplay {
+    public:
+        // Origine de l'enregistrement : la simulation sans rendu se rejoue lancer par lancer,
+        // le jeu par son journal de session (events)
+        enum class Source {
+            GAME,
+            SIMULATION
+        };
+
+        // Journal du jeu, dans l'ordre où GameManager agit sur le monde
+        enum class EventType {
+            FRAMES,         // count frames de steps pas physiques (puis boule et détecteur mis à jour)
+            LAUNCH,         // Lancer : direction, power, spin ; la détection démarre
+            CAPTURE,        // Instantané de reprise pris
+            RETRY,          // Instantané restauré, lancer repris
+            SCORE,          // Lancer compté
+            RESET_PINS,     // Quilles relevées
+            RESET_BALL,     // Boule au départ, instantané oublié, détecteur remis à zéro
+            NEW_GAME        // Frames et score remis à zéro
+        };
+
+        struct Event {
+            EventType type = EventType::FRAMES;
+            int count = 0;
+            int steps = 0;
+            Ogre::Vector3 direction = Ogre::Vector3::ZERO;
+            float power = 0.0f;
+            float spin = 0.0f;
+        };
+
+        // Quilles : position (x, y, z) puis orientation (x, y, z, w)
+        static const int FLOATS_PER_PIN = 7;
+
+        struct Roll {
+            int frame = 0;
+            int rollInFrame = 0;
+            Ogre::Vector3 direction = Ogre::Vector3::ZERO;
+            float power = 0.0f;
+            float spin = 0.0f;
+            int settleStep = 0;             // Pas physiques du lancement au repos (ou à la durée max)
+            int pinsThisRoll = 0;
+            int knockedDownMask = 0;
+            std::vector<float> pinStates;
+        };
+
+        // Écart entre deux enregistrements (voir compare)
+        struct Comparison {
+            bool configurationMatches = true;
+            int firstMismatchRoll = -1;     // Premier lancer différent (-1 : aucun)
+            bool scoreMismatch = false;
+            int pinStateMismatches = 0;     // Lancers dont les quilles diffèrent d'au moins un bit
+            float maxPinDeviation = 0.0f;   // Plus grand écart de position d'une quille (m)
+
+            bool identical() const {
+                return configurationMatches && firstMismatchRoll < 0 && !scoreMismatch && pinStateMismatches == 0;
+            }
+        };
+
+        static const int FORMAT_VERSION = 4;
+
+        Source source;
+        float fixedTimeStep;            // Durée du pas physique (1 / fréquence)
+        LaneColliderType laneCollider;
+        bool ccdEnabled;
+        bool multithreaded;
+        // Motif d'huilage de la piste : table complète (ROW_COUNT x BOARD_COUNT, rangée par
+        // rangée), vide sans motif. Son placement découle du type de piste.
+        std::string oilPatternName;
+        std::vector<float> oilFriction;
+        // Monde tel que créé : sol, maillage de la piste (empreinte 0 : pas de maillage),
+        // formes des quilles et de la boule
+        GroundDescription ground;
+        std::string laneMeshName;
+        uint64_t laneMeshHash;
+        ShapeDescription pinShape;
+        ShapeDescription ballShape;
+        std::vector<Event> events;      // Vide pour la simulation sans rendu
+        std::vector<Roll> rolls;
+        int finalScore;                 // -1 tant que la partie n'est pas terminée
+        // Raison pour laquelle le monde ne peut pas être recréé sans rendu (non enregistrée) ;
+        // vide : l'enregistrement est rejouable
+        std::string worldIssue;
+
+        GameReplay();
+
+        // Nouvel enregistrement avec la configuration actuelle du monde, de la piste et de la
+        // boule. Pour le jeu, à appeler avant le premier pas physique : le journal part de là.
+        void begin(Source source, const PhysicsManager& physics, const BowlingLane& lane, const BowlingBall& ball);
+
+        // Journal du jeu : frames consécutives du même nombre de pas regroupées
+        void addFrame(int steps);
+        void addLaunch(const Ogre::Vector3& direction, float power, float spin);
+        void addEvent(EventType type);
+        // Nouvelle partie dans la même session : le journal continue, les lancers repartent de zéro
+        void newGame();
+
+        // Avant lane.create et ball.create (sans rendu) : même type de piste, même sol,
+        // même maillage, mêmes formes et même CCD que le monde enregistré. false si une forme
+        // ne peut pas être recréée.
+        bool applyWorld(BowlingLane& lane, BowlingBall& ball, PhysicsManager& physics) const;
+
+        // À appeler une fois le lancer compté, avant le relevage des quilles
+        void addRoll(int frame, int rollInFrame, const Ogre::Vector3& direction, float power, float spin,
+                     int settleStep, int pinsThisRoll, const BowlingLane& lane);
+        void setFinalScore(int score) { finalScore = score; }
+
+        bool save(const std::string& path) const;
+        bool load(const std::string& path);
+
+        // Compare les résultats de other à cet enregistrement (les entrées sont supposées identiques)
+        Comparison compare(const GameReplay& other) const;
+
+        static const char* getSourceName(Source source);
+};
+
+#endif // GAME_REPLAY_H
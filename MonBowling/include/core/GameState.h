@@ -0,0 +1,36 @@
+#ifndef GAME_STATE_H
+#define GAME_STATE_H
+
+// États, événements et conditions du déroulement d'une partie (GameStateMachine).
+// Sans Ogre : partagés par le jeu (GameManager) et les pistes sans rendu (LaneSession).
+
+enum class GameState {
+    AIMING,         // Visée ; boule au départ
+    POWER,          // Choix de la puissance et du spin
+    ROLLING,        // Boule lancée, jusqu'au repos de la boule et des quilles
+    SCORING,        // Lancer compté (frames, score, relevage)
+    GAME_OVER
+};
+static const int GAME_STATE_COUNT = 5;
+
+enum class GameEvent {
+    CHARGE,         // Visée validée : phase de puissance
+    LAUNCH,         // Boule lancée avec la puissance et le spin choisis
+    ROLL_SETTLED,   // Boule et quilles au repos
+    ROLL_SCORED,    // Lancer compté, posté par l'entrée dans SCORING
+    RETRY,          // Retour juste avant l'impact (sans quitter ROLLING)
+    RESET           // Nouvelle partie, depuis n'importe quel état
+};
+static const int GAME_EVENT_COUNT = 6;
+
+// Condition d'une transition, évaluée par GameFlowHandler::checkGuard
+enum class GameGuard {
+    NONE,           // Toujours vraie
+    GAME_FINISHED,  // Le dernier lancer compté termine la partie
+    CAN_LAUNCH      // Boule et système de visée prêts
+};
+
+const char* toString(GameState state);
+const char* toString(GameEvent event);
+
+#endif // GAME_STATE_H
@@ -0,0 +1,88 @@
+#ifndef GAME_STATE_MACHINE_H
+#define GAME_STATE_MACHINE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "GameState.h"
+
+// Ligne de la table des transitions : dans l'état from, l'événement event mène à to si la
+// condition guard est vraie. Plusieurs lignes pour le même couple (from, event) sont
+// essayées dans l'ordre de la table ; la première dont la condition est vraie est prise.
+struct GameTransition {
+    GameState from;
+    GameEvent event;
+    GameGuard guard;
+    GameState to;
+    bool internal;      // Action seule : ni sortie ni entrée, l'état ne change pas
+};
+
+// Conditions et actions fournies par le propriétaire de la machine : le jeu (caméra,
+// overlays, audio) ou une piste sans rendu (LaneSession, physique et score seulement)
+class GameFlowHandler {
+    public:
+        virtual ~GameFlowHandler() = default;
+        virtual bool checkGuard(GameGuard guard) = 0;
+        // Ordre d'une transition externe : onExit(from), onTransition, onEnter(to)
+        virtual void onExit(GameState) {}
+        virtual void onTransition(GameState, GameEvent, GameState) {}
+        virtual void onEnter(GameState) {}
+};
+
+// Déroulement d'une partie piloté par une table. Les événements sont postés dans une file
+// (entrées, détection de fin de lancer, actions elles-mêmes) et traités par dispatch, une
+// fois par frame : chaque événement coûte une lecture dans la table indexée par
+// (état, événement), puis les conditions des seules lignes candidates.
+class GameStateMachine {
+    public:
+        static const size_t QUEUE_CAPACITY = 16;
+
+    private:
+        // Lignes candidates de chaque couple (état, événement) dans mTransitions
+        struct Slot {
+            uint8_t first;
+            uint8_t count;
+        };
+
+        std::vector<GameTransition> mTransitions;       // Triées par (from, event), ordre conservé
+        std::array<Slot, GAME_STATE_COUNT * GAME_EVENT_COUNT> mSlots;
+        GameState mState;
+        GameFlowHandler* mHandler;
+
+        // File circulaire : pas d'allocation pendant la partie
+        std::array<GameEvent, QUEUE_CAPACITY> mQueue;
+        size_t mQueueHead;
+        size_t mQueueCount;
+        unsigned long mDroppedEvents;
+        bool mDispatching;
+
+        bool process(GameEvent event);
+        void take(const GameTransition& transition);
+
+    public:
+        // Table du jeu de bowling (voir GameStateMachine.cpp)
+        explicit GameStateMachine(GameState initial = GameState::AIMING);
+        GameStateMachine(const GameTransition* table, size_t count, GameState initial);
+
+        void setHandler(GameFlowHandler* handler) { mHandler = handler; }
+
+        // Ajoute l'événement à la file ; false si elle est pleine (événement perdu)
+        bool post(GameEvent event);
+        // Traite la file dans l'ordre, y compris les événements postés par les actions.
+        // Un événement sans transition (ou dont aucune condition n'est vraie) est ignoré.
+        // Retourne le nombre de transitions prises.
+        int dispatch();
+        // post puis dispatch (seulement post si appelé depuis une action)
+        int fire(GameEvent event);
+
+        // Change d'état sans action et vide la file (initialisation)
+        void setState(GameState state);
+        GameState getState() const { return mState; }
+        bool isIn(GameState state) const { return mState == state; }
+        size_t getPendingEventCount() const { return mQueueCount; }
+        unsigned long getDroppedEventCount() const { return mDroppedEvents; }
+};
+
+#endif // GAME_STATE_MACHINE_H
@@ -0,0 +1,65 @@
+#ifndef LANE_HOST_H
+#define LANE_HOST_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "LaneSession.h"
+
+// Plusieurs pistes dans un même processus : LaneHost possède N sessions (LaneSession) et un
+// pool de threads persistant. Chaque appel répartit les sessions entre les threads (une
+// session à la fois par thread, prise dans un compteur commun) puis attend qu'elles aient
+// toutes fini ; le thread appelant travaille aussi. Les sessions ne partagent rien : aucun
+// verrou pendant les pas physiques.
+class LaneHost {
+    public:
+        typedef std::function<void(LaneSession&)> Job;
+
+    private:
+        std::vector<std::unique_ptr<LaneSession>> mSessions;
+        std::vector<std::thread> mWorkers;
+
+        // Travail en cours, publié sous mMutex avec un nouveau numéro de génération
+        std::mutex mMutex;
+        std::condition_variable mWorkReady;
+        std::condition_variable mWorkDone;
+        const Job* mJob;
+        unsigned long mJobGeneration;
+        size_t mBusyWorkers;
+        bool mStopping;
+        std::atomic<size_t> mNextSession;
+
+        void workerLoop();
+        // Prend des sessions jusqu'à ce qu'il n'en reste plus
+        void runJob(const Job& job);
+
+    public:
+        // Pistes numérotées de 1 à laneCount. threadCount : threads au total, appelant compris
+        // (0 : autant que de cœurs, sans dépasser le nombre de pistes)
+        explicit LaneHost(int laneCount, unsigned int threadCount = 0);
+        ~LaneHost();
+
+        LaneHost(const LaneHost&) = delete;
+        LaneHost& operator=(const LaneHost&) = delete;
+
+        // Crée les mondes physiques et les pistes, en parallèle
+        void initialize();
+
+        // job(session) pour chaque session, en parallèle ; retourne quand toutes ont fini.
+        // job ne doit toucher qu'à sa session (ou à des données propres à cette piste).
+        void forEachSession(const Job& job);
+        // Avance chaque session d'au plus steps pas fixes (LaneSession::advance) ;
+        // retourne le nombre total de pas simulés
+        long update(int steps);
+
+        size_t getSessionCount() const { return mSessions.size(); }
+        LaneSession& getSession(size_t index) { return *mSessions[index]; }
+        unsigned int getThreadCount() const { return static_cast<unsigned int>(mWorkers.size()) + 1; }
+};
+
+#endif // LANE_HOST_H
@@ -0,0 +1,70 @@
+#ifndef LANE_SESSION_H
+#define LANE_SESSION_H
+
+#include <Ogre.h>
+
+#include "BowlingSimulation.h"
+#include "GameStateMachine.h"
+#include "../managers/PhysicsManager.h"
+#include "../states/ScoreManager.h"
+
+// Une piste complète sans rendu : son propre monde physique, sa boule, ses quilles, son
+// détecteur de fin de lancer, son score et l'état de sa partie. Aucune donnée partagée
+// avec les autres sessions ni avec les singletons du jeu : plusieurs sessions avancent en
+// même temps sur des threads différents (LaneHost), une session sur un seul thread à la fois.
+// La partie suit la même table de transitions que le jeu (GameStateMachine), sans caméra,
+// visée ni overlay : AIMING attend un lancer, POWER n'est que traversé.
+class LaneSession : private GameFlowHandler {
+    private:
+        // Déclarés dans l'ordre de construction : la simulation utilise le monde et le score
+        PhysicsManager mPhysics;
+        ScoreManager mScores;
+        BowlingSimulation mSimulation;
+        GameStateMachine mStateMachine;
+        int mLaneNumber;
+        RollResult mLastRoll;
+        // Lancer demandé, joué par l'action de LAUNCH
+        Ogre::Vector3 mLaunchDirection;
+        float mLaunchPower;
+        float mLaunchSpin;
+        unsigned long mRolls;       // Lancers comptés depuis la création
+        unsigned long mGames;       // Parties terminées depuis la création
+
+        bool checkGuard(GameGuard guard) override;
+        void onTransition(GameState from, GameEvent event, GameState to) override;
+        void onEnter(GameState state) override;
+
+    public:
+        explicit LaneSession(int laneNumber);
+        ~LaneSession();
+
+        LaneSession(const LaneSession&) = delete;
+        LaneSession& operator=(const LaneSession&) = delete;
+
+        // Crée le monde physique (sans rendu), la piste et la boule, puis une nouvelle partie
+        void initialize();
+        // Nouvelle partie : score, frames, boule et quilles
+        void resetGame();
+
+        // Lance la boule si la session est en AIMING ; false sinon
+        bool launch(const Ogre::Vector3& direction, float power, float spin);
+        // Avance d'au plus steps pas fixes. Un lancer qui s'achève est compté tout de suite
+        // (AIMING ou GAME_OVER) ; les pas restants ne sont pas simulés, rien ne bouge.
+        // Retourne le nombre de pas simulés.
+        int advance(int steps);
+
+        GameState getState() const { return mStateMachine.getState(); }
+        int getLaneNumber() const { return mLaneNumber; }
+        // Résultat du dernier lancer compté
+        const RollResult& getLastRoll() const { return mLastRoll; }
+        unsigned long getRollCount() const { return mRolls; }
+        unsigned long getGameCount() const { return mGames; }
+        int getScore() const { return mSimulation.getScore(); }
+
+        PhysicsManager& getPhysics() { return mPhysics; }
+        ScoreManager& getScores() { return mScores; }
+        const ScoreManager& getScores() const { return mScores; }
+        BowlingSimulation& getSimulation() { return mSimulation; }
+};
+
+#endif // LANE_SESSION_H
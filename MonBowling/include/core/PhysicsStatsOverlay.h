@@ -0,0 +1,37 @@
+#ifndef PHYSICS_STATS_OVERLAY_H
+#define PHYSICS_STATS_OVERLAY_H
+
+#include <OgreOverlay.h>
+#include <OgreOverlayContainer.h>
+#include <OgreTextAreaOverlayElement.h>
+
+class PhysicsManager;
+
+// Panneau de mesures physiques (F3) : temps de la dernière frame par phase, pic sur
+// la dernière seconde et compteurs du monde. Afficher le panneau active le profileur.
+class PhysicsStatsOverlay {
+    private:
+        PhysicsManager* physicsManager;
+        Ogre::Overlay* overlay;
+        Ogre::OverlayContainer* panel;
+        Ogre::TextAreaOverlayElement* text;
+
+        // Pic du temps physique par frame sur la fenêtre glissante
+        float peakWindow;
+        float peakElapsed;
+        double peakTotalMs;
+        double displayedPeakMs;
+
+    public:
+        explicit PhysicsStatsOverlay(PhysicsManager* physics = nullptr);
+        ~PhysicsStatsOverlay();
+
+        void initialize();
+        void update(float deltaTime);
+
+        void setVisible(bool visible);
+        bool isVisible() const;
+        void toggle() { setVisible(!isVisible()); }
+};
+
+#endif // PHYSICS_STATS_OVERLAY_H
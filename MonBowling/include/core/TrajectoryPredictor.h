@@ -0,0 +1,91 @@
+#ifndef TRAJECTORY_PREDICTOR_H
+#define TRAJECTORY_PREDICTOR_H
+
+#include <Ogre.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../managers/LaneFrictionField.h"
+#include "../objects/BowlingBall.h"
+#include "../objects/LaneCollider.h"
+
+class BowlingLane;
+class PhysicsManager;
+class btBvhTriangleMeshShape;
+
+// Trajectoire prévue de la boule pendant la visée (lancer « fantôme »).
+// Un thread de travail possède son propre monde Bullet, réduit à la piste et à une boule
+// (pas de quilles), et y simule le lancer demandé avec le même modèle que le jeu
+// (BowlingBall::launch, effet au pré-tick, motif d'huilage). La piste fantôme a le même
+// collider que celle du jeu : la forme maillée (BVH de BvhCache, en lecture seule pendant
+// les requêtes de collision) est partagée, la piste analytique reconstruite. La boule
+// fantôme reprend le rayon de collision, la masse, l'inertie, les frictions et le CCD de
+// celle du jeu. La trajectoire est publiée
+// sous forme de polyligne que le thread de rendu récupère sans jamais attendre (poll).
+// Une nouvelle demande annule la simulation en cours, qui repart avec les nouvelles valeurs.
+class TrajectoryPredictor {
+    private:
+        struct Request {
+            Ogre::Vector3 direction;
+            float power;
+            float spin;
+        };
+
+        // Monde fantôme, copié au démarrage puis lu par le seul thread de travail
+        Ogre::Vector3 mBallStart;
+        BallBodyProperties mBallProperties;
+        BallCcdProfile mBallCcdProfile;
+        LaneDefinition mLaneDefinition;
+        btBvhTriangleMeshShape* mLaneMeshShape;    // Forme du jeu, non possédée ; nullptr : piste analytique
+        float mLaneFriction;
+        float mLaneRollingFriction;
+        LaneFrictionField mOilPattern;
+        bool mOilPatternEnabled;
+        float mTickRate;
+
+        std::thread mWorker;
+        std::atomic<bool> mStopping;
+        // Incrémentée à chaque demande ou annulation : le thread abandonne le lancer en cours
+        std::atomic<unsigned int> mGeneration;
+
+        // Demande en attente (verrou tenu le temps d'une copie)
+        std::mutex mRequestMutex;
+        std::condition_variable mRequestReady;
+        Request mRequest;
+        bool mHasRequest;
+
+        // Dernière trajectoire terminée et génération de la demande qui l'a produite
+        std::mutex mResultMutex;
+        std::vector<Ogre::Vector3> mResult;
+        unsigned int mResultGeneration;
+        bool mHasResult;
+
+        void run();
+        // false si le lancer a été annulé avant la fin
+        bool simulate(PhysicsManager& physics, BowlingBall& ball, const Request& request,
+                      unsigned int generation, std::vector<Ogre::Vector3>& path);
+
+    public:
+        TrajectoryPredictor();
+        ~TrajectoryPredictor();
+
+        // Démarre le thread avec le corps de ball, le collider, la friction et le motif
+        // d'huilage de lane (déjà créées ; lane doit survivre au thread, sa forme maillée est
+        // partagée). tickRate : celui du jeu
+        void start(const Ogre::Vector3& ballStart, const BowlingBall& ball, const BowlingLane& lane, float tickRate);
+        void stop();
+        bool isRunning() const { return mWorker.joinable(); }
+
+        // Mêmes valeurs que BowlingBall::launch ; remplace la demande précédente
+        void request(const Ogre::Vector3& direction, float power, float spin);
+        // Abandonne la demande en cours (sa trajectoire ne sera pas publiée)
+        void cancel();
+        // Trajectoire de la dernière demande si elle vient d'être terminée (échangée avec path).
+        // Ne bloque jamais : false si rien de nouveau ou si le thread est en train de publier.
+        bool poll(std::vector<Ogre::Vector3>& path);
+};
+
+#endif // TRAJECTORY_PREDICTOR_H
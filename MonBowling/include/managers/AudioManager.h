@@ -28,8 +28,8 @@ public:
     // Chargement d'un son
     bool loadSound(const std::string& fileName, const std::string& soundName, bool loop = false);
 
-    // Lecture d'un son
-    void playSound(const std::string& soundName);
+    // Lecture d'un son (volume de 0 à 1)
+    void playSound(const std::string& soundName, float volume = 1.0f);
 
     // Arrêt d'un son (utile pour les sons en boucle)
     void stopSound(const std::string& soundName);
@@ -0,0 +1,96 @@
+#pragma once
+#include <Ogre.h>
+#include <OgreBullet.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Formes triangulaires statiques (piste) dont la BVH quantifiée est conservée sur disque.
+//
+// Au premier chargement d'un mesh, la BVH est construite puis écrite dans
+// <dossier>/<mesh>_<empreinte>.bvh ; aux lancements suivants elle est relue telle quelle
+// (btOptimizedBvh::deSerializeInPlace), sans reconstruction. L'empreinte couvre les
+// sommets, les indices et l'échelle : un mesh modifié produit un autre fichier, et
+// l'ancien est supprimé. Le format dépend de la plateforme (version de Bullet, taille
+// des pointeurs et de btScalar, boutisme), vérifiés à la lecture.
+//
+// Le fichier contient aussi les triangles mis à l'échelle : loadTriangleMeshShape
+// reconstruit la même forme sans Ogre ni mesh (rejeu sans rendu d'une partie du jeu,
+// qui enregistre le nom du mesh et l'empreinte donnés par findShapeKey).
+//
+// Chaque triangle reçoit sa partie de piste (LanePart, voir classifyLaneTriangles), portée
+// par la forme : getUserPointer() = tableau d'un octet par triangle, getUserIndex() = nombre
+// de triangles. PhysicsManager y lit la partie touchée par un contact (index du triangle).
+class BvhCache {
+    private:
+        // Données qui doivent vivre aussi longtemps que la forme
+        struct Entry {
+            Ogre::String meshName;
+            uint64_t hash = 0;
+            bool onDisk = false;        // Fichier écrit ou relu : forme reconstructible sans le mesh
+            std::vector<float> vertices;
+            std::vector<int> indices;
+            std::unique_ptr<btTriangleIndexVertexArray> meshInterface;
+            std::unique_ptr<btBvhTriangleMeshShape> shape;
+            void* bvhBuffer = nullptr;  // BVH relue du disque (aligné sur 16 octets)
+            std::vector<uint8_t> triangleParts;     // LanePart de chaque triangle
+
+            ~Entry();
+        };
+        std::map<std::string, std::unique_ptr<Entry>> mEntries;
+
+        std::string mDirectory;
+        bool mDiskCacheEnabled;
+        bool mLastLoadedFromDisk;
+        double mLastLoadMs;
+
+        std::string makeFilePath(const Ogre::String& meshName, uint64_t hash) const;
+        // Triangles de entry déjà remplis : ils doivent être ceux du fichier ; sinon lus du fichier
+        bool loadFromDisk(const std::string& path, Entry& entry);
+        bool saveToDisk(const std::string& path, const Ogre::Vector3& scale, const Entry& entry) const;
+        static void buildMeshInterface(Entry& entry);
+        // Parties de piste portées par la forme, puis entrée conservée sous path
+        btBvhTriangleMeshShape* storeEntry(const std::string& path, std::unique_ptr<Entry> entry);
+
+    public:
+        explicit BvhCache(const std::string& directory = "cache/bvh");
+        ~BvhCache();
+
+        BvhCache(const BvhCache&) = delete;
+        BvhCache& operator=(const BvhCache&) = delete;
+
+        // Forme triangulaire du mesh (échelle appliquée aux sommets), partagée et possédée par le cache
+        btBvhTriangleMeshShape* getTriangleMeshShape(const Ogre::MeshPtr& mesh, const Ogre::Vector3& scale);
+        // Même forme relue du fichier seul, sans le mesh (même si le cache disque est désactivé) ;
+        // nullptr si le fichier manque ou ne correspond pas à l'empreinte
+        btBvhTriangleMeshShape* loadTriangleMeshShape(const Ogre::String& meshName, uint64_t hash);
+        // Nom du mesh et empreinte d'une forme de ce cache ; false si elle n'a pas de fichier
+        bool findShapeKey(const btBvhTriangleMeshShape* shape, Ogre::String& meshName, uint64_t& hash) const;
+
+        void setDirectory(const std::string& directory) { mDirectory = directory; }
+        const std::string& getDirectory() const { return mDirectory; }
+        // false : BVH toujours reconstruite (comparaison, dossier en lecture seule)
+        void setDiskCacheEnabled(bool enabled) { mDiskCacheEnabled = enabled; }
+
+        // Étendue en x du plateau (triangles DECK) de la forme à la profondeur z ; false si la
+        // forme ne vient pas de ce cache ou si aucun triangle du plateau ne passe par z
+        bool findDeckExtent(const btBvhTriangleMeshShape* shape, float z, float& minX, float& maxX) const;
+
+        // Dernier appel de getTriangleMeshShape qui a construit ou relu une forme
+        bool wasLastLoadedFromDisk() const { return mLastLoadedFromDisk; }
+        double getLastLoadTimeMs() const { return mLastLoadMs; }
+
+        // Triangles du mesh (listes de triangles uniquement), dans l'ordre des sous-meshes
+        static void collectTriangles(const Ogre::MeshPtr& mesh, const Ogre::Vector3& scale,
+                                     std::vector<float>& vertices, std::vector<int>& indices);
+        // Partie de piste de chaque triangle. Le plateau est la surface horizontale de plus
+        // grande aire : ses triangles (et ceux de l'élan, à la même hauteur) sont DECK, ce qui
+        // est plus bas est GUTTER (PIT au-delà des extrémités du plateau), le reste WALL.
+        static void classifyLaneTriangles(const std::vector<float>& vertices, const std::vector<int>& indices,
+                                          std::vector<uint8_t>& parts);
+        // Empreinte FNV-1a 64 bits des triangles et de l'échelle
+        static uint64_t hashTriangles(const std::vector<float>& vertices, const std::vector<int>& indices,
+                                      const Ogre::Vector3& scale);
+};
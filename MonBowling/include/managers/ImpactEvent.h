@@ -0,0 +1,42 @@
+#pragma once
+#include <Ogre.h>
+
+class btRigidBody;
+
+// Rôle d'un corps dans la détection des chocs (btCollisionObject::setUserIndex).
+// Les corps sans rôle (sol, boîtes de test) ne produisent aucun événement.
+enum class BodyRole : int {
+    NONE = -1,      // Valeur par défaut de Bullet
+    BALL = 1,
+    PIN = 2,
+    LANE = 3
+};
+
+// Partie d'une piste : setUserIndex sur les formes enfants d'une piste composée, un octet
+// par triangle pour un maillage (voir BvhCache)
+enum class LanePart : int {
+    DECK = 0,
+    GUTTER = 1,
+    WALL = 2,       // Rebords, kickbacks, coussin de la fosse
+    PIT = 3
+};
+
+enum class ImpactType : int {
+    BALL_PIN,
+    PIN_PIN,
+    PIN_LANE,
+    BALL_LANE,
+    BALL_GUTTER,
+    COUNT
+};
+
+// Choc détecté après un pas physique : contact nouveau dont l'impulsion dépasse le seuil
+// de PhysicsManager. bodyA/bodyB suivent l'ordre du nom du type (boule avant quille...).
+struct ImpactEvent {
+    ImpactType type = ImpactType::BALL_PIN;
+    float impulse = 0.0f;           // Impulsion normale appliquée par le solveur (N.s)
+    Ogre::Vector3 point = Ogre::Vector3::ZERO;
+    float time = 0.0f;              // Temps simulé au moment du choc (PhysicsManager::getSimulatedTime)
+    const btRigidBody* bodyA = nullptr;
+    const btRigidBody* bodyB = nullptr;
+};
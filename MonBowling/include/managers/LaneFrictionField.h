@@ -0,0 +1,56 @@
+#pragma once
+#include <string>
+
+// Champ de friction de la piste (motif d'huilage) : friction combinée boule/piste par
+// planche et par distance depuis la ligne de faute, précalculée dans une table fixe.
+// sample() ne fait que deux conversions en indices bornés et une lecture : la table
+// (60 x 39 flottants, moins de 10 Ko) reste dans le cache L1 pendant tout le lancer.
+//
+// Fichier de motif (texte, une commande par ligne, # pour les commentaires) :
+//   name <nom>
+//   dry <friction>                                  toute la piste (à mettre en premier)
+//   band <début m> <fin m> <planche> <planche> <friction>
+// Les bandes sont appliquées dans l'ordre ; les planches sont numérotées de 1 à 39 depuis
+// la gouttière droite du joueur (+X, la boule roulant vers -Z), les distances en mètres.
+class LaneFrictionField {
+    public:
+        static constexpr int BOARD_COUNT = 39;
+        static constexpr int ROW_COUNT = 60;            // Un pied par rangée : 18.29 m
+        static constexpr float ROW_LENGTH = 0.3048f;
+
+    private:
+        float mTable[ROW_COUNT][BOARD_COUNT];
+        std::string mName;
+
+        // Repère de la piste : bord droit du plateau, ligne de faute, largeur d'une planche
+        float mRightEdgeX;
+        float mFoulLineZ;
+        float mInverseBoardWidth;
+
+    public:
+        // Friction uniforme (0.64 : boule 0.8 x piste 0.8, comme sans motif)
+        LaneFrictionField();
+
+        void setUniform(float friction);
+        // Planches firstBoard..lastBoard (1..39) entre deux distances (m), bornes comprises
+        void fillBand(float startDistance, float endDistance, int firstBoard, int lastBoard, float friction);
+        // false si le fichier est illisible ou mal formé (le champ est alors inchangé)
+        bool load(const std::string& path);
+
+        // Position de la piste dans le monde : centre du plateau, largeur, ligne de faute
+        void setLaneGeometry(float centerX, float width, float foulLineZ);
+
+        // Friction au point (x, z) du monde ; hors du plateau, planche ou rangée la plus proche
+        float sample(float x, float z) const {
+            int board = static_cast<int>((mRightEdgeX - x) * mInverseBoardWidth);
+            int row = static_cast<int>((mFoulLineZ - z) * (1.0f / ROW_LENGTH));
+            board = board < 0 ? 0 : (board >= BOARD_COUNT ? BOARD_COUNT - 1 : board);
+            row = row < 0 ? 0 : (row >= ROW_COUNT ? ROW_COUNT - 1 : row);
+            return mTable[row][board];
+        }
+        float getFriction(int row, int board) const { return mTable[row][board]; }
+        void setFriction(int row, int board, float friction) { mTable[row][board] = friction; }
+
+        const std::string& getName() const { return mName; }
+        void setName(const std::string& name) { mName = name; }
+};
@@ -0,0 +1,28 @@
+#pragma once
+#include <OgreBullet.h>
+#include <vector>
+
+// État de mouvement des corps affichés (boule et quilles avec rendu). Bullet n'appelle
+// setWorldTransform que pour un corps qu'il vient d'intégrer : l'état se contente alors de
+// marquer son entrée dans le registre d'interpolation de PhysicsManager. Le nœud Ogre n'est
+// écrit que par PhysicsManager::syncSceneNodes, et seulement pour les corps marqués :
+// une quille endormie ne coûte plus rien d'une frame à l'autre.
+class NodeMotionState : public btMotionState {
+    private:
+        btTransform mTransform;
+        std::vector<char>* mFlags;  // Indicateurs du registre de PhysicsManager (nullptr : non enregistré)
+        int mSlot;                  // Entrée du corps dans ce registre
+
+    public:
+        // Indicateurs d'une entrée du registre
+        static const char FLAG_MOVED = 1;       // Corps intégré depuis le début de la frame physique
+        static const char FLAG_UNSETTLED = 2;   // Nœud pas encore posé sur la transformation courante
+
+        explicit NodeMotionState(const btTransform& startTransform);
+
+        void getWorldTransform(btTransform& worldTransform) const override;
+        void setWorldTransform(const btTransform& worldTransform) override;
+
+        // Appelé par PhysicsManager à l'enregistrement et quand l'entrée change de place
+        void setSlot(std::vector<char>* flags, int slot);
+};
@@ -1,7 +1,22 @@
 #pragma once
 #include <Ogre.h>
 #include <OgreBullet.h>
+#include "BvhCache.h"
+#include "ImpactEvent.h"
+#include "LaneFrictionField.h"
+#include "NodeMotionState.h"
+#include "PhysicsProfiler.h"
+#include "PhysicsSnapshot.h"
+#include "PhysicsTickListener.h"
+#include "ShapeCache.h"
+#include "../utils/SpscQueue.h"
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <vector>
+
+class btITaskScheduler;
+class btConstraintSolverPoolMt;
 
 // Pattern Singleton pour la gestion de la physique
 class PhysicsManager{
@@ -9,9 +24,15 @@ class PhysicsManager{
         // Instance unique (Singleton)
         static PhysicsManager* mInstance;
         
-        // Constructeur privé (Singleton)
-        PhysicsManager();
-        
+        // --- Monde multithread (optionnel) ---
+        // Composants du btDiscreteDynamicsWorldMt : déclarés avant mDynamicsWorld pour
+        // être détruits après lui (le wrapper Ogre détruit le monde Bullet qu'il enveloppe).
+        std::unique_ptr<btCollisionConfiguration> mMtCollisionConfig;
+        std::unique_ptr<btCollisionDispatcher> mMtDispatcher;
+        std::unique_ptr<btBroadphaseInterface> mMtBroadphase;
+        std::unique_ptr<btConstraintSolverPoolMt> mMtSolverPool;
+        std::unique_ptr<btConstraintSolver> mMtSolver;
+
         // Monde physique Bullet
         std::unique_ptr<Ogre::Bullet::DynamicsWorld> mDynamicsWorld;
         
@@ -21,22 +42,244 @@ class PhysicsManager{
         // Debugger visuel
         std::unique_ptr<Ogre::Bullet::DebugDrawer> mDebugDrawer;
         Ogre::SceneNode* mDebugNode;
+
+        // --- Pas de temps fixe ---
+        bool mFixedStepEnabled;
+        float mFixedTimeStep;       // Durée d'un pas physique (1 / fréquence)
+        int mMaxStepsPerFrame;      // Plafond du rattrapage par frame de rendu
+        float mAccumulator;         // Temps de rendu pas encore simulé
+        float mInterpolationAlpha;  // Position entre le pas précédent et le pas courant [0, 1]
+        unsigned long mStepCount;   // Nombre total de pas simulés (fixes, ou sous-pas du mode variable)
+        double mSimulatedTime;      // Temps simulé total en secondes, quel que soit le mode
+        int mLastFrameSteps;        // Nombre de pas effectués à la dernière frame
+
+        // Formes partagées (quilles) : déclaré avant mOwnedBodies pour survivre aux corps
+        ShapeCache mShapeCache;
+        // Formes triangulaires statiques (piste) avec BVH conservée sur disque
+        BvhCache mBvhCache;
+
+        // Corps créés sans passer par Ogre::Bullet::DynamicsWorld::addRigidBody : PhysicsManager
+        // en est propriétaire (shape est vide quand la forme appartient à mShapeCache)
+        struct OwnedBody {
+            std::unique_ptr<btRigidBody> body;
+            std::unique_ptr<btMotionState> motionState;
+            std::unique_ptr<btCollisionShape, ShapeDeleter> shape;
+        };
+        std::vector<OwnedBody> mOwnedBodies;
+
+        btRigidBody* addOwnedBody(float mass, btCollisionShape* shape, bool ownsShape, const btTransform& startTransform,
+                                  Ogre::SceneNode* node);
+
+        // Corps interpolés et leur transformation au pas précédent (entrée de chaque corps
+        // gardée dans son userIndex2)
+        std::vector<btRigidBody*> mInterpolatedBodies;
+        std::vector<btTransform> mPreviousTransforms;
+        // Nœud affiché par chaque corps interpolé (nullptr : pas de rendu), son état de mouvement
+        // et ses indicateurs (NodeMotionState::FLAG_MOVED, FLAG_UNSETTLED)
+        std::vector<Ogre::SceneNode*> mInterpolatedNodes;
+        std::vector<NodeMotionState*> mInterpolatedStates;
+        std::vector<char> mNodeFlags;
+
+        // Tampons de syncSceneNodes, réutilisés d'une frame à l'autre. Une entrée par corps
+        // à recopier, SYNC_STRIDE flottants : position (x, y, z, t) puis rotation (x, y, z, w)
+        static const int SYNC_STRIDE = 8;
+        std::vector<int> mSyncIndices;
+        std::vector<float> mSyncPrevious;
+        std::vector<float> mSyncCurrent;
+        std::vector<float> mSyncResult;
+
+        bool mMultithreadRequested;     // Option demandée avant initialize()
+        bool mMultithreaded;            // Monde réellement créé en multithread
+        int mThreadCount;               // 0 = nombre de threads maximal de l'ordonnanceur
+        int mTaskSchedulerType;         // Valeur de TaskScheduler
+        btITaskScheduler* mCustomScheduler;
+
+        // Construit le btDiscreteDynamicsWorldMt ; false si Bullet n'a pas été compilé
+        // avec BT_THREADSAFE ou si l'ordonnanceur demandé n'est pas disponible.
+        bool createMultithreadedWorld();
+
+        // --- Événements de choc ---
+        static const size_t IMPACT_QUEUE_CAPACITY = 256;
+        SpscQueue<ImpactEvent, IMPACT_QUEUE_CAPACITY> mImpactQueue;
+        bool mImpactEventsEnabled;
+        float mImpactThreshold;                     // Impulsion minimale publiée (N.s)
+        std::atomic<unsigned long> mDroppedImpacts; // File pleine : événements perdus
+
+        // Parcourt les manifolds du dernier pas et publie les chocs dans mImpactQueue
+        void publishImpacts();
+
+        // Temps par phase et compteurs de chaque frame physique (désactivé par défaut)
+        PhysicsProfiler mProfiler;
+
+        // Modèles appelés avant chaque pas interne (callback de pré-tick de Bullet)
+        std::vector<PhysicsTickListener*> mTickListeners;
+        static void preTickCallback(btDynamicsWorld* world, btScalar timeStep);
+
+        // Mémorise la transformation de chaque corps interpolé avant un pas
+        void storePreviousTransforms();
+        // Début d'une frame physique : les états de mouvement remarqueront les corps intégrés
+        void clearMovedFlags();
+        int findInterpolatedBody(const btRigidBody* body) const;
+
+        // Proxies dont les paires sont à nettoyer, triés (tampon réutilisé)
+        std::vector<const btBroadphaseProxy*> mCleanProxies;
+        // Libère algorithmes et manifolds des paires touchant mCleanProxies, en un parcours
+        // des paires du monde quel que soit le nombre de corps (au lieu d'un par corps)
+        void cleanMarkedProxyPairs();
+
+        // --- Restauration des instantanés (tampons réutilisés) ---
+        // Manifolds capturés déjà recopiés dans un manifold du monde, par index de l'instantané
+        std::vector<char> mRestoredManifolds;
+        btManifoldArray mPairManifolds;
+        // Recopie dans manifold les points du premier manifold capturé de la même paire de
+        // corps pas encore restauré ; false si l'instantané n'en contient plus
+        bool restoreManifoldPoints(const PhysicsSnapshot& snapshot, btPersistentManifold* manifold);
         
     public:
+        // Ordonnanceur de tâches du monde multithread. OPENMP, TBB et PPL n'existent que
+        // si Bullet a été compilé avec le support correspondant.
+        enum TaskScheduler {
+            SCHEDULER_DEFAULT,      // Pool de threads interne à Bullet
+            SCHEDULER_SEQUENTIAL,   // Un seul thread (référence pour les mesures)
+            SCHEDULER_OPENMP,
+            SCHEDULER_TBB,
+            SCHEDULER_PPL
+        };
+
+        // Le jeu utilise l'instance unique ; les outils sans rendu peuvent créer
+        // un monde indépendant par thread avec ce constructeur.
+        PhysicsManager();
         ~PhysicsManager();
+
+        PhysicsManager(const PhysicsManager&) = delete;
+        PhysicsManager& operator=(const PhysicsManager&) = delete;
         
         // Méthode d'accès à l'instance unique (Singleton)
         static PhysicsManager* getInstance();
         
-        // Initialisation
+        // Initialisation (sceneMgr peut être nullptr : simulation sans rendu, sans debugger visuel)
         void initialize(Ogre::SceneManager* sceneMgr);
         
-        // Mise à jour de la physique
+        // --- Monde multithread (à configurer avant initialize) ---
+        // btDiscreteDynamicsWorldMt : détection de collision et solveur de contraintes
+        // répartis par îlots sur threadCount threads (0 = tous ceux de l'ordonnanceur).
+        // L'ordonnanceur de Bullet est global au processus : ne pas combiner avec
+        // plusieurs mondes utilisés depuis des threads différents.
+        void setMultithreaded(bool enabled, int threadCount = 0);
+        void setTaskScheduler(TaskScheduler type);
+        // Ordonnanceur fourni par l'application (non possédé, doit survivre au monde)
+        void setCustomTaskScheduler(btITaskScheduler* scheduler);
+        bool isMultithreaded() const { return mMultithreaded; }
+        int getThreadCount() const;
+
+        // Mise à jour de la physique (temps de rendu écoulé)
         void update(float deltaTime);
+
+        // Avance directement de plusieurs pas fixes, sans accumulateur (simulation sans rendu)
+        void step(int steps = 1);
+
+        // Ajoute un corps rigide construit à partir d'une forme Bullet, sans entité Ogre.
+        // PhysicsManager prend possession de la forme et du corps créé. node != nullptr et mass != 0 :
+        // le corps reçoit un NodeMotionState et est interpolé, syncSceneNodes place le nœud quand
+        // il bouge. Un corps statique n'est pas interpolé : son nœud reste où l'appelant l'a posé.
+        btRigidBody* addPrimitiveRigidBody(float mass, btCollisionShape* shape, const btTransform& startTransform,
+                                           Ogre::SceneNode* node = nullptr);
+        // Corps utilisant une forme du cache (non possédée), node comme ci-dessus
+        btRigidBody* addSharedShapeRigidBody(float mass, btCollisionShape* shape, const btTransform& startTransform,
+                                             Ogre::SceneNode* node = nullptr);
+        // Retire un corps du monde (et le libère s'il a été créé par addPrimitiveRigidBody)
+        void removeRigidBody(btRigidBody* body);
+        // Replace des corps à l'arrêt en une passe : transformation (corps, interpolation Bullet,
+        // motion state), vitesses et forces à zéro, corps réveillés, AABB mises à jour. Les
+        // algorithmes et manifolds de leurs paires sont libérés en un seul parcours des paires :
+        // aucun contact de l'ancienne position ne survit. Les paires elles-mêmes restent dans
+        // le broadphase, qui les retire ou les garde au pas suivant selon les nouvelles AABB.
+        void teleportBodies(btRigidBody* const* bodies, const btTransform* transforms, size_t count);
         
         // Activation/désactivation du débogage visuel
         void toggleDebugDrawing();
+
+        // --- Configuration du pas fixe ---
+        // Fréquence de simulation en Hz (ex: 120 -> pas de 1/120 s)
+        void setTickRate(float ticksPerSecond);
+        float getTickRate() const { return 1.0f / mFixedTimeStep; }
+        float getFixedTimeStep() const { return mFixedTimeStep; }
+        // Nombre maximum de pas simulés pour une frame (le retard au-delà est abandonné)
+        void setMaxStepsPerFrame(int maxSteps);
+        int getMaxStepsPerFrame() const { return mMaxStepsPerFrame; }
+        // false = ancien comportement (pas variable égal au temps de rendu)
+        void setFixedStepEnabled(bool enabled);
+        bool isFixedStepEnabled() const { return mFixedStepEnabled; }
+
+        float getInterpolationAlpha() const { return mInterpolationAlpha; }
+        unsigned long getStepCount() const { return mStepCount; }
+        double getSimulatedTime() const { return mSimulatedTime; }
+        int getLastFrameSteps() const { return mLastFrameSteps; }
+
+        // --- Interpolation de rendu ---
+        // Enregistre un corps dynamique dont la transformation du pas précédent doit être
+        // conservée (fait d'office pour un corps dynamique créé avec un nœud ; statique : ignoré)
+        void registerInterpolatedBody(btRigidBody* body);
+        void unregisterInterpolatedBody(btRigidBody* body);
+        // À appeler après une téléportation (reset) pour ne pas interpoler depuis l'ancienne position
+        void resetInterpolation(btRigidBody* body);
+        // Transformation à afficher : mélange du pas précédent et du pas courant selon alpha
+        btTransform getInterpolatedTransform(const btRigidBody* body) const;
+        // Place les nœuds des corps affichés (appelé à la fin de update). Seuls les corps que
+        // Bullet a intégrés (marqués par leur NodeMotionState) sont recopiés dans des tableaux
+        // contigus, interpolés en une boucle puis écrits dans les nœuds ; un corps qui vient de
+        // s'arrêter est posé une dernière fois sur sa transformation courante.
+        void syncSceneNodes();
         
+        // --- Événements de choc ---
+        // Après chaque pas, un événement par paire de corps ayant un rôle (setBodyRole) pour
+        // son contact nouveau le plus fort au-dessus du seuil. Le producteur est le thread qui
+        // fait avancer ce monde, le consommateur unique appelle popImpact.
+        void setImpactEventsEnabled(bool enabled);
+        bool areImpactEventsEnabled() const { return mImpactEventsEnabled; }
+        void setImpactThreshold(float impulse) { mImpactThreshold = std::max(0.0f, impulse); }
+        float getImpactThreshold() const { return mImpactThreshold; }
+        bool popImpact(ImpactEvent& event) { return mImpactQueue.pop(event); }
+        unsigned long getDroppedImpactCount() const { return mDroppedImpacts.load(std::memory_order_relaxed); }
+
+        // --- Modèles par pas ---
+        // listener->onPhysicsTick(dt) avant chaque pas interne, dans l'ordre d'ajout.
+        // Le listener doit être retiré avant sa destruction.
+        void addTickListener(PhysicsTickListener* listener);
+        void removeTickListener(PhysicsTickListener* listener);
+
+        // --- Friction de la piste ---
+        // Contacts boule/plateau de lane : la friction combinée est lue dans field à chaque
+        // pas (callback de contact de Bullet, appelé pour chaque point à chaque narrowphase).
+        // field doit survivre à la piste ; nullptr : produit des frictions des deux corps.
+        static void setLaneFrictionField(btCollisionObject* lane, const LaneFrictionField* field);
+
+        // Rôle du corps pour la classification des chocs (stocké dans l'index utilisateur Bullet)
+        static void setBodyRole(btCollisionObject* body, BodyRole role);
+        static BodyRole getBodyRole(const btCollisionObject* body);
+
+        // --- Instantanés ---
+        // Copie l'état dynamique du monde dans snapshot (sans allocation). false si une
+        // capacité de l'instantané est dépassée (il est alors invalide).
+        bool captureSnapshot(PhysicsSnapshot& snapshot) const;
+        // Remet le monde dans l'état capturé : corps, compteur de pas, paires et points de
+        // contact. Sur place, sans passe de collision : les paires apparues depuis la capture
+        // sont retirées, les manifolds existants gardés et remplis des points capturés, et
+        // seules les paires séparées depuis la capture repassent par leur algorithme pour
+        // recréer leur manifold. Le pas suivant repart exactement du même état du solveur.
+        // false si l'instantané est invalide ou si ses corps ne sont plus tous dans le monde.
+        bool restoreSnapshot(const PhysicsSnapshot& snapshot);
+
+        // --- Instrumentation ---
+        // getProfiler().setEnabled(true) puis getLastFrameStats() après update/step ;
+        // getProfiler().startDump(...) pour une ligne CSV ou JSON par frame
+        PhysicsProfiler& getProfiler() { return mProfiler; }
+        const PhysicsFrameStats& getLastFrameStats() const { return mProfiler.getLastFrameStats(); }
+
+        ShapeCache& getShapeCache() { return mShapeCache; }
+        BvhCache& getBvhCache() { return mBvhCache; }
+        const BvhCache& getBvhCache() const { return mBvhCache; }
+
         // Accesseur au monde physique
         Ogre::Bullet::DynamicsWorld* getDynamicsWorld() { return mDynamicsWorld.get(); }
 };
@@ -0,0 +1,93 @@
+#pragma once
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class btDynamicsWorld;
+
+// Mesures d'une frame physique (un appel de PhysicsManager::update ou step).
+// Les temps sont cumulés sur les pas de la frame, les compteurs sont ceux du dernier pas.
+struct PhysicsFrameStats {
+    unsigned long frame = 0;
+    int steps = 0;
+    double totalMs = 0.0;           // stepSimulation complet
+    double broadphaseMs = 0.0;      // AABB et paires (updateAabbs, calculateOverlappingPairs)
+    double narrowphaseMs = 0.0;     // dispatchAllCollisionPairs
+    double solverMs = 0.0;          // Îlots et solveur de contraintes
+    double integrationMs = 0.0;     // Prédiction, intégration, activation, motion states
+    int bodies = 0;
+    int activeBodies = 0;
+    int islands = 0;                // Îlots contenant au moins un corps actif
+    int overlappingPairs = 0;
+    int manifolds = 0;
+    int contactPoints = 0;
+};
+
+// Profileur du pas physique : découpe le temps de stepSimulation par phase à l'aide des
+// zones BT_PROFILE de Bullet (btSetCustomEnterProfileZoneFunc), puis relève les compteurs
+// du monde après chaque pas. Les zones sont rattachées au profileur actif du thread qui
+// fait le pas : plusieurs mondes sur des threads différents se mesurent séparément, et
+// les zones exécutées par les threads de travail d'un monde multithread sont ignorées
+// (leur durée reste comprise dans la phase englobante du thread principal).
+// Si Bullet est compilé avec BT_NO_PROFILE, seuls le total et les compteurs sont mesurés.
+class PhysicsProfiler {
+    public:
+        enum Phase {
+            PHASE_NONE = -1,
+            PHASE_BROADPHASE,
+            PHASE_NARROWPHASE,
+            PHASE_SOLVER,
+            PHASE_INTEGRATION,
+            PHASE_COUNT
+        };
+
+        enum DumpFormat {
+            DUMP_CSV,
+            DUMP_JSON       // Une ligne JSON par frame (JSON Lines)
+        };
+
+    private:
+        bool mEnabled;
+        unsigned long mFrameCount;
+        PhysicsFrameStats mCurrent;
+        PhysicsFrameStats mLast;
+        double mPhaseMs[PHASE_COUNT];
+        std::chrono::steady_clock::time_point mStepStart;
+        std::vector<int> mIslandTags;   // Réutilisé d'un pas à l'autre (comptage des îlots)
+
+        std::ofstream mDump;
+        DumpFormat mDumpFormat;
+
+        void collectCounters(btDynamicsWorld* world);
+        void writeDumpRow(const PhysicsFrameStats& stats);
+
+    public:
+        PhysicsProfiler();
+        ~PhysicsProfiler();
+
+        PhysicsProfiler(const PhysicsProfiler&) = delete;
+        PhysicsProfiler& operator=(const PhysicsProfiler&) = delete;
+
+        // Désactivé par défaut : aucun coût tant qu'il n'est pas activé
+        void setEnabled(bool enabled);
+        bool isEnabled() const { return mEnabled; }
+
+        // Appelés par PhysicsManager autour de chaque frame et de chaque stepSimulation
+        void beginFrame();
+        void beginStep();
+        void endStep(btDynamicsWorld* world);
+        void endFrame();
+
+        // Dernière frame terminée
+        const PhysicsFrameStats& getLastFrameStats() const { return mLast; }
+        static const char* getPhaseName(Phase phase);
+
+        // Écrit une ligne par frame dans path (active le profileur). false si le fichier ne s'ouvre pas.
+        bool startDump(const std::string& path, DumpFormat format);
+        void stopDump();
+        bool isDumping() const { return mDump.is_open(); }
+
+        // Point d'entrée des zones Bullet (usage interne)
+        void addPhaseTime(Phase phase, double ms) { mPhaseMs[phase] += ms; }
+};
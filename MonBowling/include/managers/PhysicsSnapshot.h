@@ -0,0 +1,72 @@
+#pragma once
+#include <OgreBullet.h>
+#include <vector>
+
+// Instantané de l'état dynamique d'un monde physique : pour chaque corps non statique,
+// transformations, vitesses, forces en attente et état d'activation ; les paires du
+// broadphase ; pour chaque paire en contact, les points de contact avec leurs impulsions
+// (démarrage à chaud du solveur).
+//
+// Les tableaux sont alloués une fois à la construction : capture et restauration ne font
+// aucune allocation. Un instantané ne vaut que pour le monde où il a été pris (il référence
+// ses corps) ; voir PhysicsManager::captureSnapshot / restoreSnapshot.
+class PhysicsSnapshot {
+    friend class PhysicsManager;
+
+    private:
+        struct BodyState {
+            btRigidBody* body;
+            btTransform transform;
+            btTransform interpolationTransform;
+            btVector3 linearVelocity;
+            btVector3 angularVelocity;
+            btVector3 interpolationLinearVelocity;
+            btVector3 interpolationAngularVelocity;
+            btVector3 totalForce;
+            btVector3 totalTorque;
+            int activationState;
+            btScalar deactivationTime;
+        };
+
+        struct PairState {
+            btBroadphaseProxy* proxy0;
+            btBroadphaseProxy* proxy1;
+        };
+
+        struct ManifoldState {
+            const btCollisionObject* body0;
+            const btCollisionObject* body1;
+            int firstPoint;
+            int pointCount;
+        };
+
+        std::vector<BodyState> mBodies;
+        // Paires du broadphase, triées par proxies
+        std::vector<PairState> mPairs;
+        std::vector<ManifoldState> mManifolds;
+        // Index de mManifolds triés par paire de corps (recherche à la restauration)
+        std::vector<int> mManifoldOrder;
+        std::vector<btManifoldPoint> mPoints;
+        size_t mMaxBodies;
+        size_t mMaxPairs;
+        size_t mMaxManifolds;
+        size_t mMaxPoints;
+
+        unsigned long mStepCount;
+        double mSimulatedTime;
+        bool mValid;
+
+    public:
+        // Capacités : corps dynamiques, paires en contact et points de contact au total,
+        // paires du broadphase (en contact ou non)
+        explicit PhysicsSnapshot(size_t maxBodies = 64, size_t maxManifolds = 256, size_t maxPoints = 1024,
+                                 size_t maxPairs = 512);
+
+        bool isValid() const { return mValid; }
+        void invalidate() { mValid = false; }
+        unsigned long getStepCount() const { return mStepCount; }
+        size_t getBodyCount() const { return mBodies.size(); }
+        size_t getContactPointCount() const { return mPoints.size(); }
+        // Mémoire réservée par l'instantané
+        size_t getCapacityBytes() const;
+};
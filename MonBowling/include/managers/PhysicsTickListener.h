@@ -0,0 +1,11 @@
+#pragma once
+
+// Modèle appelé par PhysicsManager avant chaque pas interne de Bullet (callback de
+// pré-tick), avec la durée de ce pas. Les forces et vitesses qu'il applique sont donc
+// intégrées à chaque sous-pas, quelles que soient la fréquence d'affichage et le nombre
+// de pas d'une frame.
+class PhysicsTickListener {
+    public:
+        virtual ~PhysicsTickListener() = default;
+        virtual void onPhysicsTick(float timeStep) = 0;
+};
@@ -0,0 +1,86 @@
+#pragma once
+#include <Ogre.h>
+#include <OgreBullet.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Libère une forme et, pour une forme composée, ses formes enfants
+struct ShapeDeleter {
+    void operator()(btCollisionShape* shape) const;
+};
+
+// Forme décrite par les valeurs que Bullet stocke (dimensions internes, échelle, marge,
+// sommets, enfants) : de quoi la reconstruire à l'identique sans le mesh (GameReplay)
+struct ShapeDescription {
+    int type = INVALID_SHAPE_PROXYTYPE;     // BroadphaseNativeTypes
+    std::vector<float> values;
+    std::vector<ShapeDescription> children; // Forme composée : un enfant par forme fille
+};
+
+// Formes de collision partagées entre les corps d'un même monde (toutes les quilles
+// d'un même mesh utilisent une seule forme). Le cache possède ses formes : il doit
+// survivre aux corps qui les utilisent (c'est le cas dans PhysicsManager).
+class ShapeCache {
+    public:
+        // Niveau de détail des formes construites à partir d'un mesh
+        enum Quality {
+            QUALITY_LOW,     // Cylindres empilés épousant le profil du mesh
+            QUALITY_MEDIUM,  // Enveloppe convexe réduite à mHullVertexBudget sommets
+            QUALITY_HIGH     // Enveloppe convexe de tous les sommets (ancien CT_HULL)
+        };
+
+    private:
+        std::map<std::string, std::unique_ptr<btCollisionShape, ShapeDeleter>> mShapes;
+
+        Quality mQuality;
+        int mHullVertexBudget;
+        int mCylinderSegments;
+
+        std::string makeMeshKey(const Ogre::MeshPtr& mesh, const Ogre::Vector3& scale) const;
+
+    public:
+        ShapeCache();
+
+        ShapeCache(const ShapeCache&) = delete;
+        ShapeCache& operator=(const ShapeCache&) = delete;
+
+        // Forme du mesh au niveau de qualité courant (construite au premier appel)
+        btCollisionShape* getMeshShape(const Ogre::MeshPtr& mesh, const Ogre::Vector3& scale = Ogre::Vector3::UNIT_SCALE);
+
+        // Formes construites à la main (simulation sans rendu) : nullptr si absente
+        btCollisionShape* findShape(const std::string& key) const;
+        // Le cache prend possession de la forme ; retourne la forme déjà présente si la clé existe
+        btCollisionShape* addShape(const std::string& key, btCollisionShape* shape);
+
+        // Les nouveaux réglages ne s'appliquent qu'aux formes construites ensuite
+        void setQuality(Quality quality) { mQuality = quality; }
+        Quality getQuality() const { return mQuality; }
+        void setHullVertexBudget(int vertices);
+        int getHullVertexBudget() const { return mHullVertexBudget; }
+        void setCylinderSegments(int segments);
+        int getCylinderSegments() const { return mCylinderSegments; }
+
+        void clear() { mShapes.clear(); }
+        size_t getShapeCount() const { return mShapes.size(); }
+        // Mémoire estimée des formes du cache (octets)
+        size_t getMemoryUsage() const;
+
+        // --- Construction (utilisable sans cache, par exemple pour comparer) ---
+        // Positions de tous les sommets du mesh (tampons partagés et propres aux sous-meshes)
+        static std::vector<btVector3> collectVertices(const Ogre::MeshPtr& mesh, const Ogre::Vector3& scale);
+        static btConvexHullShape* buildHull(const std::vector<btVector3>& vertices);
+        // Au plus vertexBudget sommets : points d'appui dans des directions réparties sur la sphère
+        static btConvexHullShape* buildReducedHull(const std::vector<btVector3>& vertices, int vertexBudget);
+        // segments cylindres le long de Y, rayon = distance maximale à l'axe dans chaque tranche
+        static btCompoundShape* buildCylinderStack(const std::vector<btVector3>& vertices, int segments);
+        static size_t estimateMemory(const btCollisionShape* shape);
+
+        // Sphère, boîte, cylindre d'axe Y, enveloppe convexe, plan statique et formes
+        // composées de celles-ci ; false pour toute autre forme
+        static bool describeShape(const btCollisionShape* shape, ShapeDescription& description);
+        // Nouvelle forme identique à celle décrite (à libérer avec ShapeDeleter) ; nullptr si
+        // la description est invalide
+        static btCollisionShape* createShape(const ShapeDescription& description);
+};
@@ -4,9 +4,37 @@
 #include <OgreBullet.h>
 #include "../managers/PhysicsManager.h"
 #include "../core/AimingSystem.h"
-class BowlingBall {
+// Détection continue des collisions de la boule, proportionnelle à son rayon.
+// Au-delà de motionThresholdRatio * rayon parcouru en un pas, Bullet balaie une sphère de
+// sweptSphereRatio * rayon le long du déplacement et arrête la boule au premier contact
+// au lieu de la laisser traverser une quille.
+struct BallCcdProfile {
+    bool enabled = true;
+    float motionThresholdRatio = 0.5f;
+    // Plus petit que la boule : le balayage ne touche pas la piste sur laquelle elle roule
+    float sweptSphereRatio = 0.6f;
+};
+
+// Propriétés physiques du corps de la boule, telles que le jeu les a construites (sphère
+// ajustée au mesh) : recopiées sur une boule sans rendu pour qu'elle roule comme elle
+// (lancer fantôme de TrajectoryPredictor)
+struct BallBodyProperties {
+    float collisionRadius = 0.0f;
+    float mass = 0.0f;
+    btVector3 localInertia = btVector3(0, 0, 0);
+    float friction = 0.0f;
+    float restitution = 0.0f;
+    float rollingFriction = 0.0f;
+    float spinningFriction = 0.0f;
+    float linearDamping = 0.0f;
+    float angularDamping = 0.0f;
+};
+
+class BowlingBall : public PhysicsTickListener {
     private:
         Ogre::SceneManager* sceneMgr;
+        // Monde physique de la boule (singleton du jeu par défaut)
+        PhysicsManager* physicsManager;
         
         // Nœud et entité
         Ogre::SceneNode* ballNode;
@@ -23,22 +51,42 @@ class BowlingBall {
         // État de la boule
         bool rolling;
         Ogre::Vector3 initialPosition;
+        BallCcdProfile ccdProfile;
+        // Propriétés imposées avant create (boule sans rendu copiée d'une autre)
+        BallBodyProperties bodyProperties;
+        bool hasBodyProperties;
+        // Forme imposée avant create (boule sans rendu rejouant une partie du jeu)
+        std::unique_ptr<btCollisionShape, ShapeDeleter> headlessShape;
 
         // Constante pour la limite Y
         const float STOP_Z_LIMIT = -17.0f;
         // Constante pour le seuil de vitesse d'arrêt
         const float STOP_VELOCITY_THRESHOLD = 0.05f; 
+        // Modèle d'effet : force latérale par unité de spin Y et de vitesse, pour la durée
+        // d'une frame à 60 images/s ; amortissement du spin par seconde
+        const float SPIN_SIDE_FORCE_FACTOR = 0.3f;
+        const float SPIN_REFERENCE_FRAME_TIME = 1.0f / 60.0f;
+        const float SPIN_DAMPING_RATE = 0.005f;
+
+        // Propriétés physiques communes (avec ou sans rendu)
+        void configureBody();
+        void applyCcdProfile();
+        // Effet (hook) et amortissement du spin sur un pas physique de durée timeStep
+        void applySpin(float timeStep);
         
     public:
-        BowlingBall(Ogre::SceneManager* sceneMgr, const Ogre::String& meshName = "ball.mesh");
+        // sceneMgr == nullptr : simulation sans rendu (corps Bullet seul, sans nœud ni entité)
+        // physics == nullptr : PhysicsManager::getInstance()
+        BowlingBall(Ogre::SceneManager* sceneMgr, const Ogre::String& meshName = "ball.mesh", PhysicsManager* physics = nullptr);
         ~BowlingBall();
         
         // Méthodes principales
         void create(const Ogre::Vector3& position);
         void reset();
         void launch(const Ogre::Vector3& direction, float power, float spin = 0.0f);
+        // Arrêt de la boule ; l'effet du spin est appliqué à chaque pas par onPhysicsTick
         void update(float deltaTime);
-        void updateSpin(float deltaTime);
+        void onPhysicsTick(float timeStep) override;
         
         // Accesseurs
         Ogre::SceneNode* getBallNode() const { return ballNode; }
@@ -47,6 +95,9 @@ class BowlingBall {
         Ogre::Vector3 getPosition() const;
         Ogre::Vector3 getVelocity() const;
         float getRadius() const;
+        // Rayon de la forme de collision réellement utilisée (sphère ajustée au mesh en jeu,
+        // environ 0.216 m ; getRadius() sans corps)
+        float getCollisionRadius() const;
         SpinInfo getCurrentSpinInfo() const;
         
         // Modificateurs
@@ -55,4 +106,17 @@ class BowlingBall {
         void setRestitution(float restitution);
         void setRollingFriction(float rollingFriction);
         void setSpinningFriction(float spinningFriction);
+        // Reprise d'un lancer restauré depuis un instantané physique (le corps est déjà en place)
+        void setRolling(bool rolling) { this->rolling = rolling; }
+        // Avant ou après create ; recalculé depuis getCollisionRadius()
+        void setCcdProfile(const BallCcdProfile& profile);
+        const BallCcdProfile& getCcdProfile() const { return ccdProfile; }
+        // Propriétés du corps créé (valeurs nominales avant create)
+        BallBodyProperties getBodyProperties() const;
+        // Avant create, boule sans rendu : sphère du rayon donné, masse, inertie, frictions et
+        // amortissement repris tels quels au lieu des valeurs nominales
+        void setBodyProperties(const BallBodyProperties& properties);
+        // Avant create, boule sans rendu : forme de collision à utiliser à la place de la
+        // sphère nominale (la boule en prend possession ; voir ShapeCache::createShape)
+        void setCollisionShape(btCollisionShape* shape);
 };
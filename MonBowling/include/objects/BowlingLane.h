@@ -2,37 +2,115 @@
 #define BOWLING_LANE_H
 
 #include <Ogre.h>
+#include <array>
 #include <vector>
 #include <memory>
 #include "../../include/managers/PhysicsManager.h"
 #include "../../include/objects/BowlingPin.h"
+#include "../../include/objects/LaneCollider.h"
+#include "../../include/utils/PinFallClassifier.h"
+
+// Forme de collision de la piste
+enum class LaneColliderType {
+    MESH,       // Maillage triangulaire du mesh (BVH en cache disque)
+    ANALYTIC    // Boîtes statiques construites depuis LaneDefinition (plateau, gouttières, fosse)
+};
+
+// Sol tel que le jeu l'a créé (forme, position, matériau, filtre de collision) : recréé à
+// l'identique sans rendu pour rejouer une partie du jeu (GameReplay)
+struct GroundDescription {
+    ShapeDescription shape;
+    btTransform transform = btTransform::getIdentity();
+    float friction = 0.5f;
+    float restitution = 0.0f;
+    float rollingFriction = 0.0f;
+    float spinningFriction = 0.0f;
+    int filterGroup = 0;
+    int filterMask = 0;
+};
 
 class BowlingLane {
     private:    
         Ogre::SceneManager* sceneMgr;
+        PhysicsManager* physicsManager;
         Ogre::Vector3 ballStartPosition;
         
         // Éléments de la piste
         Ogre::SceneNode* laneNode;
         Ogre::Entity* laneEntity;
+        btRigidBody* laneBody;
+        btRigidBody* groundBody;
+        Ogre::String laneMeshName;
+        LaneColliderType colliderType;
+        // Sans rendu : sol et maillage de la piste du jeu (empreinte 0 : boîte approchée)
+        GroundDescription headlessGround;
+        bool hasHeadlessGround;
+        uint64_t headlessLaneHash;
+        LaneDefinition laneDefinition;
+        // Motif d'huilage : friction des contacts boule/plateau (désactivé par défaut)
+        LaneFrictionField oilPattern;
+        bool oilPatternEnabled;
         
         // Les quilles
         std::vector<std::unique_ptr<BowlingPin>> pins;
         bool pinsInitialized;
+        // Quilles debout, calculé une fois dans setupPins (relevage en une passe)
+        std::array<btRigidBody*, 10> rackBodies;
+        std::array<btTransform, 10> rackLayout;
 
+        void createGround(bool planeCollider);
         void createLane();
+        void destroyLane();
+        void applyOilPattern();
         void setupPins();
         
     public:
         const std::vector<std::unique_ptr<BowlingPin>>& getPins() const;
 
-        BowlingLane(Ogre::SceneManager* sceneMgr);
+        // sceneMgr == nullptr : simulation sans rendu (piste et quilles réduites à leurs corps Bullet)
+        // physics == nullptr : PhysicsManager::getInstance()
+        BowlingLane(Ogre::SceneManager* sceneMgr, PhysicsManager* physics = nullptr);
         ~BowlingLane();
         
         void create(const Ogre::Vector3& ballStartPosition);
-        void update(float deltaTime);
+        // Change le mesh de la piste (avant ou après create) ; la BVH vient du cache disque
+        void setLaneMesh(const Ogre::String& meshName);
+        const Ogre::String& getLaneMesh() const { return laneMeshName; }
+        // Par défaut : MESH avec rendu, ANALYTIC sans rendu. Avant create (sinon remplacement à chaud)
+        void setColliderType(LaneColliderType type);
+        LaneColliderType getColliderType() const { return colliderType; }
+        // Corps statique de la piste (nullptr avant create) ; sa forme maillée vient de BvhCache
+        const btRigidBody* getLaneBody() const { return laneBody; }
+        // Corps statique du sol (nullptr avant create)
+        const btRigidBody* getGroundBody() const { return groundBody; }
+        // Avant create, sans rendu : sol recréé depuis sa description au lieu du plan par défaut
+        void setHeadlessGround(const GroundDescription& ground);
+        // Avant create, sans rendu : piste MESH relue du fichier de BvhCache (nom du mesh et
+        // empreinte donnés par BvhCache::findShapeKey) au lieu de la boîte approchée. Sans
+        // fichier, la piste n'a pas de corps (erreur dans le log).
+        void setHeadlessLaneMesh(const Ogre::String& meshName, uint64_t hash);
+        void setLaneDefinition(const LaneDefinition& definition);
+        const LaneDefinition& getLaneDefinition() const { return laneDefinition; }
+        // Motif d'huilage lu depuis un fichier (voir LaneFrictionField) ; false si illisible,
+        // la piste garde alors sa friction. clearOilPattern revient à la friction uniforme.
+        bool loadOilPattern(const std::string& path);
+        // Motif déjà construit (rejeu d'un enregistrement), placé sur la piste comme un fichier
+        void setOilPattern(const LaneFrictionField& pattern);
+        void clearOilPattern();
+        bool hasOilPattern() const { return oilPatternEnabled; }
+        const LaneFrictionField& getOilPattern() const { return oilPattern; }
+        // Relève les dix quilles en une passe (PhysicsManager::teleportBodies) : corps,
+        // motion states et nœuds replacés, contacts et paires de l'ancien jeu supprimés.
+        // Le jeu de quilles est prêt à simuler dès le pas suivant.
         void resetPins();
+        // Quilles couchées ou sorties du plateau (PinFallClassifier, seuils par défaut)
         int countKnockedDownPins() const;
+        // Masque des quilles abattues : bit i = pins[i] (quille numéro i+1)
+        int getKnockedDownMask() const;
+
+        // Emplacements des 10 quilles pour une boule partant de ballStartPosition
+        // (pins[9] = quille de tête, la plus proche de la boule)
+        static std::array<Ogre::Vector3, 10> computePinPositions(const Ogre::Vector3& ballStartPosition);
 };
 
 #endif 
\ No newline at end of file
@@ -8,22 +8,32 @@ class BowlingPin {
 
     private:
         Ogre::SceneManager* sceneMgr;
+        PhysicsManager* physicsManager;
         Ogre::SceneNode* pinNode;
         Ogre::Entity* pinEntity;
         btRigidBody* pinBody;
         Ogre::Vector3 initialPosition;
+
+        // Propriétés physiques communes (avec ou sans rendu)
+        void configureBody();
         
     public:
-        BowlingPin(Ogre::SceneManager* sceneMgr);
+        // sceneMgr == nullptr : simulation sans rendu (corps Bullet seul, sans nœud ni entité)
+        // physics == nullptr : PhysicsManager::getInstance()
+        BowlingPin(Ogre::SceneManager* sceneMgr, PhysicsManager* physics = nullptr);
         ~BowlingPin();
         
         void create(const Ogre::Vector3& position, int pinIndex);
         void reset();
-        void update(float deltaTime);
         bool isKnockedDown() const;
         
         btRigidBody* getPinBody() const;
         Ogre::SceneNode* getPinNode() const;
+
+        // Simulation sans rendu : forme des quilles créées ensuite dans ce monde à la place
+        // du cylindre approché (le ShapeCache du monde en prend possession). Sans effet si
+        // une quille a déjà été créée.
+        static void setHeadlessShape(PhysicsManager& physics, btCollisionShape* shape);
         
 };
 
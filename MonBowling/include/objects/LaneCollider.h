@@ -0,0 +1,37 @@
+#ifndef LANE_COLLIDER_H
+#define LANE_COLLIDER_H
+
+#include <OgreBullet.h>
+
+// Dimensions d'une piste réglementaire (etape.md : 18 m x 1.05 m avec gouttières).
+// Repère du jeu : la boule roule vers -Z, le dessus du plateau est à y = 0.
+struct LaneDefinition {
+    float length = 18.0f;           // Ligne de faute -> bord de la fosse
+    float width = 1.05f;            // Plateau entre les deux gouttières
+    float gutterWidth = 0.235f;
+    float gutterDepth = 0.048f;
+    float approachLength = 4.5f;    // Zone d'élan derrière la ligne de faute (pleine largeur)
+    float pinDeckLength = 0.9f;     // Partie du plateau bordée par les kickbacks
+    float kickbackHeight = 0.6f;    // Murs latéraux autour des quilles
+    float cappingHeight = 0.05f;    // Rebord extérieur des gouttières le long de la piste
+    float wallThickness = 0.05f;
+    float pitLength = 0.9f;
+    float pitDepth = 0.5f;
+    float deckThickness = 0.1f;
+    float centerX = 0.0f;
+    float deckEndZ = -10.5f;        // Bord du plateau côté fosse (quilles posées juste devant)
+
+    float friction = 0.8f;          // Mêmes valeurs que la piste maillée
+    float rollingFriction = 0.1f;
+
+    float getFoulLineZ() const { return deckEndZ + length; }
+    // Demi-largeur extérieure, gouttières comprises
+    float getOuterHalfWidth() const { return 0.5f * width + gutterWidth; }
+};
+
+// Forme statique de la piste : boîtes pour le plateau, l'élan, les gouttières, les rebords,
+// les kickbacks, le fond et le coussin de la fosse. Fond de gouttière plat (approximation
+// du profil arrondi). L'appelant possède la forme et ses enfants (voir ShapeDeleter).
+btCompoundShape* buildAnalyticLaneShape(const LaneDefinition& definition);
+
+#endif // LANE_COLLIDER_H
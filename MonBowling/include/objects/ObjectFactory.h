@@ -6,9 +6,17 @@
 class ObjectFactory{
     private:
         Ogre::SceneManager* mSceneMgr;
+        PhysicsManager* mPhysics;
+        int mStackCount;    // Pour des noms d'entités uniques d'une pile à l'autre
+
+        // Sans SceneManager : formes primitives (cube de 1 m, sphère et cylindre de 0.5 m de rayon)
+        btRigidBody* createPrimitiveBody(btCollisionShape* shape, const Ogre::Vector3& position, float mass);
         
     public:
-        ObjectFactory(Ogre::SceneManager* sceneMgr) : mSceneMgr(sceneMgr) {}
+        // sceneMgr == nullptr : objets purement physiques (bancs d'essai sans rendu)
+        // physics == nullptr : PhysicsManager::getInstance()
+        ObjectFactory(Ogre::SceneManager* sceneMgr, PhysicsManager* physics = nullptr)
+            : mSceneMgr(sceneMgr), mPhysics(physics ? physics : PhysicsManager::getInstance()), mStackCount(0) {}
         
         // Méthodes de création d'objets
         btRigidBody* createStaticGround();
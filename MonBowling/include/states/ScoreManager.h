@@ -11,33 +11,54 @@
 #include <OgreTextAreaOverlayElement.h>
 #include <OgreTechnique.h>
 #include <OgrePass.h>
+#include "ScoreRules.h"
 
-// Pattern Singleton pour le gestionnaire de score
+// Gestionnaire de score : instance unique pour le jeu, une instance par piste pour
+// les sessions sans rendu (LaneSession), sans overlay tant qu'initialize n'est pas appelé
 class ScoreManager {
     private:
-        // Constructeur privé (pattern Singleton)
-        ScoreManager();
-        
-        // Destructeur
-        ~ScoreManager();
-        
         // Instance unique
         static ScoreManager* mInstance;
 
+    public:
         // Constante pour le nombre maximum de lancers possibles dans une partie (10 frames * 2 lancers + 3 pour la 10e frame max)
-        static const int MAX_ROLLS = 21; 
+        static const int MAX_ROLLS = ScoreRules::MAX_ROLLS;
+        static const int FRAME_COUNT = ScoreRules::FRAME_COUNT;
+
+    private:
+        // Frame dont le strike ou le spare attend encore des lancers bonus
+        struct PendingBonus {
+            int frame;
+            int score;          // 10 + bonus déjà reçus
+            int rollsLeft;
+        };
 
         // Tableau pour stocker les quilles abattues à chaque lancer
         std::array<int, MAX_ROLLS> mRolls;
         
-        // Tableau pour stocker le score calculé pour chaque frame (optionnel, pour affichage détaillé)
-        std::array<int, 10> mFrameScores;
+        // Score de chaque frame, écrit une seule fois quand la frame est réglée (0 avant)
+        std::array<int, FRAME_COUNT> mFrameScores;
         
         // Index du prochain lancer à enregistrer dans mRolls
         int mCurrentRoll;
         
         // Score total calculé
         int mTotalScore;
+
+        // Calcul incrémental : au plus deux frames en attente de bonus (deux strikes de suite)
+        std::array<PendingBonus, 2> mPending;
+        int mPendingCount;
+        int mFrame;             // Frame en cours (0-9), FRAME_COUNT une fois la partie finie
+        int mRollInFrame;
+        int mFramePins;         // Quilles de la frame en cours (10e : tous ses lancers)
+        int mRackPins;          // Quilles couchées depuis le dernier relevage
+        int mRackBalls;         // Lancers joués depuis le dernier relevage (0 : jeu complet)
+        // Marques de chaque frame pour le tableau de score (X, /, -, 1-9), terminées par '\0'
+        std::array<std::array<char, 4>, FRAME_COUNT> mFrameMarks;
+        // Bit r : le lancer r de la frame a laissé un split
+        std::array<int, FRAME_COUNT> mSplitMasks;
+        // Score affiché (le texte n'est refait que s'il change)
+        int mDisplayedScore;
         
         // Éléments d'interface pour l'affichage du score
         Ogre::Overlay* mScoreOverlay;
@@ -45,29 +66,44 @@ class ScoreManager {
         Ogre::TextAreaOverlayElement* mScoreText;
 
         // --- Méthodes utilitaires privées pour le calcul du score ---
-        void calculateScore();
-        bool isStrike(int rollIndex) const;
-        bool isSpare(int rollIndex) const;
-        int strikeBonus(int rollIndex) const;
-        int spareBonus(int rollIndex) const;
-        int openFrameScore(int rollIndex) const;
+        void settleFrame(int frame, int score);
+        void addPendingBonus(int frame, int rollsLeft);
+        void setRollMark(int pins, bool rackCleared, bool freshRack, int knockedDownMask);
 
         
     public:
+        ScoreManager();
+        ~ScoreManager();
+        ScoreManager(const ScoreManager&) = delete;
+        ScoreManager& operator=(const ScoreManager&) = delete;
+
         // Obtenir l'instance unique
         static ScoreManager* getInstance();
         
         // Initialisation du gestionnaire de score et de l'UI
         void initialize();
         
-        // Enregistre le nombre de quilles abattues pour le lancer actuel
-        void recordRoll(int pins);
+        // Enregistre le nombre de quilles abattues pour le lancer actuel. Coût constant : seuls
+        // les bonus en attente et la frame en cours sont touchés. knockedDownMask : quilles
+        // couchées depuis le relevage (BowlingLane::getKnockedDownMask), -1 si inconnu (pas de split)
+        void recordRoll(int pins, int knockedDownMask = -1);
         
         // Réinitialisation du score pour une nouvelle partie
         void resetScore();
         
         // Obtenir le score total actuel
         int getCurrentScore() const;
+        const std::array<int, FRAME_COUNT>& getFrameScores() const { return mFrameScores; }
+        const std::array<int, MAX_ROLLS>& getRolls() const { return mRolls; }
+        int getRollCount() const { return mCurrentRoll; }
+        // Marques de la frame (chaîne vide si pas encore jouée), ex. "X", "7/", "9-", "X9/"
+        const char* getFrameMarks(int frame) const { return mFrameMarks[frame].data(); }
+        // Bit r : le lancer r de la frame a laissé un split (tête couchée, quilles séparées)
+        int getSplitMask(int frame) const { return mSplitMasks[frame]; }
+
+        // Split : quille de tête couchée et quilles restantes en au moins deux groupes séparés
+        // (bit i = pins[i] de BowlingLane, pins[9] en tête)
+        static bool isSplit(int knockedDownMask);
         
         // Mise à jour de l'affichage du score à l'écran
         void updateScoreDisplay();
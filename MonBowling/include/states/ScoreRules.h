@@ -0,0 +1,73 @@
+#ifndef SCORE_RULES_H
+#define SCORE_RULES_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Règles de score d'une partie (strikes, spares, 10e frame), sans Ogre ni état global :
+// bibliothèque BowlingScoring, utilisable seule pour rescorer des lots de parties.
+
+// Partie compacte : 4 bits par lancer (0-10 quilles, 15 = pas de lancer), lancer i dans les
+// bits 4i..4i+3 des 128 bits (lo puis hi). Les 11 quartets après le 21e valent aussi 15.
+struct PackedGame {
+    uint64_t lo;
+    uint64_t hi;
+};
+
+// Défauts d'une partie, cumulables (0 = partie complète et valide)
+enum ScoreError : uint8_t {
+    SCORE_ERROR_PIN_COUNT = 1 << 0,     // Lancer de plus de 10 quilles (ou quartet 11-14)
+    SCORE_ERROR_RACK_TOTAL = 1 << 1,    // Plus de 10 quilles dans un même jeu de quilles
+    SCORE_ERROR_MISSING_ROLL = 1 << 2,  // Partie incomplète
+    SCORE_ERROR_EXTRA_ROLL = 1 << 3     // Lancer après la fin de la partie
+};
+
+// Strikes et spares d'une partie, rapportés aux occasions d'en faire : une occasion de strike
+// par jeu de quilles neuf, une occasion de spare par jeu non abattu à la première boule
+struct MarkCounts {
+    int strikes = 0;
+    int strikeChances = 0;
+    int spares = 0;
+    int spareChances = 0;
+};
+
+class ScoreRules {
+    public:
+        // 10 frames * 2 lancers + 1 lancer bonus de la 10e frame au plus
+        static const int MAX_ROLLS = 21;
+        static const int FRAME_COUNT = 10;
+        static const uint8_t NO_ROLL = 15;
+
+        // Lecture de rolls[rollIndex] et des lancers suivants, 0 au-delà de MAX_ROLLS
+        static bool isStrike(const std::array<int, MAX_ROLLS>& rolls, int rollIndex);
+        static bool isSpare(const std::array<int, MAX_ROLLS>& rolls, int rollIndex);
+        static int strikeBonus(const std::array<int, MAX_ROLLS>& rolls, int rollIndex);
+        static int spareBonus(const std::array<int, MAX_ROLLS>& rolls, int rollIndex);
+        static int openFrameScore(const std::array<int, MAX_ROLLS>& rolls, int rollIndex);
+
+        // Score des rollCount premiers lancers : frames réglées seulement (les autres à 0).
+        // Parcours complet depuis la frame 1, référence du calcul incrémental de ScoreManager.
+        static int scoreRolls(const std::array<int, MAX_ROLLS>& rolls, int rollCount,
+                              std::array<int, FRAME_COUNT>& frameScores);
+
+        // false si rollCount > MAX_ROLLS ou une valeur hors de 0-10 (ne valide pas la partie)
+        static bool pack(const int* rolls, int rollCount, PackedGame& game);
+        // Lancers jusqu'au premier quartet vide ; retourne leur nombre
+        static int unpack(const PackedGame& game, int* rolls);
+
+        // Ajoute à counts les strikes et spares des lancers joués (partie valide, complète ou non)
+        static void countMarks(const PackedGame& game, MarkCounts& counts);
+
+        // Défauts de la partie (combinaison de ScoreError), 0 si complète et valide
+        static uint8_t validate(const PackedGame& game);
+        // Score final d'une partie complète et valide, -1 sinon
+        static int scoreGame(const PackedGame& game);
+
+        // Lot : scores[i] = score de games[i] (-1 si invalide), errors[i] = ses défauts
+        // (errors peut être nul). Noyau sans branchement, le même pour chaque partie.
+        // Retourne le nombre de parties invalides.
+        static size_t scoreGames(const PackedGame* games, size_t count, int16_t* scores, uint8_t* errors);
+};
+
+#endif // SCORE_RULES_H
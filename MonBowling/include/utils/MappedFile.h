@@ -0,0 +1,47 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// Fichier projeté en mémoire en lecture-écriture (mmap, MapViewOfFile sous Windows).
+// Les pages ne sont lues sur le disque qu'au premier accès et peuvent être rendues par le
+// système : un fichier de plusieurs centaines de Mo ne coûte que les pages réellement lues.
+class MappedFile {
+    private:
+        std::string mPath;
+        char* mData;
+        size_t mSize;
+#ifdef _WIN32
+        void* mFile;
+        void* mMapping;
+#else
+        int mFile;
+#endif
+
+        bool map();
+        void unmap();
+
+    public:
+        MappedFile();
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // Ouvre ou crée le fichier ; agrandi (zéros) jusqu'à minimumSize octets si besoin
+        bool open(const std::string& path, size_t minimumSize);
+        void close();
+        bool isOpen() const { return mData != nullptr; }
+
+        // Nouvelle taille du fichier (reprojeté : les pointeurs vers data() sont invalidés)
+        bool resize(size_t size);
+        // Écriture des pages modifiées demandée au système (sans attendre la fin)
+        void flush();
+
+        char* data() { return mData; }
+        const char* data() const { return mData; }
+        size_t size() const { return mSize; }
+        const std::string& getPath() const { return mPath; }
+};
+
+#endif // MAPPED_FILE_H
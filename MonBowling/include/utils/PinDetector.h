@@ -3,10 +3,11 @@
 
 #include <vector>
 #include <memory>
-#include <OgreTimer.h>
 #include <OgreStringConverter.h>
 #include <OgreLogManager.h>
 #include "../include/objects/BowlingPin.h"
+#include "PinFallClassifier.h"
+#include "RollSettleDetector.h"
 
 // Classe pour la détection des quilles tombées
 class PinDetector {
@@ -18,12 +19,12 @@ class PinDetector {
         bool mDetectionActive;
         bool mDetectionComplete;
         
-        // Minuteur pour le délai de cascade
-        Ogre::Timer mCascadeTimer;
-        
-        // Délai de cascade (en millisecondes)
-        const unsigned long CASCADE_DELAY = 200; // 5 secondes (5000)
+        // Fin de la détection : boule et quilles au repos (remplace l'ancien délai de cascade fixe)
+        RollSettleDetector mSettleDetector;
         
+        // Classement de toutes les quilles en une passe (debout, vacille, tombée, hors du plateau)
+        PinFallClassifier mClassifier;
+
         // Nombre de quilles tombées
         int mKnockedDownPinCount;
         
@@ -32,11 +33,12 @@ class PinDetector {
 
 
     public:
-        PinDetector();
+        // physics == nullptr : PhysicsManager::getInstance()
+        explicit PinDetector(PhysicsManager* physics = nullptr);
         ~PinDetector();
         
-        // Initialisation du détecteur
-        void initialize(const std::vector<std::unique_ptr<BowlingPin>>& pins);
+        // Initialisation du détecteur (la boule fait aussi partie des corps à attendre)
+        void initialize(const std::vector<std::unique_ptr<BowlingPin>>& pins, const btRigidBody* ballBody = nullptr);
         
         // Démarrer la détection après un lancer
         void startDetection();
@@ -44,11 +46,18 @@ class PinDetector {
         // Mettre à jour la détection
         void update(float deltaTime);
         
-        // Obtenir le nombre de quilles tombées
+        // Obtenir le nombre de quilles tombées (couchées ou hors du plateau)
         int getKnockedDownPinCount() const;
+        // États détaillés de la dernière mise à jour ; seuils réglables par setThresholds
+        const PinFallClassifier& getClassifier() const { return mClassifier; }
+        void setThresholds(const PinFallThresholds& thresholds) { mClassifier.setThresholds(thresholds); }
         
         // Vérifier si la détection est terminée
         bool isDetectionComplete() const;
+
+        // Temps simulé entre le début de la détection et le repos complet
+        float getSettleTime() const { return mSettleDetector.getSettleTime(); }
+        const RollSettleDetector& getSettleDetector() const { return mSettleDetector; }
         
         // Réinitialiser la détection
         void reset();
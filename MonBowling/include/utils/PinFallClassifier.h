@@ -0,0 +1,82 @@
+#ifndef PIN_FALL_CLASSIFIER_H
+#define PIN_FALL_CLASSIFIER_H
+
+#include <vector>
+#include <OgreBullet.h>
+
+// État d'une quille pour le comptage. Ordre croissant de gravité : le classement
+// retient le plus grave des critères remplis.
+enum class PinFallState : unsigned char {
+    STANDING = 0,   // Debout sur son emplacement
+    WOBBLING = 1,   // Encore debout, mais inclinée ou déplacée (vacille, glisse)
+    FALLEN = 2,     // Couchée
+    OFF_DECK = 3    // Sortie du plateau (fosse, gouttière basse), quelle que soit son inclinaison
+};
+
+// Réglages du classement. Une quille WOBBLING compte comme debout.
+struct PinFallThresholds {
+    float fallenAngle = 45.0f;          // degrés d'inclinaison au-delà desquels la quille tombe
+    float hysteresisAngle = 5.0f;       // une quille couchée ne se relève que sous fallenAngle - hysteresisAngle
+    float wobbleAngle = 3.0f;           // degrés d'inclinaison d'une quille qui vacille
+    float wobbleDisplacement = 0.02f;   // m de glissement horizontal hors de l'emplacement
+    float offDeckDrop = 0.3f;           // m sous l'emplacement : quille hors du plateau
+};
+
+// Classement de toutes les quilles en une passe. Les transformations Bullet sont d'abord
+// recopiées dans des tableaux contigus (axe vertical local, origine), puis une seule boucle
+// sans branchement ni indirection calcule tous les états, que le compilateur vectorise.
+//
+// L'hystérésis porte sur l'état précédent : une quille qui oscille autour de fallenAngle
+// (appuyée contre une autre, qui roule sur son flanc) ne change pas le compte à chaque
+// frame, et une quille sortie du plateau le reste jusqu'à begin().
+class PinFallClassifier {
+    private:
+        PinFallThresholds mThresholds;
+        // Seuils précalculés (cosinus, carré)
+        float mCosFallen;
+        float mCosRaise;
+        float mCosWobble;
+        float mWobbleDisplacementSq;
+
+        std::vector<const btRigidBody*> mBodies;
+        // Emplacements (origine des corps au moment de setPins)
+        std::vector<float> mSpotX, mSpotY, mSpotZ;
+        // Recopie des transformations : composante verticale de l'axe Y local, origine
+        std::vector<float> mUpY, mPosX, mPosY, mPosZ;
+        std::vector<unsigned char> mStates;
+
+        int mKnockedDownCount;
+        int mKnockedDownMask;
+
+        void gather();
+        void classifyAll();
+
+    public:
+        explicit PinFallClassifier(const PinFallThresholds& thresholds = PinFallThresholds());
+
+        void setThresholds(const PinFallThresholds& thresholds);
+        const PinFallThresholds& getThresholds() const { return mThresholds; }
+
+        // Quilles à classer ; leur position actuelle devient leur emplacement (quilles
+        // relevées). Les pointeurs doivent rester valides. Appelle begin().
+        void setPins(const btRigidBody* const* bodies, size_t count);
+        // Début d'un lancer : états précédents oubliés, puis classement immédiat
+        void begin();
+        // Classe toutes les quilles ; renvoie le nombre de quilles abattues (FALLEN ou OFF_DECK)
+        int update();
+
+        size_t getPinCount() const { return mBodies.size(); }
+        PinFallState getState(size_t index) const { return static_cast<PinFallState>(mStates[index]); }
+        int getKnockedDownCount() const { return mKnockedDownCount; }
+        // Bit i = quille i abattue (mêmes indices que setPins)
+        int getKnockedDownMask() const { return mKnockedDownMask; }
+        int countState(PinFallState state) const;
+
+        // Classement d'une seule quille, sans historique (quilles au repos)
+        static PinFallState classify(const btTransform& transform, const btVector3& spot,
+                                     const PinFallThresholds& thresholds = PinFallThresholds());
+        static bool isKnockedDown(PinFallState state) { return state >= PinFallState::FALLEN; }
+        static const char* getStateName(PinFallState state);
+};
+
+#endif // PIN_FALL_CLASSIFIER_H
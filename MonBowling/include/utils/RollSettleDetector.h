@@ -0,0 +1,79 @@
+#ifndef ROLL_SETTLE_DETECTOR_H
+#define ROLL_SETTLE_DETECTOR_H
+
+#include <vector>
+#include <OgreBullet.h>
+#include "../managers/PhysicsManager.h"
+
+// Détecte la fin d'un lancer : la boule et toutes les quilles sont au repos.
+//
+// Un corps est au repos s'il est endormi par Bullet (îlot ISLAND_SLEEPING), s'il est
+// sorti du jeu (tombé dans la fosse), ou si ses vitesses restent sous les seuils
+// pendant mQuietTime secondes simulées. Tant qu'un contact neuf apparaît sur un
+// corps suivi (une quille qui bascule, une autre qui la touche), le lancer continue.
+//
+// Le temps est le temps simulé de PhysicsManager : avec le pas fixe, le résultat ne dépend
+// ni de la fréquence d'affichage ni de la vitesse de simulation (jeu ou lots sans rendu) ;
+// avec le pas variable, le temps avance quand même des sous-pas réellement simulés.
+class RollSettleDetector {
+    private:
+        PhysicsManager* mPhysics;
+
+        // Corps suivis et temps passé sous les seuils de vitesse
+        std::vector<const btRigidBody*> mBodies;
+        std::vector<float> mQuietTimes;
+
+        bool mActive;
+        bool mSettled;
+        unsigned long mStartStep;
+        unsigned long mLastStep;
+        unsigned long mSettleStep;
+        double mStartTime;
+        double mLastTime;
+        double mSettleTime;
+        int mActiveContacts;
+        int mBodiesAtRest;
+
+        // Réglages
+        float mLinearThreshold;     // m/s
+        float mAngularThreshold;    // rad/s
+        float mQuietTime;           // secondes simulées sous les seuils
+        float mOutOfPlayHeight;     // en dessous : corps dans la fosse ou la gouttière basse
+        int mFreshContactSteps;     // âge (en pas) d'un point de contact considéré comme neuf
+
+        bool isTracked(const btCollisionObject* object) const;
+        // Points de contact neufs touchant un corps suivi encore en jeu
+        int countActiveContacts() const;
+
+    public:
+        // physics == nullptr : PhysicsManager::getInstance()
+        explicit RollSettleDetector(PhysicsManager* physics = nullptr);
+
+        // Corps à surveiller (boule et quilles) ; les pointeurs doivent rester valides
+        void track(const btRigidBody* body);
+        void clearBodies();
+
+        // Début du lancer (après BowlingBall::launch)
+        void start();
+        // À appeler après les pas physiques (chaque pas ou chaque frame) ; true une fois au repos
+        bool update();
+        void reset();
+
+        bool isActive() const { return mActive; }
+        bool isSettled() const { return mSettled; }
+        // Horodatage de la fin du lancer, relatif à start()
+        unsigned long getSettleStep() const { return mSettleStep - mStartStep; }
+        float getSettleTime() const;
+        // Temps simulé depuis start() (lancer en cours ou terminé)
+        float getElapsedTime() const;
+        int getActiveContactCount() const { return mActiveContacts; }
+        int getBodiesAtRest() const { return mBodiesAtRest; }
+        int getTrackedBodyCount() const { return static_cast<int>(mBodies.size()); }
+
+        void setVelocityThresholds(float linear, float angular);
+        void setQuietTime(float seconds) { mQuietTime = seconds; }
+        void setOutOfPlayHeight(float height) { mOutOfPlayHeight = height; }
+        void setFreshContactSteps(int steps) { mFreshContactSteps = steps; }
+};
+
+#endif // ROLL_SETTLE_DETECTOR_H
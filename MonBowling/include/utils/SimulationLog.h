@@ -0,0 +1,26 @@
+#ifndef SIMULATION_LOG_H
+#define SIMULATION_LOG_H
+
+#include <atomic>
+#include <string>
+
+// Messages de chaque lancer (boule, quilles, repos, score) : écrits par message(), qui ne
+// touche au LogManager que si enabled().
+//
+// Ogre::LogManager::logMessage prend le verrou global du LogManager avant de filtrer par
+// niveau : même un message écarté sérialise les pistes qui simulent en parallèle, et sa
+// chaîne est formatée pour rien. Le niveau du journal par défaut est relu par refresh(),
+// une fois par création de simulation ou de partie, jamais sur le chemin du pas.
+class SimulationLog {
+    private:
+        static std::atomic<bool> sEnabled;
+
+    public:
+        // true si le journal par défaut garde les messages LML_NORMAL (pas de LogManager : false)
+        static void refresh();
+        static bool enabled() { return sEnabled.load(std::memory_order_relaxed); }
+        // Ogre::LogManager::logMessage si enabled(), rien sinon
+        static void message(const std::string& text);
+};
+
+#endif // SIMULATION_LOG_H
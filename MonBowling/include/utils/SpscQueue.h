@@ -0,0 +1,60 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// File circulaire sans verrou pour un seul producteur et un seul consommateur.
+// Capacité fixe (puissance de 2) : aucune allocation après la construction ;
+// push échoue quand la file est pleine au lieu de bloquer le producteur.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue : capacité en puissance de 2");
+
+    private:
+        static constexpr size_t MASK = Capacity - 1;
+
+        std::array<T, Capacity> mBuffer;
+        // Indices croissants (modulo Capacity à l'accès) ; chacun sur sa ligne de cache
+        alignas(64) std::atomic<size_t> mHead;  // Écrit par le consommateur
+        alignas(64) std::atomic<size_t> mTail;  // Écrit par le producteur
+
+    public:
+        SpscQueue() : mHead(0), mTail(0) {}
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        // Producteur uniquement
+        bool push(const T& item) {
+            size_t tail = mTail.load(std::memory_order_relaxed);
+            if (tail - mHead.load(std::memory_order_acquire) == Capacity) {
+                return false;
+            }
+            mBuffer[tail & MASK] = item;
+            mTail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consommateur uniquement
+        bool pop(T& item) {
+            size_t head = mHead.load(std::memory_order_relaxed);
+            if (head == mTail.load(std::memory_order_acquire)) {
+                return false;
+            }
+            item = mBuffer[head & MASK];
+            mHead.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consommateur uniquement : vide la file sans lire les éléments
+        void clear() {
+            mHead.store(mTail.load(std::memory_order_acquire), std::memory_order_release);
+        }
+
+        // Approximatif si l'autre côté travaille en même temps
+        size_t size() const {
+            return mTail.load(std::memory_order_acquire) - mHead.load(std::memory_order_acquire);
+        }
+        bool empty() const { return size() == 0; }
+        static constexpr size_t capacity() { return Capacity; }
+};
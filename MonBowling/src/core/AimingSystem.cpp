@@ -1,11 +1,16 @@
 // Fichier : AimingSystem.cpp
 #include "../../include/core/AimingSystem.h"
+#include "../../include/core/TrajectoryPredictor.h"
+#include <OgreManualObject.h>
 #include <OgreMaterialManager.h>
 #include <OgreTechnique.h>
 #include <OgrePass.h>
 #include <OgreColourValue.h>
 #include <algorithm> // Pour std::max et std::min
 
+// Hauteur de la polyligne au-dessus du centre de la boule (reste visible sur la piste)
+static const float TRAJECTORY_LINE_OFFSET = 0.02f;
+
 AimingSystem::AimingSystem(Ogre::SceneManager* sceneMgr, Ogre::Camera* camera)
     : scene(sceneMgr),
       camera(camera),
@@ -25,11 +30,19 @@ AimingSystem::AimingSystem(Ogre::SceneManager* sceneMgr, Ogre::Camera* camera)
       mSpinEffect(0.0f),
       mMaxSpinRate(2.0f),      // vitesse de changement
       mSpinSensitivity(0.05f), // Sensibilité du contrôle de spin
-      mShowSpinPreview(true)   // Option pour afficher un preview de la trajectoire
+      mShowSpinPreview(true),  // Option pour afficher un preview de la trajectoire
+      mTrajectoryNode(nullptr),
+      mTrajectoryLine(nullptr),
+      mPreviewDirection(Ogre::Vector3::ZERO),
+      mPreviewPower(-1.0f),
+      mPreviewSpin(0.0f)
 {
 }
 
 AimingSystem::~AimingSystem(){
+    // Arrêt du thread de prédiction avant de détruire ce qu'il alimente
+    mTrajectoryPredictor.reset();
+
     // La destruction de l'overlay et des éléments est gérée par Ogre
     // si l'overlay est détruit.
     if (gameOverlay) {
@@ -47,11 +60,21 @@ AimingSystem::~AimingSystem(){
         scene->destroyEntity(arrowEntity);
         arrowEntity = nullptr;
     }
+    if (mTrajectoryNode) {
+        mTrajectoryNode->detachAllObjects();
+        scene->destroySceneNode(mTrajectoryNode);
+        mTrajectoryNode = nullptr;
+    }
+    if (mTrajectoryLine) {
+        scene->destroyManualObject(mTrajectoryLine);
+        mTrajectoryLine = nullptr;
+    }
 }
 
 void AimingSystem::initialize(){
     createAimingArrow();
     createOverlays(); 
+    createTrajectoryLine();
 
     // Initialisation de l'état
     resetAiming();
@@ -84,6 +107,25 @@ void AimingSystem::createAimingArrow(){
     }
 }
 
+void AimingSystem::enableTrajectoryPreview(const Ogre::Vector3& ballStart, const BowlingBall& ball,
+                                           const BowlingLane& lane, float tickRate) {
+    if (!mTrajectoryPredictor) {
+        mTrajectoryPredictor = std::make_unique<TrajectoryPredictor>();
+    }
+    mTrajectoryPredictor->start(ballStart, ball, lane, tickRate);
+    mPreviewPower = -1.0f; // Nouvelle demande à la prochaine mise à jour
+}
+
+void AimingSystem::createTrajectoryLine() {
+    mTrajectoryLine = scene->createManualObject("TrajectoryPreview");
+    mTrajectoryLine->setDynamic(true);
+    mTrajectoryLine->setCastShadows(false);
+
+    mTrajectoryNode = scene->getRootSceneNode()->createChildSceneNode("TrajectoryPreviewNode");
+    mTrajectoryNode->attachObject(mTrajectoryLine);
+    mTrajectoryNode->setVisible(false);
+}
+
 void AimingSystem::createOverlays(){
     Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
     gameOverlay = overlayManager.create("GameOverlay");
@@ -248,19 +290,49 @@ void AimingSystem::updateSpinIndicatorDisplay() {
 }
 
 void AimingSystem::updateTrajectoryPreview() {
-    // Cette méthode créerait une ligne pointillée montrant la trajectoire prévue
-    // en tenant compte du spin (optionnel, pour une expérience utilisateur avancée)
-    
-    if (!mShowSpinPreview || !arrowNode) return;
-    
-    // Calculer la courbure approximative basée sur le spin
-    float curvature = mSpinEffect * 0.2f; // Facteur de courbure
-    
-    // Créer ou mettre à jour une ligne de trajectoire courbée
-    // (Implémentation dépendante de votre système de rendu)
-    Ogre::LogManager::getSingleton().logMessage(
-        "Trajectory preview: Spin=" + Ogre::StringConverter::toString(mSpinEffect) + 
-        " Curvature=" + Ogre::StringConverter::toString(curvature));
+    if (!mShowSpinPreview || !mTrajectoryPredictor) return;
+
+    // Nouvelle simulation seulement quand les valeurs du lancer changent ; celle en cours est abandonnée
+    Ogre::Vector3 direction = mAimingDirection.normalisedCopy();
+    float power = getPower();
+    float spin = getSpinEffect();
+    if (direction != mPreviewDirection || power != mPreviewPower || spin != mPreviewSpin) {
+        mPreviewDirection = direction;
+        mPreviewPower = power;
+        mPreviewSpin = spin;
+        mTrajectoryPredictor->request(direction, power, spin);
+    }
+
+    // Trajectoire terminée par le thread : reconstruite ici, sinon l'ancienne reste affichée
+    if (mTrajectoryPredictor->poll(mTrajectoryPath)) {
+        rebuildTrajectoryLine();
+    }
+}
+
+void AimingSystem::rebuildTrajectoryLine() {
+    if (!mTrajectoryLine) return;
+
+    mTrajectoryLine->clear();
+    if (mTrajectoryPath.size() < 2) {
+        mTrajectoryNode->setVisible(false);
+        return;
+    }
+    mTrajectoryLine->begin("BaseWhiteNoLighting", Ogre::RenderOperation::OT_LINE_STRIP);
+    for (const Ogre::Vector3& point : mTrajectoryPath) {
+        mTrajectoryLine->position(point + Ogre::Vector3(0.0f, TRAJECTORY_LINE_OFFSET, 0.0f));
+    }
+    mTrajectoryLine->end();
+    mTrajectoryNode->setVisible(true);
+}
+
+void AimingSystem::hideTrajectoryPreview() {
+    if (mTrajectoryPredictor) {
+        mTrajectoryPredictor->cancel();
+    }
+    mPreviewPower = -1.0f;
+    if (mTrajectoryNode) {
+        mTrajectoryNode->setVisible(false);
+    }
 }
 
 // --- Gestion des entrées --- 
@@ -351,6 +423,7 @@ void AimingSystem::startPowerPhase() {
     // Réinitialiser les valeurs au début de la phase POWER
     mPowerValue = MIN_POWER;
     mSpinEffect = 0.0f;
+    mPreviewPower = -1.0f; // Première trajectoire demandée à la prochaine mise à jour
     updatePowerBarDisplay();
     updateSpinIndicatorDisplay();
     Ogre::LogManager::getSingleton().logMessage("AimingSystem: Power Phase Started.");
@@ -368,6 +441,7 @@ void AimingSystem::resetAiming(){
     if (arrowNode) arrowNode->setVisible(false);
     if (powerBarContainer) powerBarContainer->hide();
     if (mSpinContainer) mSpinContainer->hide();
+    hideTrajectoryPreview();
 
     // Mettre à jour l'affichage (même si caché, pour la cohérence)
     updatePowerBarDisplay();
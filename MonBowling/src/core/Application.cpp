@@ -4,6 +4,11 @@
 #include "../../include/core/GameManager.h"
 #include "../../include/managers/AudioManager.h" 
 
+// Fichier des mesures physiques par frame (F4), dans le dossier courant
+static const char* const PHYSICS_DUMP_FILE = "physics_frames.csv";
+// Motif d'huilage de la piste (friction boule/piste par planche et distance)
+static const char* const OIL_PATTERN_FILE = "../media/patterns/house_shot.oil";
+
 Application::Application()
     : OgreBites::ApplicationContext("Crazy Bowling !!"),
       scene(nullptr),
@@ -73,6 +78,9 @@ void Application::setup(){
     // Initialisation du gestionnaire de jeu (qui initialisera les autres systèmes)
     GameManager::getInstance()->initialize(scene, camera, ball.get(), lane.get());
 
+    physicsStatsOverlay = std::make_unique<PhysicsStatsOverlay>();
+    physicsStatsOverlay->initialize();
+
     // La position/orientation initiale de la caméra est maintenant gérée par CameraFollower/GameManager
     // lors de l'initialisation ou du reset.
 }
@@ -99,6 +107,8 @@ void Application::createScene(){
 
     lane = std::make_unique<BowlingLane>(scene);
     lane->create(Ogre::Vector3(0.0f, 0.0f, 0.0f));
+    // Sans le fichier, la piste garde sa friction uniforme (avertissement dans le log)
+    lane->loadOilPattern(OIL_PATTERN_FILE);
 
     ball = std::make_unique<BowlingBall>(scene, "BowlingBall.mesh");
     Ogre::Vector3 ballPosition(0.0f, ball->getRadius() + 0.01f, 7.0f);
@@ -118,11 +128,15 @@ bool Application::frameRenderingQueued(const Ogre::FrameEvent& evt){
     // Mise à jour de l'AudioManager (important pour FMOD)
     AudioManager::getInstance()->update();
 
-    // Mise à jour du gestionnaire de jeu
+    // Mise à jour de la simulation physique (pas fixes + calcul du facteur d'interpolation)
+    PhysicsManager::getInstance()->update(evt.timeSinceLastFrame);
+
+    // Mise à jour du gestionnaire de jeu : les objets lisent l'interpolation du pas qui vient d'être fait
     GameManager::getInstance()->update(evt.timeSinceLastFrame);
 
-    // Mise à jour de la simulation physique
-    PhysicsManager::getInstance()->update(evt.timeSinceLastFrame);
+    if (physicsStatsOverlay) {
+        physicsStatsOverlay->update(evt.timeSinceLastFrame);
+    }
 
     // Les mises à jour de la boule et de la piste sont maintenant gérées par GameManager ou PhysicsManager
     // if (ball) {
@@ -163,6 +177,25 @@ bool Application::keyPressed(const OgreBites::KeyboardEvent& evt){
         return true;
     }
 
+    // Mesures de la physique
+    if (evt.keysym.sym == OgreBites::SDLK_F3 && physicsStatsOverlay) {
+        physicsStatsOverlay->toggle();
+        return true;
+    }
+    if (evt.keysym.sym == OgreBites::SDLK_F4) {
+        PhysicsProfiler& profiler = PhysicsManager::getInstance()->getProfiler();
+        if (profiler.isDumping()) {
+            profiler.stopDump();
+            if (!physicsStatsOverlay || !physicsStatsOverlay->isVisible()) {
+                profiler.setEnabled(false);
+            }
+            Ogre::LogManager::getSingleton().logMessage("Mesures physiques : fin de l'enregistrement.");
+        } else if (profiler.startDump(PHYSICS_DUMP_FILE, PhysicsProfiler::DUMP_CSV)) {
+            Ogre::LogManager::getSingleton().logMessage(std::string("Mesures physiques : enregistrement dans ") + PHYSICS_DUMP_FILE);
+        }
+        return true;
+    }
+
     // Transmission de l'événement au gestionnaire de jeu
     if (GameManager::getInstance()->handleKeyPress(evt)) {
         return true;
@@ -209,6 +242,8 @@ void Application::windowClosed(Ogre::RenderWindow* rw) {
 // Surcharge pour la fermeture de l'application
 void Application::shutdown() {
     AudioManager::getInstance()->shutdown();
+    // L'overlay doit disparaître avant le système d'overlays d'Ogre
+    physicsStatsOverlay.reset();
     OgreBites::ApplicationContext::shutdown();
 }
 
@@ -0,0 +1,230 @@
+#include "../../include/core/BowlingSimulation.h"
+#include "../../include/core/GameReplay.h"
+#include "../../include/managers/PhysicsManager.h"
+#include "../../include/states/ScoreManager.h"
+#include "../../include/utils/PinDetector.h"
+#include "../../include/utils/SimulationLog.h"
+
+BowlingSimulation::BowlingSimulation(PhysicsManager* physics, ScoreManager* scores)
+    : physics(physics ? physics : PhysicsManager::getInstance()),
+      scores(scores ? scores : ScoreManager::getInstance()),
+      settleDetector(this->physics),
+      recorder(nullptr),
+      maxRollTime(20.0f),
+      lastRollTime(0.0f),
+      lastRollSteps(0),
+      throwing(false),
+      throwTime(0.0f),
+      throwSteps(0),
+      throwDirection(Ogre::Vector3::ZERO),
+      throwPower(0.0f),
+      throwSpin(0.0f)
+{}
+
+BowlingSimulation::~BowlingSimulation() {
+    // La boule et les quilles se retirent du monde physique avant lui
+    ball.reset();
+    lane.reset();
+}
+
+void BowlingSimulation::initialize(const GameReplay* world) {
+    // Niveau du journal relu ici, pas à chaque lancer (outils : avertissements seulement)
+    SimulationLog::refresh();
+
+    // Pas de SceneManager : aucun debugger visuel, aucun nœud de scène
+    physics->initialize(nullptr);
+
+    // Corps créés dans l'ordre du jeu : sol, piste, quilles, puis boule
+    lane = std::make_unique<BowlingLane>(nullptr, physics);
+    ball = std::make_unique<BowlingBall>(nullptr, "ball.mesh", physics);
+    if (world && !world->applyWorld(*lane, *ball, *physics)) {
+        Ogre::LogManager::getSingleton().logError("BowlingSimulation::initialize - forme enregistrée invalide");
+    }
+    lane->create(LANE_ORIGIN);
+    ball->create(Ogre::Vector3(0.0f, ball->getRadius() + 0.01f, BALL_START_Z));
+
+    settleDetector.clearBodies();
+    settleDetector.track(ball->getBallBody());
+    for (const auto& pin : lane->getPins()) {
+        settleDetector.track(pin->getPinBody());
+    }
+
+    // Pas de resetGame() ici : le score peut être le singleton, à ne pas toucher depuis plusieurs threads
+    frameLogic.reset();
+    if (!world) {
+        resetRack();
+    }
+}
+
+void BowlingSimulation::resetGame() {
+    frameLogic.reset();
+    scores->resetScore();
+    resetRack();
+}
+
+void BowlingSimulation::resetRack() {
+    throwing = false;
+    if (ball) { ball->reset(); }
+    if (lane) { lane->resetPins(); }
+}
+
+int BowlingSimulation::throwBall(const Ogre::Vector3& direction, float power, float spin) {
+    if (!ball || !lane) {
+        return 0;
+    }
+    startThrow(direction, power, spin);
+    while (!stepThrow()) {}
+    return lane->getKnockedDownMask();
+}
+
+void BowlingSimulation::startThrow(const Ogre::Vector3& direction, float power, float spin) {
+    if (!ball || !lane) {
+        return;
+    }
+    ball->launch(direction, power, spin);
+    settleDetector.start();
+    throwing = true;
+    throwTime = 0.0f;
+    throwSteps = 0;
+    throwDirection = direction;
+    throwPower = power;
+    throwSpin = spin;
+}
+
+bool BowlingSimulation::stepThrow() {
+    if (!throwing) {
+        return true;
+    }
+    const float dt = physics->getFixedTimeStep();
+    physics->step();
+    ball->update(dt);
+    throwTime += dt;
+    ++throwSteps;
+
+    // Le lancer dure jusqu'au repos de la boule et des quilles, sans délai fixe
+    if (settleDetector.update() || throwTime >= maxRollTime) {
+        lastRollTime = settleDetector.isSettled() ? settleDetector.getSettleTime() : throwTime;
+        lastRollSteps = throwSteps;
+        throwing = false;
+        return true;
+    }
+    return false;
+}
+
+RollResult BowlingSimulation::roll(const Ogre::Vector3& direction, float power, float spin) {
+    RollResult result;
+    if (!ball || !lane || frameLogic.isGameOver()) {
+        result.gameOver = frameLogic.isGameOver();
+        return result;
+    }
+    throwBall(direction, power, spin);
+    return finishRoll();
+}
+
+RollResult BowlingSimulation::finishRoll() {
+    RollResult result;
+    if (!ball || !lane || frameLogic.isGameOver()) {
+        result.gameOver = frameLogic.isGameOver();
+        return result;
+    }
+
+    int frame = frameLogic.getCurrentFrame();
+    int rollInFrame = frameLogic.getCurrentRollInFrame();
+    int knockedDownMask = lane->getKnockedDownMask();
+    result = frameLogic.recordRoll(lane->countKnockedDownPins());
+    scores->recordRoll(result.pinsThisRoll, knockedDownMask);
+
+    if (recorder) {
+        recorder->addRoll(frame, rollInFrame, throwDirection, throwPower, throwSpin, lastRollSteps,
+                          result.pinsThisRoll, *lane);
+        if (result.gameOver) {
+            recorder->setFinalScore(getScore());
+        }
+    }
+
+    ball->reset();
+    if (result.resetRack) {
+        lane->resetPins();
+    }
+    return result;
+}
+
+int BowlingSimulation::replayEvents(const GameReplay& recorded, GameReplay& replayed) {
+    if (!ball || !lane) {
+        return -1;
+    }
+
+    // Mêmes objets que GameManager, mis à jour aux mêmes moments
+    PinDetector detector(physics);
+    detector.initialize(lane->getPins(), ball->getBallBody());
+    PhysicsSnapshot retrySnapshot;
+    const float dt = physics->getFixedTimeStep();
+    // Compté ici : la restauration d'un instantané ramène aussi le compteur du monde en arrière
+    int steps = 0;
+
+    Ogre::Vector3 direction = Ogre::Vector3::ZERO;
+    float power = 0.0f;
+    float spin = 0.0f;
+    for (const GameReplay::Event& event : recorded.events) {
+        switch (event.type) {
+            case GameReplay::EventType::FRAMES:
+                // Frame du jeu : pas physiques, puis boule et détecteur (le temps de rendu n'y sert pas)
+                for (int i = 0; i < event.count; ++i) {
+                    physics->step(event.steps);
+                    ball->update(dt);
+                    detector.update(dt);
+                }
+                steps += event.count * event.steps;
+                break;
+            case GameReplay::EventType::LAUNCH:
+                direction = event.direction;
+                power = event.power;
+                spin = event.spin;
+                ball->launch(direction, power, spin);
+                detector.startDetection();
+                break;
+            case GameReplay::EventType::CAPTURE:
+                physics->captureSnapshot(retrySnapshot);
+                break;
+            case GameReplay::EventType::RETRY:
+                if (!retrySnapshot.isValid() || !physics->restoreSnapshot(retrySnapshot)) {
+                    Ogre::LogManager::getSingleton().logError("BowlingSimulation::replayEvents - reprise sans instantané");
+                    return -1;
+                }
+                ball->setRolling(true);
+                detector.startDetection();
+                break;
+            case GameReplay::EventType::SCORE: {
+                int frame = frameLogic.getCurrentFrame();
+                int rollInFrame = frameLogic.getCurrentRollInFrame();
+                RollResult result = frameLogic.recordRoll(detector.getKnockedDownPinCount());
+                scores->recordRoll(result.pinsThisRoll, detector.getClassifier().getKnockedDownMask());
+                replayed.addRoll(frame, rollInFrame, direction, power, spin,
+                                 static_cast<int>(detector.getSettleDetector().getSettleStep()),
+                                 result.pinsThisRoll, *lane);
+                if (result.gameOver) {
+                    replayed.setFinalScore(getScore());
+                }
+                break;
+            }
+            case GameReplay::EventType::RESET_PINS:
+                lane->resetPins();
+                break;
+            case GameReplay::EventType::RESET_BALL:
+                ball->reset();
+                retrySnapshot.invalidate();
+                detector.reset();
+                break;
+            case GameReplay::EventType::NEW_GAME:
+                frameLogic.reset();
+                scores->resetScore();
+                replayed.newGame();
+                break;
+        }
+    }
+    return steps;
+}
+
+int BowlingSimulation::getScore() const {
+    return scores->getCurrentScore();
+}
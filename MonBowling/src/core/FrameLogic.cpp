@@ -0,0 +1,80 @@
+#include "../../include/core/FrameLogic.h"
+
+FrameLogic::FrameLogic() {
+    reset();
+}
+
+void FrameLogic::reset() {
+    currentFrame = 1;
+    currentRollInFrame = 1;
+    pinsDownInRack = 0;
+    firstBallInRack = true;
+    tenthFrameBonus = false;
+    gameOver = false;
+}
+
+RollResult FrameLogic::recordRoll(int totalPinsDownSinceReset) {
+    RollResult result;
+    if (gameOver) {
+        result.gameOver = true;
+        return result;
+    }
+
+    int pinsThisRoll = totalPinsDownSinceReset - pinsDownInRack;
+    if (pinsThisRoll < 0) pinsThisRoll = 0;
+    result.pinsThisRoll = pinsThisRoll;
+
+    // Toutes les quilles du jeu actuel sont tombées. Strike au premier lancer sur un jeu
+    // complet, spare au second (même après une rigole : 0 puis 10 est un spare)
+    bool rackCleared = (pinsDownInRack + pinsThisRoll) >= 10;
+    result.strike = rackCleared && firstBallInRack;
+    result.spare = rackCleared && !firstBallInRack;
+
+    // Cas : Frames 1 à 9
+    if (currentFrame < MAX_FRAMES) {
+        if (result.strike || currentRollInFrame == 2) {
+            result.frameOver = true;
+        } else {
+            pinsDownInRack += pinsThisRoll;
+            firstBallInRack = false;
+            currentRollInFrame = 2;
+        }
+    }
+    // Cas spécial : 10ème frame
+    else {
+        if (rackCleared) {
+            // Strike ou spare : on relève les quilles pour le lancer suivant
+            tenthFrameBonus = true;
+            pinsDownInRack = 0;
+            firstBallInRack = true;
+            result.resetRack = true;
+        } else {
+            pinsDownInRack += pinsThisRoll;
+            firstBallInRack = false;
+        }
+
+        bool lastRoll = (currentRollInFrame == 3) ||
+                        (currentRollInFrame == 2 && !tenthFrameBonus);
+        if (lastRoll) {
+            result.frameOver = true;
+            result.resetRack = false;
+        } else {
+            currentRollInFrame++;
+        }
+    }
+
+    if (result.frameOver) {
+        if (currentFrame >= MAX_FRAMES) {
+            gameOver = true;
+            result.gameOver = true;
+        } else {
+            currentFrame++;
+            currentRollInFrame = 1;
+            pinsDownInRack = 0;
+            firstBallInRack = true;
+            result.resetRack = true;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,325 @@
+#include "../../include/core/GameHistory.h"
+#include <OgreLogManager.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace fs = std::filesystem;
+
+// Version du format des colonnes : à incrémenter si un enregistrement change
+static const uint32_t HISTORY_VERSION = 1;
+static const size_t HEADER_SIZE = 64;
+// Parties allouées à la création, puis capacité doublée à chaque agrandissement
+static const size_t INITIAL_CAPACITY = 1024;
+
+struct ColumnHeader {
+    char magic[4];              // "MBGH"
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t column;
+    uint64_t count;             // Parties écrites dans cette colonne
+};
+
+struct ColumnInfo {
+    const char* file;
+    uint32_t recordSize;
+};
+
+static const ColumnInfo COLUMNS[GameHistory::COLUMN_COUNT] = {
+    {"player.col", sizeof(uint32_t)},
+    {"date.col", sizeof(int64_t)},
+    {"lane.col", sizeof(uint16_t)},
+    {"rolls.col", sizeof(PackedGame)},
+    {"frames.col", sizeof(uint16_t) * ScoreRules::FRAME_COUNT},
+    {"score.col", sizeof(uint16_t)},
+    {"launch.col", sizeof(float) * 3 * ScoreRules::MAX_ROLLS},
+    {"leaves.col", sizeof(uint16_t) * ScoreRules::FRAME_COUNT}
+};
+static const char* const PLAYERS_FILE = "players.txt";
+
+GameHistory::GameHistory()
+    : mCount(0)
+{}
+
+GameHistory::~GameHistory() {
+    close();
+}
+
+bool GameHistory::open(const std::string& directory) {
+    close();
+    std::error_code error;
+    fs::create_directories(directory, error);
+
+    mDirectory = directory;
+    for (int c = 0; c < COLUMN_COUNT; ++c) {
+        if (!openColumn(static_cast<Column>(c))) {
+            Ogre::LogManager::getSingleton().logError("GameHistory::open - colonne illisible : " +
+                (fs::path(directory) / COLUMNS[c].file).string());
+            close();
+            return false;
+        }
+    }
+
+    // Une partie n'est complète que si toutes ses colonnes ont été écrites
+    mCount = std::numeric_limits<size_t>::max();
+    for (int c = 0; c < COLUMN_COUNT; ++c) {
+        const ColumnHeader* header = reinterpret_cast<const ColumnHeader*>(mColumns[c].data());
+        mCount = std::min(mCount, static_cast<size_t>(header->count));
+    }
+
+    std::ifstream players((fs::path(directory) / PLAYERS_FILE).string());
+    std::string name;
+    while (std::getline(players, name)) {
+        mPlayerIds[name] = static_cast<int>(mPlayers.size());
+        mPlayers.push_back(name);
+    }
+
+    Ogre::LogManager::getSingleton().logMessage("GameHistory::open - " + std::to_string(mCount) +
+        " parties dans " + directory);
+    return true;
+}
+
+bool GameHistory::openColumn(Column column) {
+    MappedFile& file = mColumns[column];
+    const ColumnInfo& info = COLUMNS[column];
+    if (!file.open((fs::path(mDirectory) / info.file).string(), HEADER_SIZE + INITIAL_CAPACITY * info.recordSize)) {
+        return false;
+    }
+
+    ColumnHeader* header = reinterpret_cast<ColumnHeader*>(file.data());
+    // Fichier neuf : rempli de zéros par l'agrandissement
+    if (header->magic[0] == 0 && header->count == 0) {
+        std::memcpy(header->magic, "MBGH", 4);
+        header->version = HISTORY_VERSION;
+        header->recordSize = info.recordSize;
+        header->column = static_cast<uint32_t>(column);
+    }
+    return std::memcmp(header->magic, "MBGH", 4) == 0 && header->version == HISTORY_VERSION &&
+           header->recordSize == info.recordSize && header->column == static_cast<uint32_t>(column) &&
+           file.size() >= HEADER_SIZE + header->count * info.recordSize;
+}
+
+void GameHistory::close() {
+    for (auto& file : mColumns) {
+        file.close();
+    }
+    mDirectory.clear();
+    mCount = 0;
+    mPlayers.clear();
+    mPlayerIds.clear();
+}
+
+bool GameHistory::reserve(size_t count) {
+    for (int c = 0; c < COLUMN_COUNT; ++c) {
+        MappedFile& file = mColumns[c];
+        size_t capacity = (file.size() - HEADER_SIZE) / COLUMNS[c].recordSize;
+        if (count <= capacity) {
+            continue;
+        }
+        size_t newCapacity = std::max(count, capacity * 2);
+        if (!file.resize(HEADER_SIZE + newCapacity * COLUMNS[c].recordSize)) {
+            // La colonne a été fermée par l'échec : l'historique entier est fermé, les
+            // parties déjà écrites restent intactes sur le disque (compteurs inchangés)
+            Ogre::LogManager::getSingleton().logError("GameHistory::reserve - agrandissement impossible, historique fermé : " +
+                file.getPath());
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+T* GameHistory::column(Column column) {
+    return reinterpret_cast<T*>(mColumns[column].data() + HEADER_SIZE);
+}
+
+template <typename T>
+const T* GameHistory::column(Column column) const {
+    return reinterpret_cast<const T*>(mColumns[column].data() + HEADER_SIZE);
+}
+
+void GameHistory::setColumnCount(Column column, size_t count) {
+    reinterpret_cast<ColumnHeader*>(mColumns[column].data())->count = count;
+}
+
+int GameHistory::addPlayer(const std::string& name) {
+    auto found = mPlayerIds.find(name);
+    if (found != mPlayerIds.end()) {
+        return found->second;
+    }
+    std::ofstream players((fs::path(mDirectory) / PLAYERS_FILE).string(), std::ios::app);
+    players << name << "\n";
+    int id = static_cast<int>(mPlayers.size());
+    mPlayerIds[name] = id;
+    mPlayers.push_back(name);
+    return id;
+}
+
+bool GameHistory::append(const Record& record) {
+    if (!isOpen()) {
+        return false;
+    }
+    PackedGame rolls;
+    if (!ScoreRules::pack(record.rolls.data(), record.rollCount, rolls)) {
+        Ogre::LogManager::getSingleton().logWarning("GameHistory::append - lancers invalides, partie ignorée");
+        return false;
+    }
+    if (!reserve(mCount + 1)) {
+        return false;
+    }
+
+    // Noms de joueurs sans retour à la ligne (une ligne par joueur dans players.txt)
+    std::string player = record.player;
+    std::replace(player.begin(), player.end(), '\n', ' ');
+
+    const size_t row = mCount;
+    column<uint32_t>(PLAYER)[row] = static_cast<uint32_t>(addPlayer(player));
+    column<int64_t>(DATE)[row] = record.date;
+    column<uint16_t>(LANE)[row] = static_cast<uint16_t>(record.lane);
+    column<PackedGame>(ROLLS)[row] = rolls;
+    column<uint16_t>(SCORE)[row] = static_cast<uint16_t>(record.finalScore);
+    uint16_t* frameScores = column<uint16_t>(FRAME_SCORES) + row * ScoreRules::FRAME_COUNT;
+    uint16_t* leaves = column<uint16_t>(LEAVES) + row * ScoreRules::FRAME_COUNT;
+    for (int frame = 0; frame < ScoreRules::FRAME_COUNT; ++frame) {
+        frameScores[frame] = static_cast<uint16_t>(record.frameScores[frame]);
+        leaves[frame] = record.leaves[frame];
+    }
+    float* launches = column<float>(LAUNCHES) + row * 3 * ScoreRules::MAX_ROLLS;
+    for (int roll = 0; roll < ScoreRules::MAX_ROLLS; ++roll) {
+        launches[3 * roll] = record.launches[roll].aim;
+        launches[3 * roll + 1] = record.launches[roll].power;
+        launches[3 * roll + 2] = record.launches[roll].spin;
+    }
+
+    // Compteurs en dernier : une partie à moitié écrite n'est jamais lue
+    for (int c = 0; c < COLUMN_COUNT; ++c) {
+        setColumnCount(static_cast<Column>(c), row + 1);
+    }
+    ++mCount;
+    return true;
+}
+
+void GameHistory::flush() {
+    for (auto& file : mColumns) {
+        file.flush();
+    }
+}
+
+int GameHistory::findPlayer(const std::string& name) const {
+    auto found = mPlayerIds.find(name);
+    return found != mPlayerIds.end() ? found->second : -1;
+}
+
+bool GameHistory::getRecord(size_t row, Record& record) const {
+    if (row >= mCount) {
+        return false;
+    }
+    uint32_t player = column<uint32_t>(PLAYER)[row];
+    record.player = player < mPlayers.size() ? mPlayers[player] : std::string();
+    record.date = column<int64_t>(DATE)[row];
+    record.lane = column<uint16_t>(LANE)[row];
+    record.rolls.fill(0);
+    record.rollCount = ScoreRules::unpack(column<PackedGame>(ROLLS)[row], record.rolls.data());
+    record.finalScore = column<uint16_t>(SCORE)[row];
+    const uint16_t* frameScores = column<uint16_t>(FRAME_SCORES) + row * ScoreRules::FRAME_COUNT;
+    const uint16_t* leaves = column<uint16_t>(LEAVES) + row * ScoreRules::FRAME_COUNT;
+    for (int frame = 0; frame < ScoreRules::FRAME_COUNT; ++frame) {
+        record.frameScores[frame] = frameScores[frame];
+        record.leaves[frame] = leaves[frame];
+    }
+    const float* launches = column<float>(LAUNCHES) + row * 3 * ScoreRules::MAX_ROLLS;
+    for (int roll = 0; roll < ScoreRules::MAX_ROLLS; ++roll) {
+        record.launches[roll] = {launches[3 * roll], launches[3 * roll + 1], launches[3 * roll + 2]};
+    }
+    return true;
+}
+
+// --- Requêtes : parcours des seules colonnes utiles ---
+
+template <typename Visit>
+void GameHistory::forEach(const Filter& filter, Visit visit) const {
+    const uint32_t* players = column<uint32_t>(PLAYER);
+    const uint16_t* lanes = column<uint16_t>(LANE);
+    const int64_t* dates = column<int64_t>(DATE);
+    const bool byPlayer = filter.player >= 0;
+    const bool byLane = filter.lane >= 0;
+    const bool byDate = filter.from >= 0 || filter.to >= 0;
+    const int64_t to = filter.to >= 0 ? filter.to : std::numeric_limits<int64_t>::max();
+
+    for (size_t row = 0; row < mCount; ++row) {
+        if ((byPlayer && players[row] != static_cast<uint32_t>(filter.player)) ||
+            (byLane && lanes[row] != filter.lane) ||
+            (byDate && (dates[row] < filter.from || dates[row] > to))) {
+            continue;
+        }
+        visit(row);
+    }
+}
+
+void GameHistory::accumulate(Summary& summary, int64_t& scoreSum, int score, const PackedGame& rolls) {
+    if (summary.games == 0 || score > summary.highScore) summary.highScore = score;
+    if (summary.games == 0 || score < summary.lowScore) summary.lowScore = score;
+    ++summary.games;
+    scoreSum += score;
+    ScoreRules::countMarks(rolls, summary.marks);
+}
+
+GameHistory::Summary GameHistory::summarize(const Filter& filter) const {
+    Summary summary;
+    if (!isOpen()) {
+        return summary;
+    }
+    const uint16_t* scores = column<uint16_t>(SCORE);
+    const PackedGame* rolls = column<PackedGame>(ROLLS);
+    int64_t scoreSum = 0;
+    forEach(filter, [&](size_t row) {
+        accumulate(summary, scoreSum, scores[row], rolls[row]);
+    });
+    summary.averageScore = summary.games ? static_cast<double>(scoreSum) / summary.games : 0.0;
+    return summary;
+}
+
+std::vector<GameHistory::LaneSummary> GameHistory::summarizeLanes(const Filter& filter) const {
+    std::vector<LaneSummary> result;
+    if (!isOpen()) {
+        return result;
+    }
+    const uint16_t* lanes = column<uint16_t>(LANE);
+    const uint16_t* scores = column<uint16_t>(SCORE);
+    const PackedGame* rolls = column<PackedGame>(ROLLS);
+    // Numéros de piste petits : indexés directement
+    std::vector<std::pair<Summary, int64_t>> byLane;
+    forEach(filter, [&](size_t row) {
+        if (lanes[row] >= byLane.size()) {
+            byLane.resize(lanes[row] + 1);
+        }
+        auto& entry = byLane[lanes[row]];
+        accumulate(entry.first, entry.second, scores[row], rolls[row]);
+    });
+
+    for (size_t lane = 0; lane < byLane.size(); ++lane) {
+        Summary& summary = byLane[lane].first;
+        if (summary.games > 0) {
+            summary.averageScore = static_cast<double>(byLane[lane].second) / summary.games;
+            result.push_back({static_cast<int>(lane), summary});
+        }
+    }
+    return result;
+}
+
+void GameHistory::countLeaves(LeaveCounts& counts, const Filter& filter) const {
+    counts.fill(0);
+    if (!isOpen()) {
+        return;
+    }
+    const uint16_t* leaves = column<uint16_t>(LEAVES);
+    forEach(filter, [&](size_t row) {
+        const uint16_t* frames = leaves + row * ScoreRules::FRAME_COUNT;
+        for (int frame = 0; frame < ScoreRules::FRAME_COUNT; ++frame) {
+            ++counts[frames[frame] & 0x3FF];
+        }
+    });
+}
@@ -1,11 +1,39 @@
 #include "../../include/core/GameManager.h"
 #include "../../include/managers/AudioManager.h" 
+#include "../../include/managers/PhysicsManager.h"
 #include "../../include/states/ScoreManager.h" 
+#include "../../include/utils/SimulationLog.h"
 #include <OgreLogManager.h>
 #include <OgreStringConverter.h>
-
-// Constantes
-const int MAX_FRAMES = 10;
+#include <algorithm>
+#include <ctime>
+
+// Son joué pour chaque type de choc : impulsion minimale audible, impulsion du volume maximal.
+// nullptr : pas de son (la boule qui retombe sur la piste, aucun son de gouttière chargé).
+struct ImpactSound {
+    const char* sound;
+    float minImpulse;
+    float fullVolumeImpulse;
+};
+static const ImpactSound IMPACT_SOUNDS[static_cast<int>(ImpactType::COUNT)] = {
+    {"collision", 2.0f, 20.0f},     // BALL_PIN
+    {"collision", 1.5f, 8.0f},      // PIN_PIN
+    {"collision", 2.0f, 10.0f},     // PIN_LANE
+    {nullptr, 0.0f, 1.0f},          // BALL_LANE
+    {nullptr, 0.0f, 1.0f}           // BALL_GUTTER
+};
+
+// Enregistrement de la dernière partie terminée : monde, journal de la session, entrées et
+// résultats de chaque lancer (rapports de bug, historique), rejoué sans rendu par
+// BowlingReplay (voir tools/ReplayGames.cpp)
+static const char* const REPLAY_FILE = "last_game.replay";
+// Historique des parties terminées (statistiques avec BowlingHistory)
+static const char* const HISTORY_DIRECTORY = "history";
+static const char* const PLAYER_NAME = "Joueur 1";
+static const int LANE_NUMBER = 1;
+
+// Distance boule-quille (centres, dans le plan XZ) à laquelle l'instantané de reprise est pris
+static const float RETRY_CAPTURE_DISTANCE = 1.5f;
 
 // Initialisation du Singleton
 GameManager* GameManager::instance = nullptr;
@@ -18,15 +46,16 @@ GameManager* GameManager::getInstance() {
 }
 
 GameManager::GameManager()
-    : gameState(GameState::AIMING),
+    : stateMachine(GameState::AIMING),
       sceneMgr(nullptr),
       camera(nullptr),
       ball(nullptr),
       lane(nullptr),
-      currentFrame(1),
-      currentRollInFrame(1),
-      pinsKnockedFirstRoll(0)
+      launchDirection(Ogre::Vector3::ZERO),
+      launchPower(0.0f),
+      launchSpin(0.0f)
 {
+    stateMachine.setHandler(this);
 }
 
 GameManager::~GameManager() {}
@@ -34,6 +63,8 @@ GameManager::~GameManager() {}
 
 void GameManager::initialize(Ogre::SceneManager* sceneMgr, Ogre::Camera* camera,
                             BowlingBall* ball, BowlingLane* lane) {
+    // Messages de chaque lancer selon le niveau du journal (voir SimulationLog)
+    SimulationLog::refresh();
 
     this->sceneMgr = sceneMgr; // Correct : assigne le paramètre au membre sceneMgr
     this->camera = camera;     // Correct : assigne le paramètre au membre camera
@@ -43,10 +74,15 @@ void GameManager::initialize(Ogre::SceneManager* sceneMgr, Ogre::Camera* camera,
     // Initialisation des systèmes qui dépendent de ces pointeurs
     aimingSystem = std::make_unique<AimingSystem>(this->sceneMgr, this->camera);
     aimingSystem->initialize();
+    if (this->ball && this->lane) {
+        // Lancer fantôme sur une copie de la piste du jeu, depuis la position de départ de la boule
+        aimingSystem->enableTrajectoryPreview(this->ball->getPosition(), *this->ball, *this->lane,
+            PhysicsManager::getInstance()->getTickRate());
+    }
 
     pinDetector = std::make_unique<PinDetector>();
     if (this->lane) { // Utiliser this->lane pour la vérification
-        pinDetector->initialize(this->lane->getPins());
+        pinDetector->initialize(this->lane->getPins(), this->ball ? this->ball->getBallBody() : nullptr);
     } else {
          Ogre::LogManager::getSingleton().logError("ERREUR: BowlingLane non initialisé avant PinDetector");
     }
@@ -54,7 +90,13 @@ void GameManager::initialize(Ogre::SceneManager* sceneMgr, Ogre::Camera* camera,
     cameraFollower = std::make_unique<CameraFollower>(this->camera, this->ball);
     cameraFollower->initialize();
 
+    // Chocs publiés par la physique après chaque pas, consommés dans handleImpacts
+    PhysicsManager::getInstance()->setImpactEventsEnabled(true);
+
     ScoreManager::getInstance()->initialize();  // Charger les sons
+    if (!history.open(HISTORY_DIRECTORY)) {
+        Ogre::LogManager::getSingleton().logWarning("Historique des parties indisponible : " + Ogre::String(HISTORY_DIRECTORY));
+    }
     AudioManager* audioMgr = AudioManager::getInstance();
     if (!audioMgr->loadSound("bowling-roll/bowling_roll.ogg", "roll", true)) { // Charger en boucle
         Ogre::LogManager::getSingleton().logWarning("Impossible de charger le son de roulement.");
@@ -63,19 +105,27 @@ void GameManager::initialize(Ogre::SceneManager* sceneMgr, Ogre::Camera* camera,
         Ogre::LogManager::getSingleton().logWarning("Impossible de charger le son de collision.");
     }
 
+    // Journal de la session : commence avant le premier pas physique du monde
+    if (this->ball && this->lane) {
+        replay.begin(GameReplay::Source::GAME, *PhysicsManager::getInstance(), *this->lane, *this->ball);
+        if (!replay.worldIssue.empty()) {
+            Ogre::LogManager::getSingleton().logWarning("Parties non enregistrées : " + replay.worldIssue);
+        }
+    }
+
     resetGame();
 
     Ogre::LogManager::getSingleton().logMessage("GameManager initialisé pour un nouveau jeu.");
 }
 
 void GameManager::update(float deltaTime) {
+    replay.addFrame(PhysicsManager::getInstance()->getLastFrameSteps());
+
     // Mise à jour des systèmes principaux
+    // Les nœuds de la boule et des quilles sont placés par PhysicsManager::syncSceneNodes
     if (ball) { 
         ball->update(deltaTime);
     }
-    if (lane) { 
-        lane->update(deltaTime);
-    }
     if (aimingSystem) {
         aimingSystem->update(deltaTime);
     }
@@ -86,33 +136,88 @@ void GameManager::update(float deltaTime) {
         cameraFollower->update(deltaTime);
     }
 
-    // Logique des états de jeu
-    switch (gameState) {
-        case GameState::AIMING:
-            handleAimingState(deltaTime);
-            break;
-        case GameState::POWER:
-            handlePowerState(deltaTime);
-            break;
-        case GameState::ROLLING:
-            handleRollingState(deltaTime);
-            break;
-        case GameState::SCORING:
-            handleScoringState(deltaTime);
-            break;
-        case GameState::GAME_OVER:
-            // Gérer l'état de fin de partie (affichage score final, option rejouer...)
-            break;
+    // Fin de lancer détectée (ROLL_SETTLED), puis événements de la frame dans l'ordre
+    if (stateMachine.isIn(GameState::ROLLING)) {
+        handleRollingState(deltaTime);
+    }
+    stateMachine.dispatch();
+
+    handleImpacts();
+}
+
+void GameManager::handleImpacts() {
+    // Seul consommateur de la file : on la vide à chaque frame, quel que soit l'état,
+    // pour ne jamais rejouer des chocs anciens
+    bool audible = stateMachine.isIn(GameState::ROLLING) || stateMachine.isIn(GameState::SCORING);
+    float loudestVolume = 0.0f;
+    const char* loudestSound = nullptr;
+
+    ImpactEvent event;
+    while (PhysicsManager::getInstance()->popImpact(event)) {
+        if (event.type == ImpactType::BALL_GUTTER) {
+            SimulationLog::message("GameManager: Boule dans la gouttière.");
+        }
+
+        const ImpactSound& impactSound = IMPACT_SOUNDS[static_cast<int>(event.type)];
+        if (!audible || !impactSound.sound || event.impulse < impactSound.minImpulse) {
+            continue;
+        }
+        float volume = std::min(1.0f, event.impulse / impactSound.fullVolumeImpulse);
+        if (volume > loudestVolume) {
+            loudestVolume = volume;
+            loudestSound = impactSound.sound;
+        }
+    }
+
+    // Un seul son par frame (le choc le plus fort) : le coût audio ne dépend pas du nombre de contacts
+    if (loudestSound) {
+        AudioManager::getInstance()->playSound(loudestSound, loudestVolume);
+    }
+}
+
+void GameManager::captureRetrySnapshot() {
+    if (retrySnapshot.isValid() || !ball || !lane || !ball->isRolling()) {
+        return;
+    }
+
+    Ogre::Vector3 ballPosition = ball->getPosition();
+    for (const auto& pin : lane->getPins()) {
+        const btVector3& pinPosition = pin->getPinBody()->getWorldTransform().getOrigin();
+        float dx = pinPosition.x() - ballPosition.x;
+        float dz = pinPosition.z() - ballPosition.z;
+        if (dx * dx + dz * dz < RETRY_CAPTURE_DISTANCE * RETRY_CAPTURE_DISTANCE) {
+            PhysicsManager::getInstance()->captureSnapshot(retrySnapshot);
+            replay.addEvent(GameReplay::EventType::CAPTURE);
+            return;
+        }
+    }
+}
+
+void GameManager::retryFromSnapshot() {
+    if (!retrySnapshot.isValid()) {
+        SimulationLog::message("Rejouer : la boule n'a pas encore atteint les quilles.");
+        return;
+    }
+    if (!PhysicsManager::getInstance()->restoreSnapshot(retrySnapshot)) {
+        Ogre::LogManager::getSingleton().logWarning("Rejouer : instantané physique inutilisable.");
+        retrySnapshot.invalidate();
+        return;
     }
 
-    // --- Détection de collision pour le son --- 
-    // Idéalement, ceci serait géré par PhysicsManager ou PinDetector
-    // qui appellerait directement AudioManager::getInstance()->playSound("collision");
-    // En attendant, on peut le simuler ici si PinDetector expose une info
-    if (gameState == GameState::ROLLING && pinDetector /*&& pinDetector->hasDetectedCollisionThisFrame()*/) { // Méthode hypothétique
-         AudioManager::getInstance()->playSound("collision");
-         //Ogre::LogManager::getSingleton().logMessage("GameManager: Son de collision déclenché (simulation).");
+    replay.addEvent(GameReplay::EventType::RETRY);
+
+    // Chocs du lancer abandonné : ne pas les faire entendre après la restauration
+    ImpactEvent stale;
+    while (PhysicsManager::getInstance()->popImpact(stale)) {}
+
+    if (ball) {
+        ball->setRolling(true);
+    }
+    if (pinDetector) {
+        pinDetector->startDetection();
     }
+    SimulationLog::message("Rejouer : retour juste avant l'impact (pas " +
+        Ogre::StringConverter::toString(retrySnapshot.getStepCount()) + ").");
 }
 
 // --- Gestion des entrées --- 
@@ -147,18 +252,24 @@ bool GameManager::handleMouseRelease(const OgreBites::MouseButtonEvent& evt) {
 bool GameManager::handleKeyPress(const OgreBites::KeyboardEvent& evt) {
     // Touche R pour réinitialiser le jeu complet
     if (evt.keysym.sym == 'r' || evt.keysym.sym == 'R') {
-        resetGame();
+        stateMachine.post(GameEvent::RESET);
+        return true;
+    }
+
+    // Touche T pendant le roulement pour rejouer l'impact
+    if (stateMachine.isIn(GameState::ROLLING) && (evt.keysym.sym == 't' || evt.keysym.sym == 'T')) {
+        stateMachine.post(GameEvent::RETRY);
         return true;
     }
 
     // Touche Espace pour passer de AIMING à POWER
-    if (gameState == GameState::AIMING && evt.keysym.sym == OgreBites::SDLK_SPACE) {
-        changeState(GameState::POWER);
+    if (stateMachine.isIn(GameState::AIMING) && evt.keysym.sym == OgreBites::SDLK_SPACE) {
+        stateMachine.post(GameEvent::CHARGE);
         return true;
     }
 
     // Transmettre les autres touches à AimingSystem si on est en état POWER
-    if (gameState == GameState::POWER && aimingSystem) {
+    if (stateMachine.isIn(GameState::POWER) && aimingSystem) {
         aimingSystem->handleKeyPress(evt);
         // Note: handleKeyPress ne retourne pas de bool ici, on suppose qu'il gère l'événement
         return true; // Indique que l'événement a été potentiellement géré
@@ -170,14 +281,14 @@ bool GameManager::handleKeyPress(const OgreBites::KeyboardEvent& evt) {
 // Nouvelle fonction pour gérer le relâchement de touche
 bool GameManager::handleKeyRelease(const OgreBites::KeyboardEvent& evt) {
     // Si on est en état POWER et qu'on relâche HAUT (ou Z/W)
-    if (gameState == GameState::POWER &&
+    if (stateMachine.isIn(GameState::POWER) &&
         (evt.keysym.sym == OgreBites::SDLK_UP || evt.keysym.sym == 'z' || evt.keysym.sym == 'w'))
     {
         if (aimingSystem) {
             // Indiquer à AimingSystem de gérer le relâchement (il mettra mPowerInputActive à false)
             aimingSystem->handleKeyRelease(evt);
-            // Lancer la boule
-            launchBall();
+            // Lancer la boule (action de la transition POWER -> ROLLING)
+            stateMachine.post(GameEvent::LAUNCH);
             return true;
         }
     }
@@ -186,21 +297,45 @@ bool GameManager::handleKeyRelease(const OgreBites::KeyboardEvent& evt) {
 
 // --- Logique des états --- 
 
-void GameManager::changeState(GameState newState) {
-    GameState oldState = gameState;
-    if (oldState == newState) return;
+bool GameManager::checkGuard(GameGuard guard) {
+    switch (guard) {
+        case GameGuard::GAME_FINISHED: return lastRoll.gameOver;
+        case GameGuard::CAN_LAUNCH: return aimingSystem && ball;
+        default: return true;
+    }
+}
 
-    gameState = newState;
-    Ogre::LogManager::getSingleton().logMessage("Changement d'état : " +
-                                               gameStateToString(oldState) +
-                                               " -> " +
-                                               gameStateToString(newState));
+void GameManager::onExit(GameState state) {
+    if (state == GameState::ROLLING) {
+        // Arrêter le son de roulement (lancer terminé ou partie réinitialisée)
+        AudioManager::getInstance()->stopSound("roll");
+    }
+}
+
+void GameManager::onTransition(GameState from, GameEvent event, GameState to) {
+    if (from != to) {
+        SimulationLog::message(std::string("Changement d'état : ") + toString(from) +
+                                                   " -> " + toString(to) + " (" + toString(event) + ")");
+    }
 
-    // Actions à l'entrée du nouvel état
-    switch (newState) {
+    switch (event) {
+        case GameEvent::LAUNCH:
+            launchBall();
+            break;
+        case GameEvent::RETRY:
+            retryFromSnapshot();
+            break;
+        case GameEvent::RESET:
+            resetSystems();
+            break;
+        default:
+            break;
+    }
+}
+
+void GameManager::onEnter(GameState state) {
+    switch (state) {
         case GameState::AIMING:
-            // Arrêter le son de roulement s'il jouait encore
-            AudioManager::getInstance()->stopSound("roll");
             if (aimingSystem) {
                 aimingSystem->setAimingActive(true);
                 aimingSystem->resetAiming(); // Réinitialise puissance/spin et cache overlays
@@ -214,12 +349,11 @@ void GameManager::changeState(GameState newState) {
 
             if (ball) {
                 ball->reset();
+                replay.addEvent(GameReplay::EventType::RESET_BALL);
             }
+            retrySnapshot.invalidate();
             
-            // Réinitialiser les quilles seulement si on commence une nouvelle frame (pas entre 2 lancers)
-            if (currentRollInFrame == 1 && lane) {
-                 lane->resetPins();
-            }
+            // Le relevage des quilles est décidé par FrameLogic (voir scoreRoll)
             if (pinDetector) {
                 pinDetector->reset(); // Réinitialiser le détecteur pour la nouvelle visée
             }
@@ -235,8 +369,6 @@ void GameManager::changeState(GameState newState) {
         case GameState::ROLLING:
             // Le son de roulement est joué dans launchBall()
             if (aimingSystem) {
-                // Cacher les overlays de puissance/spin (déjà fait dans resetAiming lors du passage à AIMING)
-                // Mais on peut le faire ici aussi par sécurité si on vient d'un autre état
                 aimingSystem->resetAiming(); // Assure que les overlays sont cachés
                 aimingSystem->setAimingActive(false);
             }
@@ -249,204 +381,180 @@ void GameManager::changeState(GameState newState) {
             break;
 
         case GameState::SCORING:
-            // Arrêter le son de roulement
-            AudioManager::getInstance()->stopSound("roll");
             // La séquence caméra post-lancer est gérée dans CameraFollower::update
             // quand ball->isRolling() devient false.
-            // On pourrait forcer l'arrêt du suivi ici si nécessaire :
-            // if (cameraFollower) {
-            //     cameraFollower->stopFollowing();
-            // }
+            scoreRoll();
             break;
 
         case GameState::GAME_OVER:
-             AudioManager::getInstance()->stopSound("roll"); // Sécurité
-             Ogre::LogManager::getSingleton().logMessage("Partie terminée! Score final: " + Ogre::StringConverter::toString(ScoreManager::getInstance()->getCurrentScore()));
-             // Afficher un message à l'utilisateur, proposer de rejouer (touche R?)
+            SimulationLog::message("Partie terminée! Score final: " + Ogre::StringConverter::toString(ScoreManager::getInstance()->getCurrentScore()));
+            // Afficher un message à l'utilisateur, proposer de rejouer (touche R?)
             break;
     }
 }
 
-void GameManager::handleAimingState(float deltaTime) {
-    // La direction est gérée par la souris (si activé) ou fixe
-    // Le passage à POWER se fait via la touche Espace (handleKeyPress)
-}
+void GameManager::handleRollingState(float deltaTime) {
+    captureRetrySnapshot();
 
-void GameManager::handlePowerState(float deltaTime) {
-    // La puissance/spin sont gérés par AimingSystem via handleKeyPress
-    // Le lancement se fait via handleKeyRelease
+    // Le lancer se termine quand la boule et toutes les quilles sont au repos
+    // (y compris les quilles qui vacillent encore après l'arrêt de la boule)
+    if (pinDetector) {
+        if (pinDetector->isDetectionComplete()) {
+            SimulationLog::message("Boule et quilles au repos. Passage à SCORING.");
+            stateMachine.post(GameEvent::ROLL_SETTLED);
+        }
+    }
+    else if (ball && !ball->isRolling()) {
+        SimulationLog::message("Boule arrêtée. Passage à SCORING.");
+        stateMachine.post(GameEvent::ROLL_SETTLED);
+    }
 }
 
-void GameManager::handleRollingState(float deltaTime) {
-    // Vérification si la boule a fini de rouler
-    if (ball && !ball->isRolling()) {
-        Ogre::LogManager::getSingleton().logMessage("Boule arrêtée. Passage à SCORING.");
-        changeState(GameState::SCORING);
+void GameManager::scoreRoll() {
+    lastRoll = RollResult();
+    if (!pinDetector) {
+        Ogre::LogManager::getSingleton().logWarning("PinDetector non initialisé : lancer compté à 0.");
     }
-    // Mettre à jour le son de roulement (volume basé sur vitesse?)
-    // Pour l'instant, il joue en boucle jusqu'à SCORING ou AIMING.
-}
 
-void GameManager::handleScoringState(float deltaTime) {
-    // Attendre que la séquence caméra post-lancer soit terminée ?
-    // Ou calculer le score dès que la boule s'arrête.
-    // Pour l'instant, calcul immédiat.
-
-    // S'assurer que le détecteur a fini son travail (si asynchrone)
-    if (pinDetector /*&& pinDetector->isDetectionComplete()*/) { // Supposons détection immédiate
-
-        int totalPinsDownSinceReset = pinDetector->getKnockedDownPinCount();
-        int pinsThisRoll = (currentRollInFrame == 1) ? totalPinsDownSinceReset : (totalPinsDownSinceReset - pinsKnockedFirstRoll);
-
-        // Jouer le son de collision si des quilles sont tombées
-        // Note: Idéalement, ce son serait joué au moment de l'impact.
-        // if (pinsThisRoll > 0 && !AudioManager::getInstance()->isPlaying("collision")) { // Eviter répétition rapide
-        //     AudioManager::getInstance()->playSound("collision");
-        // }
-
-        Ogre::LogManager::getSingleton().logMessage("SCORING: Frame " + Ogre::StringConverter::toString(currentFrame) +
-                                                   ", Lancer " + Ogre::StringConverter::toString(currentRollInFrame) +
-                                                   ". Quilles ce lancer: " + Ogre::StringConverter::toString(pinsThisRoll));
-
-        // Enregistrer le lancer
-        ScoreManager::getInstance()->recordRoll(pinsThisRoll);
-
-        // --- Logique de progression des frames --- 
-        bool frameOver = false;
-        bool strike = (currentRollInFrame == 1 && pinsThisRoll == 10);
-        bool spare = (currentRollInFrame == 2 && (pinsThisRoll + pinsKnockedFirstRoll == 10));
-
-        // Cas spécial : 10ème frame
-        if (currentFrame == MAX_FRAMES) {
-            if (currentRollInFrame == 1) {
-                if (strike) { // Strike au 1er lancer de la 10e
-                    //pinsKnockedFirstRoll = 10;
-                    pinsKnockedFirstRoll = totalPinsDownSinceReset;
-                    currentRollInFrame = 2; // Passe au 2e lancer
-                    if(lane) lane->resetPins(); // Reset pour le 2e lancer
-                    changeState(GameState::AIMING);
-                } else { // Frame ouverte au 1er lancer de la 10e
-                    pinsKnockedFirstRoll = pinsThisRoll;
-                    currentRollInFrame = 2; // Passe au 2e lancer
-                    // Pas de reset des quilles
-                    changeState(GameState::AIMING);
-                }
-            } else if (currentRollInFrame == 2) {
-                if (strike || spare) { // Strike ou Spare au 2e lancer -> 3e lancer
-                    pinsKnockedFirstRoll += pinsThisRoll; // Cumul pour le 3e
-                    currentRollInFrame = 3; // Passe au 3e lancer
-                    if(lane) lane->resetPins(); // Reset pour le 3e lancer
-                    changeState(GameState::AIMING);
-                } else { // Frame ouverte après 2 lancers -> Fin de partie
-                    frameOver = true;
-                }
-            } else { // Après le 3ème lancer -> Fin de partie
-                frameOver = true;
-            }
-        } 
-        // Cas : Frames 1 à 9
-        else {
-            if (strike) { // Strike
-                Ogre::LogManager::getSingleton().logMessage("Strike!");
-                frameOver = true;
-            } else if (currentRollInFrame == 2) { // Après le 2ème lancer
-                if (spare) {
-                    Ogre::LogManager::getSingleton().logMessage("Spare!");
-                } else {
-                    Ogre::LogManager::getSingleton().logMessage("Frame ouverte.");
-                }
-                frameOver = true;
-            } else { // Après le 1er lancer (pas de strike)
-                pinsKnockedFirstRoll = pinsThisRoll;
-                currentRollInFrame = 2;
-                // Pas de reset des quilles
-                changeState(GameState::AIMING);
-            }
+    int totalPinsDownSinceReset = pinDetector ? pinDetector->getKnockedDownPinCount() : 0;
+    int frame = frameLogic.getCurrentFrame();
+    int rollInFrame = frameLogic.getCurrentRollInFrame();
+
+    // Progression des frames (y compris les lancers bonus de la 10e frame)
+    lastRoll = frameLogic.recordRoll(totalPinsDownSinceReset);
+    replay.addEvent(GameReplay::EventType::SCORE);
+
+    SimulationLog::message("SCORING: Frame " + Ogre::StringConverter::toString(frame) +
+                                               ", Lancer " + Ogre::StringConverter::toString(rollInFrame) +
+                                               ". Quilles ce lancer: " + Ogre::StringConverter::toString(lastRoll.pinsThisRoll));
+
+    // Enregistrer le lancer (masque des quilles couchées : marque des splits)
+    ScoreManager::getInstance()->recordRoll(lastRoll.pinsThisRoll,
+        pinDetector ? pinDetector->getClassifier().getKnockedDownMask() : -1);
+    if (lane) {
+        // Pas du repos vus par le détecteur : mis à jour par frame, donc arrondis à la frame de rendu
+        int settleStep = pinDetector ? static_cast<int>(pinDetector->getSettleDetector().getSettleStep()) : 0;
+        replay.addRoll(frame, rollInFrame, launchDirection, launchPower, launchSpin, settleStep,
+                       lastRoll.pinsThisRoll, *lane);
+    }
+
+    if (lastRoll.strike) {
+        SimulationLog::message("Strike!");
+    } else if (lastRoll.spare) {
+        SimulationLog::message("Spare!");
+    } else if (lastRoll.frameOver) {
+        SimulationLog::message("Frame ouverte.");
+    }
+
+    if (lastRoll.gameOver) {
+        replay.setFinalScore(ScoreManager::getInstance()->getCurrentScore());
+        // Un monde que BowlingReplay ne saurait pas recréer donnerait un fichier invérifiable
+        if (!replay.worldIssue.empty()) {
+            SimulationLog::message("Partie non enregistrée : " + replay.worldIssue);
+        } else if (replay.save(REPLAY_FILE)) {
+            SimulationLog::message(std::string("Partie enregistrée dans ") + REPLAY_FILE);
         }
+        recordHistory();
+    } else if (lastRoll.resetRack && lane) {
+        // Relever les quilles pour une nouvelle frame ou un lancer bonus de la 10e
+        lane->resetPins();
+        replay.addEvent(GameReplay::EventType::RESET_PINS);
+    }
 
-        // Si la frame est terminée (ou la partie)
-        if (frameOver) {
-            if (currentFrame >= MAX_FRAMES) {
-                changeState(GameState::GAME_OVER);
-            } else {
-                currentFrame++;
-                currentRollInFrame = 1;
-                pinsKnockedFirstRoll = 0;
-                // Le reset des quilles se fait à l'entrée de AIMING
-                changeState(GameState::AIMING);
-            }
+    // GAME_OVER ou retour à la visée, selon lastRoll (condition GAME_FINISHED)
+    stateMachine.post(GameEvent::ROLL_SCORED);
+}
+
+void GameManager::recordHistory() {
+    if (!history.isOpen()) {
+        return;
+    }
+    const ScoreManager* scores = ScoreManager::getInstance();
+    GameHistory::Record record;
+    record.player = PLAYER_NAME;
+    record.date = static_cast<int64_t>(std::time(nullptr));
+    record.lane = LANE_NUMBER;
+    record.rollCount = scores->getRollCount();
+    record.rolls = scores->getRolls();
+    record.frameScores = scores->getFrameScores();
+    record.finalScore = scores->getCurrentScore();
+
+    // Entrées et quilles laissées : un lancer de replay par lancer compté
+    for (size_t i = 0; i < replay.rolls.size() && i < record.launches.size(); ++i) {
+        const GameReplay::Roll& roll = replay.rolls[i];
+        record.launches[i] = {roll.direction.x, roll.power, roll.spin};
+        if (roll.rollInFrame == 1 && roll.frame >= 1 && roll.frame <= ScoreRules::FRAME_COUNT) {
+            record.leaves[roll.frame - 1] = static_cast<uint16_t>(~roll.knockedDownMask & 0x3FF);
         }
+    }
 
-    } else {
-        Ogre::LogManager::getSingleton().logWarning("Attente de PinDetector ou PinDetector non initialisé.");
-        // Peut-être ajouter un timeout pour éviter de rester bloqué ici
+    if (history.append(record)) {
+        history.flush();
+        SimulationLog::message("Partie ajoutée à l'historique (" +
+            Ogre::StringConverter::toString(history.getGameCount()) + " parties)");
     }
 }
 
 // --- Autres méthodes --- 
 void GameManager::launchBall() {
-    if (gameState != GameState::POWER || !aimingSystem || !ball) {
-        Ogre::LogManager::getSingleton().logWarning("Tentative de lancement dans un état invalide ou systèmes non prêts.");
-        return;
-    }
-
+    // Appelé par la transition POWER -> ROLLING, condition CAN_LAUNCH vérifiée
     Ogre::Vector3 direction = aimingSystem->getAimingDirection().normalisedCopy(); // Normalisation
     float power = aimingSystem->getPower();
     float spin = aimingSystem->getSpinEffect();
 
-    Ogre::LogManager::getSingleton().logMessage("Lancement: Dir=" + Ogre::StringConverter::toString(direction) +
+    SimulationLog::message("Lancement: Dir=" + Ogre::StringConverter::toString(direction) +
                                                ", Power=" + Ogre::StringConverter::toString(power) +
                                                ", Spin=" + Ogre::StringConverter::toString(spin));
 
     ball->launch(direction, power, spin);
+    replay.addLaunch(direction, power, spin);
+    launchDirection = direction;
+    launchPower = power;
+    launchSpin = spin;
 
     AudioManager::getInstance()->playSound("roll");
-    changeState(GameState::ROLLING);
 
-    Ogre::LogManager::getSingleton().logMessage("Frame " + Ogre::StringConverter::toString(currentFrame) +
-                                               ", Lancer " + Ogre::StringConverter::toString(currentRollInFrame) +
+    SimulationLog::message("Frame " + Ogre::StringConverter::toString(frameLogic.getCurrentFrame()) +
+                                               ", Lancer " + Ogre::StringConverter::toString(frameLogic.getCurrentRollInFrame()) +
                                                ": Boule lancée.");
 }
 
 void GameManager::resetGame() {
-    Ogre::LogManager::getSingleton().logMessage("Réinitialisation complète du jeu.");
-    currentFrame = 1;
-    currentRollInFrame = 1;
-    pinsKnockedFirstRoll = 0;
+    stateMachine.fire(GameEvent::RESET);
+}
+
+void GameManager::resetSystems() {
+    SimulationLog::message("Réinitialisation complète du jeu.");
+    frameLogic.reset();
+    lastRoll = RollResult();
+    replay.newGame();
 
     // Arrêter les sons
     AudioManager::getInstance()->stopSound("roll");
     AudioManager::getInstance()->stopSound("collision"); // Au cas où
 
     // Réinitialiser les systèmes
-    if (ball) { ball->reset(); }
-    if (lane) { lane->resetPins(); } // S'assurer que les quilles sont debout
+    if (ball) {
+        ball->reset();
+        replay.addEvent(GameReplay::EventType::RESET_BALL);
+    }
+    if (lane) {
+        lane->resetPins(); // S'assurer que les quilles sont debout
+        replay.addEvent(GameReplay::EventType::RESET_PINS);
+    }
     if (aimingSystem) { aimingSystem->resetAiming(); }
     if (pinDetector) { pinDetector->reset(); }
     if (cameraFollower) { cameraFollower->resetToStartPosition(); } // Utiliser resetToStartPosition
 
     ScoreManager::getInstance()->resetScore();
 
-    // Revenir à l'état de visée initial
-    changeState(GameState::AIMING);
+    // L'entrée dans AIMING (transition RESET) termine la remise à zéro
 }
 
 GameState GameManager::getGameState() const {
-    return gameState;
+    return stateMachine.getState();
 }
 
 CameraFollower* GameManager::getCameraFollower() const {
     return cameraFollower.get();
 }
-
-std::string GameManager::gameStateToString(GameState state) {
-    switch (state) {
-        case GameState::AIMING: return "AIMING";
-        case GameState::POWER: return "POWER";
-        case GameState::ROLLING: return "ROLLING";
-        case GameState::SCORING: return "SCORING";
-        case GameState::GAME_OVER: return "GAME_OVER";
-        default: return "UNKNOWN";
-    }
-}
-
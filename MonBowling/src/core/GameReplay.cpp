@@ -0,0 +1,516 @@
+#include "../../include/core/GameReplay.h"
+#include "../../include/managers/PhysicsManager.h"
+#include "../../include/objects/BowlingBall.h"
+#include <OgreLogManager.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+const char* const REPLAY_MAGIC = "BOWLING_REPLAY";
+
+// Flottant au bit près : hexadécimal à l'écriture, strtof le relit exactement
+std::string hexFloat(float value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%a", static_cast<double>(value));
+    return buffer;
+}
+
+bool readFloat(std::istringstream& line, float& value) {
+    std::string token;
+    if (!(line >> token)) {
+        return false;
+    }
+    char* end = nullptr;
+    value = std::strtof(token.c_str(), &end);
+    return end != token.c_str() && *end == '\0';
+}
+
+bool sameBits(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+// Profondeur maximale d'une forme composée relue (un fichier corrompu ne fait pas déborder la pile)
+const int MAX_SHAPE_DEPTH = 4;
+
+// type nb_valeurs valeurs... nb_enfants, puis chaque enfant de la même façon
+void writeShape(std::ostream& file, const ShapeDescription& shape) {
+    file << shape.type << " " << shape.values.size();
+    for (float value : shape.values) {
+        file << " " << hexFloat(value);
+    }
+    file << " " << shape.children.size();
+    for (const ShapeDescription& child : shape.children) {
+        file << " ";
+        writeShape(file, child);
+    }
+}
+
+bool readShape(std::istringstream& line, ShapeDescription& shape, int depth = 0) {
+    size_t valueCount = 0;
+    size_t childCount = 0;
+    if (depth > MAX_SHAPE_DEPTH || !(line >> shape.type >> valueCount)) {
+        return false;
+    }
+    shape.values.clear();
+    for (size_t i = 0; i < valueCount; ++i) {
+        float value;
+        if (!readFloat(line, value)) {
+            return false;
+        }
+        shape.values.push_back(value);
+    }
+    if (!(line >> childCount)) {
+        return false;
+    }
+    shape.children.clear();
+    for (size_t i = 0; i < childCount; ++i) {
+        ShapeDescription child;
+        if (!readShape(line, child, depth + 1)) {
+            return false;
+        }
+        shape.children.push_back(std::move(child));
+    }
+    return true;
+}
+
+// Forme de collision d'un corps (false sans corps ou si la forme ne se décrit pas)
+bool describeBodyShape(const btRigidBody* body, ShapeDescription& shape) {
+    return body && ShapeCache::describeShape(body->getCollisionShape(), shape);
+}
+
+} // namespace
+
+GameReplay::GameReplay()
+    : source(Source::SIMULATION),
+      fixedTimeStep(0.0f),
+      laneCollider(LaneColliderType::ANALYTIC),
+      ccdEnabled(true),
+      multithreaded(false),
+      laneMeshHash(0),
+      finalScore(-1)
+{}
+
+void GameReplay::begin(Source source, const PhysicsManager& physics, const BowlingLane& lane, const BowlingBall& ball) {
+    this->source = source;
+    fixedTimeStep = physics.getFixedTimeStep();
+    laneCollider = lane.getColliderType();
+    ccdEnabled = ball.getCcdProfile().enabled;
+    multithreaded = physics.isMultithreaded();
+    oilPatternName.clear();
+    oilFriction.clear();
+    if (lane.hasOilPattern()) {
+        const LaneFrictionField& pattern = lane.getOilPattern();
+        oilPatternName = pattern.getName();
+        oilFriction.reserve(LaneFrictionField::ROW_COUNT * LaneFrictionField::BOARD_COUNT);
+        for (int row = 0; row < LaneFrictionField::ROW_COUNT; ++row) {
+            for (int board = 0; board < LaneFrictionField::BOARD_COUNT; ++board) {
+                oilFriction.push_back(pattern.getFriction(row, board));
+            }
+        }
+    }
+    rolls.clear();
+    finalScore = -1;
+
+    // Monde à recréer sans rendu : ce qui ne se décrit pas rend l'enregistrement inutilisable
+    worldIssue.clear();
+    events.clear();
+    if (!physics.isFixedStepEnabled()) {
+        worldIssue = "pas physique variable";
+    }
+
+    ground = GroundDescription();
+    const btRigidBody* groundBody = lane.getGroundBody();
+    if (groundBody && ShapeCache::describeShape(groundBody->getCollisionShape(), ground.shape)) {
+        ground.transform = groundBody->getWorldTransform();
+        ground.friction = groundBody->getFriction();
+        ground.restitution = groundBody->getRestitution();
+        ground.rollingFriction = groundBody->getRollingFriction();
+        ground.spinningFriction = groundBody->getSpinningFriction();
+        ground.filterGroup = groundBody->getBroadphaseHandle()->m_collisionFilterGroup;
+        ground.filterMask = groundBody->getBroadphaseHandle()->m_collisionFilterMask;
+    } else if (worldIssue.empty()) {
+        worldIssue = "forme du sol non reconnue";
+    }
+
+    laneMeshName.clear();
+    laneMeshHash = 0;
+    const btRigidBody* laneBody = lane.getLaneBody();
+    if (!laneBody) {
+        if (worldIssue.empty()) worldIssue = "piste sans corps";
+    } else if (laneBody->getCollisionShape()->getShapeType() == TRIANGLE_MESH_SHAPE_PROXYTYPE) {
+        // Le maillage n'est pas recopié ici : il est relu du fichier de BvhCache
+        if (!physics.getBvhCache().findShapeKey(static_cast<const btBvhTriangleMeshShape*>(laneBody->getCollisionShape()),
+                                                laneMeshName, laneMeshHash) && worldIssue.empty()) {
+            worldIssue = "maillage de la piste absent du cache disque de BvhCache";
+        }
+    }
+
+    const auto& pins = lane.getPins();
+    if (!describeBodyShape(pins.empty() || !pins[0] ? nullptr : pins[0]->getPinBody(), pinShape) && worldIssue.empty()) {
+        worldIssue = "forme des quilles non reconnue";
+    }
+    if (!describeBodyShape(ball.getBallBody(), ballShape) && worldIssue.empty()) {
+        worldIssue = "forme de la boule non reconnue";
+    }
+}
+
+void GameReplay::addFrame(int steps) {
+    if (!events.empty() && events.back().type == EventType::FRAMES && events.back().steps == steps) {
+        ++events.back().count;
+        return;
+    }
+    Event event;
+    event.type = EventType::FRAMES;
+    event.count = 1;
+    event.steps = steps;
+    events.push_back(event);
+}
+
+void GameReplay::addLaunch(const Ogre::Vector3& direction, float power, float spin) {
+    Event event;
+    event.type = EventType::LAUNCH;
+    event.direction = direction;
+    event.power = power;
+    event.spin = spin;
+    events.push_back(event);
+}
+
+void GameReplay::addEvent(EventType type) {
+    Event event;
+    event.type = type;
+    events.push_back(event);
+}
+
+void GameReplay::newGame() {
+    addEvent(EventType::NEW_GAME);
+    rolls.clear();
+    finalScore = -1;
+}
+
+bool GameReplay::applyWorld(BowlingLane& lane, BowlingBall& ball, PhysicsManager& physics) const {
+    lane.setColliderType(laneCollider);
+    if (ground.shape.type != INVALID_SHAPE_PROXYTYPE) {
+        lane.setHeadlessGround(ground);
+    }
+    if (laneMeshHash != 0) {
+        lane.setHeadlessLaneMesh(laneMeshName, laneMeshHash);
+    }
+
+    bool ok = true;
+    if (pinShape.type != INVALID_SHAPE_PROXYTYPE) {
+        btCollisionShape* shape = ShapeCache::createShape(pinShape);
+        ok = shape != nullptr;
+        if (shape) {
+            BowlingPin::setHeadlessShape(physics, shape);
+        }
+    }
+    if (ballShape.type != INVALID_SHAPE_PROXYTYPE) {
+        btCollisionShape* shape = ShapeCache::createShape(ballShape);
+        ok = ok && shape != nullptr;
+        ball.setCollisionShape(shape);
+    }
+
+    BallCcdProfile ccd = ball.getCcdProfile();
+    ccd.enabled = ccdEnabled;
+    ball.setCcdProfile(ccd);
+    return ok;
+}
+
+void GameReplay::addRoll(int frame, int rollInFrame, const Ogre::Vector3& direction, float power, float spin,
+                         int settleStep, int pinsThisRoll, const BowlingLane& lane) {
+    Roll roll;
+    roll.frame = frame;
+    roll.rollInFrame = rollInFrame;
+    roll.direction = direction;
+    roll.power = power;
+    roll.spin = spin;
+    roll.settleStep = settleStep;
+    roll.pinsThisRoll = pinsThisRoll;
+    roll.knockedDownMask = lane.getKnockedDownMask();
+
+    roll.pinStates.reserve(lane.getPins().size() * FLOATS_PER_PIN);
+    for (const auto& pin : lane.getPins()) {
+        const btTransform& transform = pin->getPinBody()->getWorldTransform();
+        const btVector3& position = transform.getOrigin();
+        btQuaternion rotation = transform.getRotation();
+        roll.pinStates.insert(roll.pinStates.end(), {
+            static_cast<float>(position.x()), static_cast<float>(position.y()), static_cast<float>(position.z()),
+            static_cast<float>(rotation.x()), static_cast<float>(rotation.y()), static_cast<float>(rotation.z()),
+            static_cast<float>(rotation.w())});
+    }
+    rolls.push_back(std::move(roll));
+}
+
+bool GameReplay::save(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        Ogre::LogManager::getSingleton().logWarning("GameReplay::save - impossible d'écrire " + path);
+        return false;
+    }
+
+    file << REPLAY_MAGIC << " " << FORMAT_VERSION << "\n";
+    file << "source " << getSourceName(source) << "\n";
+    file << "step " << hexFloat(fixedTimeStep) << "\n";
+    file << "lane " << (laneCollider == LaneColliderType::MESH ? "mesh" : "analytic") << "\n";
+    file << "ccd " << (ccdEnabled ? 1 : 0) << "\n";
+    file << "mt " << (multithreaded ? 1 : 0) << "\n";
+    // oil nb_flottants flottants... (0 : pas de motif), puis le nom du motif s'il y en a un
+    file << "oil " << oilFriction.size();
+    for (float value : oilFriction) {
+        file << " " << hexFloat(value);
+    }
+    file << "\n";
+    if (!oilFriction.empty()) {
+        file << "oilname " << oilPatternName << "\n";
+    }
+
+    // ground base(9) origine(3) friction restitution roulement rotation groupe masque forme
+    if (ground.shape.type != INVALID_SHAPE_PROXYTYPE) {
+        file << "ground";
+        for (int row = 0; row < 3; ++row) {
+            const btVector3& basisRow = ground.transform.getBasis()[row];
+            file << " " << hexFloat(basisRow.x()) << " " << hexFloat(basisRow.y()) << " " << hexFloat(basisRow.z());
+        }
+        const btVector3& origin = ground.transform.getOrigin();
+        file << " " << hexFloat(origin.x()) << " " << hexFloat(origin.y()) << " " << hexFloat(origin.z())
+             << " " << hexFloat(ground.friction) << " " << hexFloat(ground.restitution)
+             << " " << hexFloat(ground.rollingFriction) << " " << hexFloat(ground.spinningFriction)
+             << " " << ground.filterGroup << " " << ground.filterMask << " ";
+        writeShape(file, ground.shape);
+        file << "\n";
+    }
+    // lanemesh empreinte nom_du_mesh (fichier <mesh>_<empreinte>.bvh de BvhCache)
+    if (laneMeshHash != 0) {
+        char hashText[17];
+        std::snprintf(hashText, sizeof(hashText), "%016llx", static_cast<unsigned long long>(laneMeshHash));
+        file << "lanemesh " << hashText << " " << laneMeshName << "\n";
+    }
+    if (pinShape.type != INVALID_SHAPE_PROXYTYPE) {
+        file << "pinshape ";
+        writeShape(file, pinShape);
+        file << "\n";
+    }
+    if (ballShape.type != INVALID_SHAPE_PROXYTYPE) {
+        file << "ballshape ";
+        writeShape(file, ballShape);
+        file << "\n";
+    }
+
+    // Journal du jeu : frames nb pas, launch dx dy dz puissance spin, puis un mot par événement
+    for (const Event& event : events) {
+        switch (event.type) {
+            case EventType::FRAMES:
+                file << "frames " << event.count << " " << event.steps << "\n";
+                break;
+            case EventType::LAUNCH:
+                file << "launch " << hexFloat(event.direction.x) << " " << hexFloat(event.direction.y) << " "
+                     << hexFloat(event.direction.z) << " " << hexFloat(event.power) << " " << hexFloat(event.spin) << "\n";
+                break;
+            case EventType::CAPTURE: file << "capture\n"; break;
+            case EventType::RETRY: file << "retry\n"; break;
+            case EventType::SCORE: file << "scored\n"; break;
+            case EventType::RESET_PINS: file << "resetpins\n"; break;
+            case EventType::RESET_BALL: file << "resetball\n"; break;
+            case EventType::NEW_GAME: file << "newgame\n"; break;
+        }
+    }
+
+    // roll frame lancer dx dy dz puissance spin pas quilles masque nb_flottants flottants...
+    for (const Roll& roll : rolls) {
+        file << "roll " << roll.frame << " " << roll.rollInFrame << " "
+             << hexFloat(roll.direction.x) << " " << hexFloat(roll.direction.y) << " " << hexFloat(roll.direction.z) << " "
+             << hexFloat(roll.power) << " " << hexFloat(roll.spin) << " " << roll.settleStep << " "
+             << roll.pinsThisRoll << " " << roll.knockedDownMask << " " << roll.pinStates.size();
+        for (float value : roll.pinStates) {
+            file << " " << hexFloat(value);
+        }
+        file << "\n";
+    }
+    file << "score " << finalScore << "\n";
+    return static_cast<bool>(file);
+}
+
+bool GameReplay::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        Ogre::LogManager::getSingleton().logWarning("GameReplay::load - fichier introuvable : " + path);
+        return false;
+    }
+
+    std::string magic;
+    int version = 0;
+    if (!(file >> magic >> version) || magic != REPLAY_MAGIC || version != FORMAT_VERSION) {
+        Ogre::LogManager::getSingleton().logWarning("GameReplay::load - format inconnu : " + path);
+        return false;
+    }
+
+    *this = GameReplay();
+    std::string text;
+    std::getline(file, text);
+    while (std::getline(file, text)) {
+        std::istringstream line(text);
+        std::string key;
+        if (!(line >> key)) {
+            continue;
+        }
+
+        bool ok = true;
+        if (key == "source") {
+            std::string name;
+            ok = static_cast<bool>(line >> name);
+            source = (name == getSourceName(Source::GAME)) ? Source::GAME : Source::SIMULATION;
+        } else if (key == "step") {
+            ok = readFloat(line, fixedTimeStep);
+        } else if (key == "lane") {
+            std::string name;
+            ok = static_cast<bool>(line >> name);
+            laneCollider = (name == "mesh") ? LaneColliderType::MESH : LaneColliderType::ANALYTIC;
+        } else if (key == "ccd") {
+            int flag = 0;
+            ok = static_cast<bool>(line >> flag);
+            ccdEnabled = flag != 0;
+        } else if (key == "mt") {
+            int flag = 0;
+            ok = static_cast<bool>(line >> flag);
+            multithreaded = flag != 0;
+        } else if (key == "oil") {
+            size_t floatCount = 0;
+            ok = static_cast<bool>(line >> floatCount) &&
+                 (floatCount == 0 || floatCount == static_cast<size_t>(LaneFrictionField::ROW_COUNT * LaneFrictionField::BOARD_COUNT));
+            oilFriction.resize(ok ? floatCount : 0);
+            for (size_t i = 0; ok && i < floatCount; ++i) {
+                ok = readFloat(line, oilFriction[i]);
+            }
+        } else if (key == "oilname") {
+            std::getline(line >> std::ws, oilPatternName);
+        } else if (key == "ground") {
+            float values[12];
+            for (int i = 0; ok && i < 12; ++i) {
+                ok = readFloat(line, values[i]);
+            }
+            ok = ok && readFloat(line, ground.friction) && readFloat(line, ground.restitution) &&
+                 readFloat(line, ground.rollingFriction) && readFloat(line, ground.spinningFriction) &&
+                 static_cast<bool>(line >> ground.filterGroup >> ground.filterMask) && readShape(line, ground.shape);
+            if (ok) {
+                ground.transform.setBasis(btMatrix3x3(values[0], values[1], values[2], values[3], values[4], values[5],
+                                                      values[6], values[7], values[8]));
+                ground.transform.setOrigin(btVector3(values[9], values[10], values[11]));
+            }
+        } else if (key == "lanemesh") {
+            std::string hashText;
+            ok = static_cast<bool>(line >> hashText);
+            if (ok) {
+                char* end = nullptr;
+                laneMeshHash = std::strtoull(hashText.c_str(), &end, 16);
+                ok = *end == '\0' && laneMeshHash != 0;
+                std::getline(line >> std::ws, laneMeshName);
+                ok = ok && !laneMeshName.empty();
+            }
+        } else if (key == "pinshape") {
+            ok = readShape(line, pinShape);
+        } else if (key == "ballshape") {
+            ok = readShape(line, ballShape);
+        } else if (key == "frames") {
+            Event event;
+            event.type = EventType::FRAMES;
+            ok = static_cast<bool>(line >> event.count >> event.steps) && event.count > 0 && event.steps >= 0;
+            if (ok) {
+                events.push_back(event);
+            }
+        } else if (key == "launch") {
+            Event event;
+            event.type = EventType::LAUNCH;
+            ok = readFloat(line, event.direction.x) && readFloat(line, event.direction.y) &&
+                 readFloat(line, event.direction.z) && readFloat(line, event.power) && readFloat(line, event.spin);
+            if (ok) {
+                events.push_back(event);
+            }
+        } else if (key == "capture") {
+            addEvent(EventType::CAPTURE);
+        } else if (key == "retry") {
+            addEvent(EventType::RETRY);
+        } else if (key == "scored") {
+            addEvent(EventType::SCORE);
+        } else if (key == "resetpins") {
+            addEvent(EventType::RESET_PINS);
+        } else if (key == "resetball") {
+            addEvent(EventType::RESET_BALL);
+        } else if (key == "newgame") {
+            addEvent(EventType::NEW_GAME);
+        } else if (key == "roll") {
+            Roll roll;
+            size_t floatCount = 0;
+            ok = static_cast<bool>(line >> roll.frame >> roll.rollInFrame) &&
+                 readFloat(line, roll.direction.x) && readFloat(line, roll.direction.y) &&
+                 readFloat(line, roll.direction.z) && readFloat(line, roll.power) && readFloat(line, roll.spin) &&
+                 static_cast<bool>(line >> roll.settleStep >> roll.pinsThisRoll >> roll.knockedDownMask >> floatCount);
+            roll.pinStates.resize(ok ? floatCount : 0);
+            for (size_t i = 0; ok && i < floatCount; ++i) {
+                ok = readFloat(line, roll.pinStates[i]);
+            }
+            if (ok) {
+                rolls.push_back(std::move(roll));
+            }
+        } else if (key == "score") {
+            ok = static_cast<bool>(line >> finalScore);
+        }
+
+        if (!ok) {
+            Ogre::LogManager::getSingleton().logWarning("GameReplay::load - ligne invalide dans " + path + " : " + text);
+            return false;
+        }
+    }
+    return true;
+}
+
+GameReplay::Comparison GameReplay::compare(const GameReplay& other) const {
+    Comparison result;
+    result.configurationMatches = sameBits(fixedTimeStep, other.fixedTimeStep) &&
+                                  laneCollider == other.laneCollider &&
+                                  ccdEnabled == other.ccdEnabled &&
+                                  multithreaded == other.multithreaded &&
+                                  laneMeshHash == other.laneMeshHash &&
+                                  oilFriction.size() == other.oilFriction.size();
+    for (size_t i = 0; result.configurationMatches && i < oilFriction.size(); ++i) {
+        result.configurationMatches = sameBits(oilFriction[i], other.oilFriction[i]);
+    }
+    result.scoreMismatch = finalScore != other.finalScore;
+
+    size_t count = std::max(rolls.size(), other.rolls.size());
+    for (size_t i = 0; i < count; ++i) {
+        if (i >= rolls.size() || i >= other.rolls.size()) {
+            if (result.firstMismatchRoll < 0) result.firstMismatchRoll = static_cast<int>(i);
+            break;
+        }
+        const Roll& a = rolls[i];
+        const Roll& b = other.rolls[i];
+        if (result.firstMismatchRoll < 0 &&
+            (a.frame != b.frame || a.rollInFrame != b.rollInFrame || a.settleStep != b.settleStep ||
+             a.pinsThisRoll != b.pinsThisRoll || a.knockedDownMask != b.knockedDownMask)) {
+            result.firstMismatchRoll = static_cast<int>(i);
+        }
+
+        bool pinsMatch = a.pinStates.size() == b.pinStates.size();
+        for (size_t p = 0; pinsMatch && p < a.pinStates.size(); ++p) {
+            pinsMatch = sameBits(a.pinStates[p], b.pinStates[p]);
+        }
+        if (!pinsMatch) {
+            ++result.pinStateMismatches;
+        }
+        for (size_t p = 0; p + FLOATS_PER_PIN <= std::min(a.pinStates.size(), b.pinStates.size()); p += FLOATS_PER_PIN) {
+            Ogre::Vector3 offset(a.pinStates[p] - b.pinStates[p], a.pinStates[p + 1] - b.pinStates[p + 1],
+                                 a.pinStates[p + 2] - b.pinStates[p + 2]);
+            result.maxPinDeviation = std::max(result.maxPinDeviation, offset.length());
+        }
+    }
+    return result;
+}
+
+const char* GameReplay::getSourceName(Source source) {
+    return source == Source::GAME ? "game" : "simulation";
+}
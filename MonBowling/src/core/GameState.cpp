@@ -0,0 +1,19 @@
+#include "../../include/core/GameState.h"
+
+static const char* const STATE_NAMES[GAME_STATE_COUNT] = {
+    "AIMING", "POWER", "ROLLING", "SCORING", "GAME_OVER"
+};
+
+static const char* const EVENT_NAMES[GAME_EVENT_COUNT] = {
+    "CHARGE", "LAUNCH", "ROLL_SETTLED", "ROLL_SCORED", "RETRY", "RESET"
+};
+
+const char* toString(GameState state) {
+    int index = static_cast<int>(state);
+    return index >= 0 && index < GAME_STATE_COUNT ? STATE_NAMES[index] : "UNKNOWN";
+}
+
+const char* toString(GameEvent event) {
+    int index = static_cast<int>(event);
+    return index >= 0 && index < GAME_EVENT_COUNT ? EVENT_NAMES[index] : "UNKNOWN";
+}
@@ -0,0 +1,124 @@
+#include "../../include/core/GameStateMachine.h"
+#include <algorithm>
+
+// Déroulement d'une partie : visée, puissance, roulement, comptage, jusqu'à la 10e frame
+static const GameTransition BOWLING_FLOW[] = {
+    {GameState::AIMING,    GameEvent::CHARGE,       GameGuard::NONE,          GameState::POWER,     false},
+    {GameState::POWER,     GameEvent::LAUNCH,       GameGuard::CAN_LAUNCH,    GameState::ROLLING,   false},
+    {GameState::ROLLING,   GameEvent::ROLL_SETTLED, GameGuard::NONE,          GameState::SCORING,   false},
+    {GameState::ROLLING,   GameEvent::RETRY,        GameGuard::NONE,          GameState::ROLLING,   true},
+    {GameState::SCORING,   GameEvent::ROLL_SCORED,  GameGuard::GAME_FINISHED, GameState::GAME_OVER, false},
+    {GameState::SCORING,   GameEvent::ROLL_SCORED,  GameGuard::NONE,          GameState::AIMING,    false},
+    // Nouvelle partie depuis n'importe quel état (y compris AIMING : l'entrée est rejouée)
+    {GameState::AIMING,    GameEvent::RESET,        GameGuard::NONE,          GameState::AIMING,    false},
+    {GameState::POWER,     GameEvent::RESET,        GameGuard::NONE,          GameState::AIMING,    false},
+    {GameState::ROLLING,   GameEvent::RESET,        GameGuard::NONE,          GameState::AIMING,    false},
+    {GameState::SCORING,   GameEvent::RESET,        GameGuard::NONE,          GameState::AIMING,    false},
+    {GameState::GAME_OVER, GameEvent::RESET,        GameGuard::NONE,          GameState::AIMING,    false}
+};
+
+static size_t slotIndex(GameState state, GameEvent event) {
+    return static_cast<size_t>(state) * GAME_EVENT_COUNT + static_cast<size_t>(event);
+}
+
+GameStateMachine::GameStateMachine(GameState initial)
+    : GameStateMachine(BOWLING_FLOW, sizeof(BOWLING_FLOW) / sizeof(BOWLING_FLOW[0]), initial)
+{}
+
+GameStateMachine::GameStateMachine(const GameTransition* table, size_t count, GameState initial)
+    : mTransitions(table, table + count),
+      mState(initial),
+      mHandler(nullptr),
+      mQueueHead(0),
+      mQueueCount(0),
+      mDroppedEvents(0),
+      mDispatching(false)
+{
+    // Regroupe les lignes de chaque couple (état, événement) sans changer leur ordre relatif
+    std::stable_sort(mTransitions.begin(), mTransitions.end(),
+        [](const GameTransition& a, const GameTransition& b) {
+            return slotIndex(a.from, a.event) < slotIndex(b.from, b.event);
+        });
+
+    mSlots.fill(Slot{0, 0});
+    for (size_t i = 0; i < mTransitions.size(); ++i) {
+        Slot& slot = mSlots[slotIndex(mTransitions[i].from, mTransitions[i].event)];
+        if (slot.count == 0) {
+            slot.first = static_cast<uint8_t>(i);
+        }
+        ++slot.count;
+    }
+}
+
+bool GameStateMachine::post(GameEvent event) {
+    if (mQueueCount == QUEUE_CAPACITY) {
+        ++mDroppedEvents;
+        return false;
+    }
+    mQueue[(mQueueHead + mQueueCount) % QUEUE_CAPACITY] = event;
+    ++mQueueCount;
+    return true;
+}
+
+int GameStateMachine::dispatch() {
+    if (mDispatching) {
+        return 0;
+    }
+    mDispatching = true;
+
+    // Borne : des actions qui se repostent sans fin ne bloquent pas la frame
+    int budget = static_cast<int>(QUEUE_CAPACITY) * 4;
+    int taken = 0;
+    while (mQueueCount > 0 && budget-- > 0) {
+        GameEvent event = mQueue[mQueueHead];
+        mQueueHead = (mQueueHead + 1) % QUEUE_CAPACITY;
+        --mQueueCount;
+        if (process(event)) {
+            ++taken;
+        }
+    }
+
+    mDispatching = false;
+    return taken;
+}
+
+int GameStateMachine::fire(GameEvent event) {
+    post(event);
+    return dispatch();
+}
+
+void GameStateMachine::setState(GameState state) {
+    mState = state;
+    mQueueHead = 0;
+    mQueueCount = 0;
+}
+
+bool GameStateMachine::process(GameEvent event) {
+    const Slot& slot = mSlots[slotIndex(mState, event)];
+    for (int i = 0; i < slot.count; ++i) {
+        const GameTransition& transition = mTransitions[slot.first + i];
+        if (transition.guard == GameGuard::NONE || (mHandler && mHandler->checkGuard(transition.guard))) {
+            take(transition);
+            return true;
+        }
+    }
+    return false;
+}
+
+void GameStateMachine::take(const GameTransition& transition) {
+    if (transition.internal) {
+        if (mHandler) {
+            mHandler->onTransition(transition.from, transition.event, transition.to);
+        }
+        return;
+    }
+
+    if (mHandler) {
+        mHandler->onExit(transition.from);
+    }
+    mState = transition.to;
+    if (mHandler) {
+        mHandler->onTransition(transition.from, transition.event, transition.to);
+        mHandler->onEnter(transition.to);
+    }
+}
@@ -0,0 +1,107 @@
+#include "../../include/core/LaneHost.h"
+#include <OgreLogManager.h>
+#include <algorithm>
+
+LaneHost::LaneHost(int laneCount, unsigned int threadCount)
+    : mJob(nullptr),
+      mJobGeneration(0),
+      mBusyWorkers(0),
+      mStopping(false),
+      mNextSession(0)
+{
+    for (int lane = 1; lane <= laneCount; ++lane) {
+        mSessions.push_back(std::make_unique<LaneSession>(lane));
+    }
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threadCount = std::min(threadCount, static_cast<unsigned int>(std::max(1, laneCount)));
+    for (unsigned int i = 1; i < threadCount; ++i) {
+        mWorkers.emplace_back(&LaneHost::workerLoop, this);
+    }
+
+    Ogre::LogManager::getSingleton().logMessage("LaneHost: " + std::to_string(laneCount) + " pistes, " +
+                                                std::to_string(threadCount) + " threads");
+}
+
+LaneHost::~LaneHost() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopping = true;
+    }
+    mWorkReady.notify_all();
+    for (auto& worker : mWorkers) {
+        worker.join();
+    }
+    // Les sessions (et leurs mondes) sont détruites sur le thread appelant, pool arrêté
+    mSessions.clear();
+}
+
+void LaneHost::initialize() {
+    forEachSession([](LaneSession& session) {
+        session.initialize();
+    });
+}
+
+void LaneHost::forEachSession(const Job& job) {
+    if (mWorkers.empty()) {
+        for (auto& session : mSessions) {
+            job(*session);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJob = &job;
+        mNextSession.store(0, std::memory_order_relaxed);
+        mBusyWorkers = mWorkers.size();
+        ++mJobGeneration;
+    }
+    mWorkReady.notify_all();
+
+    runJob(job);
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mWorkDone.wait(lock, [this] { return mBusyWorkers == 0; });
+    mJob = nullptr;
+}
+
+long LaneHost::update(int steps) {
+    std::atomic<long> simulated(0);
+    forEachSession([&](LaneSession& session) {
+        simulated.fetch_add(session.advance(steps), std::memory_order_relaxed);
+    });
+    return simulated.load();
+}
+
+void LaneHost::runJob(const Job& job) {
+    const size_t count = mSessions.size();
+    for (size_t index = mNextSession.fetch_add(1); index < count; index = mNextSession.fetch_add(1)) {
+        job(*mSessions[index]);
+    }
+}
+
+void LaneHost::workerLoop() {
+    unsigned long seenGeneration = 0;
+    for (;;) {
+        const Job* job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWorkReady.wait(lock, [&] { return mStopping || mJobGeneration != seenGeneration; });
+            if (mStopping) {
+                return;
+            }
+            seenGeneration = mJobGeneration;
+            job = mJob;
+        }
+
+        runJob(*job);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (--mBusyWorkers == 0) {
+            mWorkDone.notify_one();
+        }
+    }
+}
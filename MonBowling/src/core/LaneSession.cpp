@@ -0,0 +1,88 @@
+#include "../../include/core/LaneSession.h"
+
+LaneSession::LaneSession(int laneNumber)
+    : mSimulation(&mPhysics, &mScores),
+      mStateMachine(GameState::AIMING),
+      mLaneNumber(laneNumber),
+      mLaunchDirection(Ogre::Vector3::ZERO),
+      mLaunchPower(0.0f),
+      mLaunchSpin(0.0f),
+      mRolls(0),
+      mGames(0)
+{
+    mStateMachine.setHandler(this);
+}
+
+LaneSession::~LaneSession() {}
+
+void LaneSession::initialize() {
+    mSimulation.initialize();
+    resetGame();
+}
+
+void LaneSession::resetGame() {
+    mStateMachine.fire(GameEvent::RESET);
+}
+
+bool LaneSession::launch(const Ogre::Vector3& direction, float power, float spin) {
+    if (!mStateMachine.isIn(GameState::AIMING)) {
+        return false;
+    }
+    mLaunchDirection = direction;
+    mLaunchPower = power;
+    mLaunchSpin = spin;
+    // Pas de phase de puissance : les deux événements dans la même file
+    mStateMachine.post(GameEvent::CHARGE);
+    mStateMachine.post(GameEvent::LAUNCH);
+    mStateMachine.dispatch();
+    return mStateMachine.isIn(GameState::ROLLING);
+}
+
+int LaneSession::advance(int steps) {
+    int simulated = 0;
+    while (mStateMachine.isIn(GameState::ROLLING) && simulated < steps) {
+        ++simulated;
+        if (mSimulation.stepThrow()) {
+            // SCORING compte le lancer, puis AIMING ou GAME_OVER dans le même dispatch
+            mStateMachine.fire(GameEvent::ROLL_SETTLED);
+        }
+    }
+    return simulated;
+}
+
+bool LaneSession::checkGuard(GameGuard guard) {
+    switch (guard) {
+        case GameGuard::GAME_FINISHED: return mLastRoll.gameOver;
+        case GameGuard::CAN_LAUNCH: return mSimulation.getBall() != nullptr;
+        default: return true;
+    }
+}
+
+void LaneSession::onTransition(GameState from, GameEvent event, GameState to) {
+    switch (event) {
+        case GameEvent::LAUNCH:
+            mSimulation.startThrow(mLaunchDirection, mLaunchPower, mLaunchSpin);
+            break;
+        case GameEvent::RESET:
+            mSimulation.resetGame();
+            mLastRoll = RollResult();
+            break;
+        default:
+            break;
+    }
+}
+
+void LaneSession::onEnter(GameState state) {
+    switch (state) {
+        case GameState::SCORING:
+            mLastRoll = mSimulation.finishRoll();
+            ++mRolls;
+            mStateMachine.post(GameEvent::ROLL_SCORED);
+            break;
+        case GameState::GAME_OVER:
+            ++mGames;
+            break;
+        default:
+            break;
+    }
+}
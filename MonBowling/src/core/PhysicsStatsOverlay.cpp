@@ -0,0 +1,100 @@
+#include "../../include/core/PhysicsStatsOverlay.h"
+#include "../../include/managers/PhysicsManager.h"
+#include <OgreOverlayManager.h>
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+PhysicsStatsOverlay::PhysicsStatsOverlay(PhysicsManager* physics)
+    : physicsManager(physics ? physics : PhysicsManager::getInstance()),
+      overlay(nullptr),
+      panel(nullptr),
+      text(nullptr),
+      peakWindow(1.0f),
+      peakElapsed(0.0f),
+      peakTotalMs(0.0),
+      displayedPeakMs(0.0)
+{}
+
+PhysicsStatsOverlay::~PhysicsStatsOverlay() {
+    if (overlay) {
+        Ogre::OverlayManager::getSingleton().destroy(overlay);
+    }
+}
+
+void PhysicsStatsOverlay::initialize() {
+    Ogre::OverlayManager& overlayManager = Ogre::OverlayManager::getSingleton();
+
+    overlay = overlayManager.create("PhysicsStatsOverlay");
+
+    panel = static_cast<Ogre::OverlayContainer*>(
+        overlayManager.createOverlayElement("Panel", "PhysicsStatsPanel"));
+    panel->setMetricsMode(Ogre::GMM_PIXELS);
+    panel->setPosition(20, 60);
+    panel->setDimensions(320, 200);
+    panel->setMaterialName("UI/OverlayBackground");
+
+    text = static_cast<Ogre::TextAreaOverlayElement*>(
+        overlayManager.createOverlayElement("TextArea", "PhysicsStatsText"));
+    text->setMetricsMode(Ogre::GMM_PIXELS);
+    text->setPosition(8, 6);
+    text->setDimensions(304, 188);
+    text->setCharHeight(16);
+    text->setFontName("Arial");
+    text->setColour(Ogre::ColourValue::White);
+    text->setCaption("");
+
+    panel->addChild(text);
+    overlay->add2D(panel);
+    overlay->setZOrder(600);  // Au-dessus de l'interface de jeu
+    overlay->hide();
+}
+
+void PhysicsStatsOverlay::setVisible(bool visible) {
+    if (!overlay) {
+        return;
+    }
+    if (visible) {
+        physicsManager->getProfiler().setEnabled(true);
+        overlay->show();
+    } else {
+        // Le profileur reste actif s'il alimente un fichier
+        if (!physicsManager->getProfiler().isDumping()) {
+            physicsManager->getProfiler().setEnabled(false);
+        }
+        overlay->hide();
+    }
+}
+
+bool PhysicsStatsOverlay::isVisible() const {
+    return overlay && overlay->isVisible();
+}
+
+void PhysicsStatsOverlay::update(float deltaTime) {
+    if (!isVisible()) {
+        return;
+    }
+
+    const PhysicsFrameStats& stats = physicsManager->getLastFrameStats();
+
+    peakTotalMs = std::max(peakTotalMs, stats.totalMs);
+    peakElapsed += deltaTime;
+    if (peakElapsed >= peakWindow) {
+        displayedPeakMs = peakTotalMs;
+        peakTotalMs = 0.0;
+        peakElapsed = 0.0f;
+    }
+
+    std::ostringstream caption;
+    caption << std::fixed << std::setprecision(2)
+            << "Physique  frame " << stats.frame << "  (" << stats.steps << " pas)\n"
+            << "total       " << stats.totalMs << " ms  (pic 1 s : " << displayedPeakMs << ")\n"
+            << "broadphase  " << stats.broadphaseMs << " ms\n"
+            << "narrowphase " << stats.narrowphaseMs << " ms\n"
+            << "solveur     " << stats.solverMs << " ms\n"
+            << "integration " << stats.integrationMs << " ms\n"
+            << "corps " << stats.activeBodies << "/" << stats.bodies << " actifs, " << stats.islands << " ilots\n"
+            << "paires " << stats.overlappingPairs << ", manifolds " << stats.manifolds
+            << ", contacts " << stats.contactPoints;
+    text->setCaption(caption.str());
+}
@@ -0,0 +1,190 @@
+#include "../../include/core/TrajectoryPredictor.h"
+#include "../../include/managers/PhysicsManager.h"
+#include "../../include/objects/BowlingLane.h"
+#include <OgreLogManager.h>
+
+// Durée maximale d'un lancer fantôme (la boule la plus lente met environ 2 s jusqu'aux quilles)
+static const float MAX_PREDICTION_TIME = 4.0f;
+// Distance entre deux points de la polyligne (une centaine de points sur toute la piste)
+static const float SAMPLE_SPACING = 0.2f;
+// Arrêt : boule quasi immobile, ou tombée dans la fosse
+static const float STOP_SPEED = 0.05f;
+static const float FALLEN_HEIGHT = -0.2f;
+
+TrajectoryPredictor::TrajectoryPredictor()
+    : mBallStart(Ogre::Vector3::ZERO),
+      mLaneMeshShape(nullptr),
+      mLaneFriction(0.0f),
+      mLaneRollingFriction(0.0f),
+      mOilPatternEnabled(false),
+      mTickRate(60.0f),
+      mStopping(false),
+      mGeneration(0),
+      mRequest{Ogre::Vector3::NEGATIVE_UNIT_Z, 0.0f, 0.0f},
+      mHasRequest(false),
+      mResultGeneration(0),
+      mHasResult(false)
+{}
+
+TrajectoryPredictor::~TrajectoryPredictor() {
+    stop();
+}
+
+void TrajectoryPredictor::start(const Ogre::Vector3& ballStart, const BowlingBall& ball, const BowlingLane& lane,
+                                float tickRate) {
+    stop();
+
+    // Copies : le thread ne lit plus rien du jeu une fois lancé, sauf la forme maillée
+    // (immuable). Le motif est copié déjà placé sur le plateau de la piste du jeu.
+    mBallStart = ballStart;
+    mBallProperties = ball.getBodyProperties();
+    mBallCcdProfile = ball.getCcdProfile();
+    mLaneDefinition = lane.getLaneDefinition();
+    mLaneMeshShape = nullptr;
+    mLaneFriction = mLaneDefinition.friction;
+    mLaneRollingFriction = mLaneDefinition.rollingFriction;
+    if (const btRigidBody* laneBody = lane.getLaneBody()) {
+        const btCollisionShape* shape = laneBody->getCollisionShape();
+        if (lane.getColliderType() == LaneColliderType::MESH && shape->getShapeType() == TRIANGLE_MESH_SHAPE_PROXYTYPE) {
+            mLaneMeshShape = const_cast<btBvhTriangleMeshShape*>(static_cast<const btBvhTriangleMeshShape*>(shape));
+        }
+        mLaneFriction = laneBody->getFriction();
+        mLaneRollingFriction = laneBody->getRollingFriction();
+    }
+    mOilPatternEnabled = lane.hasOilPattern();
+    if (mOilPatternEnabled) {
+        mOilPattern = lane.getOilPattern();
+    }
+    mTickRate = tickRate;
+
+    mStopping = false;
+    mHasRequest = false;
+    mHasResult = false;
+    mWorker = std::thread(&TrajectoryPredictor::run, this);
+}
+
+void TrajectoryPredictor::stop() {
+    if (!mWorker.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mRequestMutex);
+        mStopping = true;
+    }
+    mRequestReady.notify_one();
+    mWorker.join();
+}
+
+void TrajectoryPredictor::request(const Ogre::Vector3& direction, float power, float spin) {
+    {
+        std::lock_guard<std::mutex> lock(mRequestMutex);
+        mRequest = {direction, power, spin};
+        mHasRequest = true;
+        ++mGeneration;
+    }
+    mRequestReady.notify_one();
+}
+
+void TrajectoryPredictor::cancel() {
+    std::lock_guard<std::mutex> lock(mRequestMutex);
+    mHasRequest = false;
+    ++mGeneration;
+}
+
+bool TrajectoryPredictor::poll(std::vector<Ogre::Vector3>& path) {
+    std::unique_lock<std::mutex> lock(mResultMutex, std::try_to_lock);
+    if (!lock.owns_lock() || !mHasResult) {
+        return false;
+    }
+    mHasResult = false;
+    // Trajectoire d'une demande remplacée ou annulée depuis : ignorée
+    if (mResultGeneration != mGeneration.load()) {
+        return false;
+    }
+    path.swap(mResult);
+    return true;
+}
+
+void TrajectoryPredictor::run() {
+    // Monde fantôme : pas de rendu, même fréquence de pas que le jeu
+    PhysicsManager physics;
+    physics.setTickRate(mTickRate);
+    physics.initialize(nullptr);
+
+    // Même collider que la piste du jeu (à l'origine dans les deux cas, voir BowlingLane::createLane)
+    btTransform laneTransform;
+    laneTransform.setIdentity();
+    btRigidBody* laneBody = mLaneMeshShape
+        ? physics.addSharedShapeRigidBody(0.0f, mLaneMeshShape, laneTransform)
+        : physics.addPrimitiveRigidBody(0.0f, buildAnalyticLaneShape(mLaneDefinition), laneTransform);
+    PhysicsManager::setBodyRole(laneBody, BodyRole::LANE);
+    laneBody->setFriction(mLaneFriction);
+    laneBody->setRollingFriction(mLaneRollingFriction);
+    if (mOilPatternEnabled) {
+        PhysicsManager::setLaneFrictionField(laneBody, &mOilPattern);
+    }
+
+    {
+        // Même corps que la boule du jeu (sphère ajustée au mesh, pas la sphère nominale)
+        BowlingBall ball(nullptr, "ball.mesh", &physics);
+        ball.setBodyProperties(mBallProperties);
+        ball.setCcdProfile(mBallCcdProfile);
+        ball.create(mBallStart);
+
+        std::vector<Ogre::Vector3> path;
+        while (true) {
+            Request current;
+            unsigned int generation;
+            {
+                std::unique_lock<std::mutex> lock(mRequestMutex);
+                mRequestReady.wait(lock, [this] { return mStopping || mHasRequest; });
+                if (mStopping) {
+                    break;
+                }
+                current = mRequest;
+                generation = mGeneration.load();
+                mHasRequest = false;
+            }
+
+            if (!simulate(physics, ball, current, generation, path)) {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(mResultMutex);
+            mResult.swap(path);
+            mResultGeneration = generation;
+            mHasResult = true;
+        }
+    }
+
+    physics.removeRigidBody(laneBody);
+}
+
+bool TrajectoryPredictor::simulate(PhysicsManager& physics, BowlingBall& ball, const Request& request,
+                                   unsigned int generation, std::vector<Ogre::Vector3>& path) {
+    ball.reset();
+    ball.launch(request.direction, request.power, request.spin);
+
+    path.clear();
+    path.push_back(ball.getPosition());
+
+    const int maxSteps = static_cast<int>(MAX_PREDICTION_TIME * mTickRate);
+    for (int i = 0; i < maxSteps; ++i) {
+        // Annulation vérifiée à chaque pas : une nouvelle demande repart au plus un pas plus tard
+        if (mStopping || mGeneration.load(std::memory_order_relaxed) != generation) {
+            return false;
+        }
+        physics.step();
+
+        Ogre::Vector3 position = ball.getPosition();
+        bool stopped = position.z <= mLaneDefinition.deckEndZ ||
+                       position.y < FALLEN_HEIGHT ||
+                       ball.getVelocity().squaredLength() < STOP_SPEED * STOP_SPEED;
+        if (stopped || position.squaredDistance(path.back()) >= SAMPLE_SPACING * SAMPLE_SPACING) {
+            path.push_back(position);
+        }
+        if (stopped) {
+            break;
+        }
+    }
+    return true;
+}
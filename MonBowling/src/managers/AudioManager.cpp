@@ -108,7 +108,7 @@ bool AudioManager::loadSound(const std::string& fileName, const std::string& sou
     }
 }
 
-void AudioManager::playSound(const std::string& soundName) {
+void AudioManager::playSound(const std::string& soundName, float volume) {
     if (!mFMODSystem) return;
 
     auto it = mSounds.find(soundName);
@@ -119,7 +119,12 @@ void AudioManager::playSound(const std::string& soundName) {
 
     FMOD::Channel* channel = nullptr;
     // Jouer le son. Le canal peut être récupéré si on a besoin de le contrôler plus tard.
-    FMOD_RESULT result = mFMODSystem->playSound(it->second, nullptr, false, &channel);
+    // Démarré en pause pour régler le volume avant le premier échantillon.
+    FMOD_RESULT result = mFMODSystem->playSound(it->second, nullptr, true, &channel);
+    if (result == FMOD_OK && channel) {
+        channel->setVolume(volume);
+        result = channel->setPaused(false);
+    }
 
     if (FMODErrorCheck(result)) {
         // Stocker le canal si on a besoin de le contrôler (ex: arrêt d'une boucle)
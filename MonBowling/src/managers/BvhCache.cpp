@@ -0,0 +1,486 @@
+#include "../../include/managers/BvhCache.h"
+#include "../../include/managers/ImpactEvent.h"
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace fs = std::filesystem;
+
+// Version du format de fichier : à incrémenter si l'en-tête ou l'extraction des triangles change
+// (2 : triangles enregistrés après l'en-tête)
+static const uint32_t BVH_CACHE_VERSION = 2;
+static const uint32_t ENDIAN_MARKER = 0x01020304u;
+// Classement des triangles : composante verticale minimale de la normale d'un triangle
+// horizontal, pas de l'histogramme des hauteurs et tolérance autour du plateau (m)
+static const float HORIZONTAL_NORMAL_Y = 0.95f;
+static const float HEIGHT_BUCKET = 0.01f;
+static const float DECK_TOLERANCE = 0.02f;
+
+struct BvhFileHeader {
+    char magic[4];              // "MBVH"
+    uint32_t version;
+    uint32_t bulletVersion;
+    uint32_t pointerSize;
+    uint32_t scalarSize;
+    uint32_t endianMarker;
+    uint64_t meshHash;
+    uint32_t triangleCount;
+    uint32_t bufferSize;
+    uint32_t vertexCount;
+    float scale[3];             // Échelle appliquée aux sommets (entre dans l'empreinte)
+};
+// Suivent les sommets (3 float chacun), les indices (3 int par triangle) puis la BVH
+
+BvhCache::Entry::~Entry(){
+    // La forme référence l'interface et la BVH : détruite en premier
+    shape.reset();
+    meshInterface.reset();
+    if (bvhBuffer){
+        btAlignedFree(bvhBuffer);
+    }
+}
+
+BvhCache::BvhCache(const std::string& directory)
+    : mDirectory(directory),
+      mDiskCacheEnabled(true),
+      mLastLoadedFromDisk(false),
+      mLastLoadMs(0.0)
+{}
+
+BvhCache::~BvhCache() {}
+
+void BvhCache::collectTriangles(const Ogre::MeshPtr& mesh, const Ogre::Vector3& scale,
+                                std::vector<float>& vertices, std::vector<int>& indices){
+    vertices.clear();
+    indices.clear();
+
+    // Ajoute les positions d'un tampon de sommets ; retourne l'indice du premier sommet ajouté
+    auto addVertexData = [&](const Ogre::VertexData* data) -> int {
+        int base = static_cast<int>(vertices.size() / 3);
+        const Ogre::VertexElement* position = data->vertexDeclaration->findElementBySemantic(Ogre::VES_POSITION);
+        if (!position){
+            return base;
+        }
+        Ogre::HardwareVertexBufferSharedPtr buffer = data->vertexBufferBinding->getBuffer(position->getSource());
+        Ogre::HardwareBufferLockGuard lock(buffer, Ogre::HardwareBuffer::HBL_READ_ONLY);
+
+        const size_t stride = buffer->getVertexSize();
+        unsigned char* vertex = static_cast<unsigned char*>(lock.pData) + data->vertexStart * stride;
+        for (size_t i = 0; i < data->vertexCount; ++i, vertex += stride){
+            float* xyz;
+            position->baseVertexPointerToElement(vertex, &xyz);
+            vertices.push_back(xyz[0] * scale.x);
+            vertices.push_back(xyz[1] * scale.y);
+            vertices.push_back(xyz[2] * scale.z);
+        }
+        return base;
+    };
+
+    int sharedBase = -1;
+    for (const Ogre::SubMesh* subMesh : mesh->getSubMeshes()){
+        if (subMesh->operationType != Ogre::RenderOperation::OT_TRIANGLE_LIST){
+            continue;
+        }
+
+        int base;
+        size_t vertexCount;
+        if (subMesh->useSharedVertices){
+            if (!mesh->sharedVertexData) continue;
+            if (sharedBase < 0){
+                sharedBase = addVertexData(mesh->sharedVertexData);
+            }
+            base = sharedBase;
+            vertexCount = mesh->sharedVertexData->vertexCount;
+        }
+        else{
+            if (!subMesh->vertexData) continue;
+            base = addVertexData(subMesh->vertexData);
+            vertexCount = subMesh->vertexData->vertexCount;
+        }
+
+        const Ogre::IndexData* indexData = subMesh->indexData;
+        if (!indexData || !indexData->indexBuffer || indexData->indexCount == 0){
+            // Sous-mesh sans indices : sommets pris dans l'ordre
+            for (size_t i = 0; i + 2 < vertexCount; i += 3){
+                indices.push_back(base + static_cast<int>(i));
+                indices.push_back(base + static_cast<int>(i + 1));
+                indices.push_back(base + static_cast<int>(i + 2));
+            }
+            continue;
+        }
+
+        Ogre::HardwareIndexBufferSharedPtr buffer = indexData->indexBuffer;
+        Ogre::HardwareBufferLockGuard lock(buffer, Ogre::HardwareBuffer::HBL_READ_ONLY);
+        const size_t count = indexData->indexCount - indexData->indexCount % 3;
+        if (buffer->getType() == Ogre::HardwareIndexBuffer::IT_32BIT){
+            const uint32_t* source = static_cast<const uint32_t*>(lock.pData) + indexData->indexStart;
+            for (size_t i = 0; i < count; ++i) indices.push_back(base + static_cast<int>(source[i]));
+        }
+        else{
+            const uint16_t* source = static_cast<const uint16_t*>(lock.pData) + indexData->indexStart;
+            for (size_t i = 0; i < count; ++i) indices.push_back(base + static_cast<int>(source[i]));
+        }
+    }
+}
+
+void BvhCache::classifyLaneTriangles(const std::vector<float>& vertices, const std::vector<int>& indices,
+                                     std::vector<uint8_t>& parts){
+    const size_t triangleCount = indices.size() / 3;
+    auto corner = [&](size_t triangle, int k){
+        const float* v = &vertices[3 * static_cast<size_t>(indices[3 * triangle + k])];
+        return btVector3(v[0], v[1], v[2]);
+    };
+
+    // Aire des triangles horizontaux par hauteur : le plateau est la plus grande
+    std::map<long, float> areaByHeight;
+    std::vector<bool> horizontal(triangleCount, false);
+    for (size_t t = 0; t < triangleCount; ++t){
+        btVector3 a = corner(t, 0), b = corner(t, 1), c = corner(t, 2);
+        btVector3 normal = (b - a).cross(c - a);
+        float doubleArea = normal.length();
+        if (doubleArea <= 0.0f){
+            continue;
+        }
+        horizontal[t] = std::fabs(normal.y()) >= HORIZONTAL_NORMAL_Y * doubleArea;
+        if (horizontal[t]){
+            float height = (a.y() + b.y() + c.y()) / 3.0f;
+            areaByHeight[std::lround(height / HEIGHT_BUCKET)] += 0.5f * doubleArea;
+        }
+    }
+
+    parts.assign(triangleCount, static_cast<uint8_t>(LanePart::DECK));
+    if (areaByHeight.empty()){
+        return;
+    }
+    auto deck = std::max_element(areaByHeight.begin(), areaByHeight.end(),
+        [](const std::pair<const long, float>& a, const std::pair<const long, float>& b){ return a.second < b.second; });
+    const float deckHeight = deck->first * HEIGHT_BUCKET;
+
+    // Plateau, puis étendue en z du plateau pour séparer gouttières et fosse
+    float deckMinZ = std::numeric_limits<float>::max();
+    float deckMaxZ = -std::numeric_limits<float>::max();
+    std::vector<float> centroidY(triangleCount), centroidZ(triangleCount);
+    for (size_t t = 0; t < triangleCount; ++t){
+        btVector3 a = corner(t, 0), b = corner(t, 1), c = corner(t, 2);
+        centroidY[t] = (a.y() + b.y() + c.y()) / 3.0f;
+        centroidZ[t] = (a.z() + b.z() + c.z()) / 3.0f;
+        if (horizontal[t] && std::fabs(centroidY[t] - deckHeight) <= DECK_TOLERANCE){
+            deckMinZ = std::min({deckMinZ, a.z(), b.z(), c.z()});
+            deckMaxZ = std::max({deckMaxZ, a.z(), b.z(), c.z()});
+        }
+    }
+    for (size_t t = 0; t < triangleCount; ++t){
+        LanePart part;
+        if (horizontal[t] && std::fabs(centroidY[t] - deckHeight) <= DECK_TOLERANCE){
+            part = LanePart::DECK;
+        }
+        else if (centroidY[t] < deckHeight - DECK_TOLERANCE){
+            part = centroidZ[t] < deckMinZ || centroidZ[t] > deckMaxZ ? LanePart::PIT : LanePart::GUTTER;
+        }
+        else{
+            part = LanePart::WALL;
+        }
+        parts[t] = static_cast<uint8_t>(part);
+    }
+}
+
+bool BvhCache::findDeckExtent(const btBvhTriangleMeshShape* shape, float z, float& minX, float& maxX) const{
+    for (const auto& item : mEntries){
+        const Entry& entry = *item.second;
+        if (entry.shape.get() != shape){
+            continue;
+        }
+        minX = std::numeric_limits<float>::max();
+        maxX = -std::numeric_limits<float>::max();
+        for (size_t t = 0; t < entry.triangleParts.size(); ++t){
+            if (entry.triangleParts[t] != static_cast<uint8_t>(LanePart::DECK)){
+                continue;
+            }
+            const float* v[3];
+            for (int k = 0; k < 3; ++k) v[k] = &entry.vertices[3 * static_cast<size_t>(entry.indices[3 * t + k])];
+            if (z < std::min({v[0][2], v[1][2], v[2][2]}) || z > std::max({v[0][2], v[1][2], v[2][2]})){
+                continue;
+            }
+            minX = std::min({minX, v[0][0], v[1][0], v[2][0]});
+            maxX = std::max({maxX, v[0][0], v[1][0], v[2][0]});
+        }
+        return minX < maxX;
+    }
+    return false;
+}
+
+uint64_t BvhCache::hashTriangles(const std::vector<float>& vertices, const std::vector<int>& indices,
+                                 const Ogre::Vector3& scale){
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size){
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i){
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    float scaleValues[3] = {scale.x, scale.y, scale.z};
+    mix(scaleValues, sizeof(scaleValues));
+    mix(vertices.data(), vertices.size() * sizeof(float));
+    mix(indices.data(), indices.size() * sizeof(int));
+    return hash;
+}
+
+std::string BvhCache::makeFilePath(const Ogre::String& meshName, uint64_t hash) const{
+    std::string name = meshName;
+    for (char& c : name){
+        if (!std::isalnum(static_cast<unsigned char>(c))) c = '_';
+    }
+    char hashText[17];
+    std::snprintf(hashText, sizeof(hashText), "%016llx", static_cast<unsigned long long>(hash));
+    return (fs::path(mDirectory) / (name + "_" + hashText + ".bvh")).string();
+}
+
+void BvhCache::buildMeshInterface(Entry& entry){
+    btIndexedMesh part;
+    part.m_numTriangles = static_cast<int>(entry.indices.size() / 3);
+    part.m_triangleIndexBase = reinterpret_cast<const unsigned char*>(entry.indices.data());
+    part.m_triangleIndexStride = 3 * sizeof(int);
+    part.m_numVertices = static_cast<int>(entry.vertices.size() / 3);
+    part.m_vertexBase = reinterpret_cast<const unsigned char*>(entry.vertices.data());
+    part.m_vertexStride = 3 * sizeof(float);
+    part.m_indexType = PHY_INTEGER;
+    part.m_vertexType = PHY_FLOAT;
+    entry.meshInterface = std::make_unique<btTriangleIndexVertexArray>();
+    entry.meshInterface->addIndexedMesh(part, PHY_INTEGER);
+}
+
+btBvhTriangleMeshShape* BvhCache::storeEntry(const std::string& path, std::unique_ptr<Entry> entry){
+    // Parties de piste lues par PhysicsManager à chaque contact (voir l'en-tête)
+    classifyLaneTriangles(entry->vertices, entry->indices, entry->triangleParts);
+    entry->shape->setUserPointer(entry->triangleParts.data());
+    entry->shape->setUserIndex(static_cast<int>(entry->triangleParts.size()));
+
+    btBvhTriangleMeshShape* shape = entry->shape.get();
+    mEntries[path] = std::move(entry);
+    return shape;
+}
+
+btBvhTriangleMeshShape* BvhCache::getTriangleMeshShape(const Ogre::MeshPtr& mesh, const Ogre::Vector3& scale){
+    if (!mesh){
+        return nullptr;
+    }
+    auto start = std::chrono::steady_clock::now();
+
+    std::unique_ptr<Entry> entry = std::make_unique<Entry>();
+    collectTriangles(mesh, scale, entry->vertices, entry->indices);
+    if (entry->indices.empty()){
+        Ogre::LogManager::getSingleton().logError("BvhCache - aucun triangle dans " + mesh->getName());
+        return nullptr;
+    }
+
+    entry->meshName = mesh->getName();
+    entry->hash = hashTriangles(entry->vertices, entry->indices, scale);
+    std::string path = makeFilePath(entry->meshName, entry->hash);
+
+    // Déjà chargée pendant cette exécution (retour à une piste déjà utilisée)
+    auto existing = mEntries.find(path);
+    if (existing != mEntries.end()){
+        mLastLoadedFromDisk = false;
+        mLastLoadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return existing->second->shape.get();
+    }
+
+    buildMeshInterface(*entry);
+    mLastLoadedFromDisk = mDiskCacheEnabled && loadFromDisk(path, *entry);
+    entry->onDisk = mLastLoadedFromDisk;
+    if (!mLastLoadedFromDisk){
+        entry->shape = std::make_unique<btBvhTriangleMeshShape>(entry->meshInterface.get(), true, true);
+        if (mDiskCacheEnabled){
+            entry->onDisk = saveToDisk(path, scale, *entry);
+        }
+    }
+
+    mLastLoadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    Ogre::LogManager::getSingleton().logMessage("BvhCache - " + mesh->getName() + " : " +
+        Ogre::StringConverter::toString(entry->indices.size() / 3) + " triangles, BVH " +
+        (mLastLoadedFromDisk ? "relue de " : "construite, ") + (mDiskCacheEnabled ? path : "sans cache disque") +
+        " (" + Ogre::StringConverter::toString(static_cast<float>(mLastLoadMs)) + " ms)");
+
+    return storeEntry(path, std::move(entry));
+}
+
+btBvhTriangleMeshShape* BvhCache::loadTriangleMeshShape(const Ogre::String& meshName, uint64_t hash){
+    std::string path = makeFilePath(meshName, hash);
+    auto existing = mEntries.find(path);
+    if (existing != mEntries.end()){
+        return existing->second->shape.get();
+    }
+
+    std::unique_ptr<Entry> entry = std::make_unique<Entry>();
+    entry->meshName = meshName;
+    entry->hash = hash;
+    if (!loadFromDisk(path, *entry)){
+        Ogre::LogManager::getSingleton().logError("BvhCache::loadTriangleMeshShape - forme de " + meshName +
+                                                  " introuvable ou invalide : " + path);
+        return nullptr;
+    }
+    entry->onDisk = true;
+
+    Ogre::LogManager::getSingleton().logMessage("BvhCache - " + meshName + " : " +
+        Ogre::StringConverter::toString(entry->indices.size() / 3) + " triangles relus de " + path);
+    return storeEntry(path, std::move(entry));
+}
+
+bool BvhCache::findShapeKey(const btBvhTriangleMeshShape* shape, Ogre::String& meshName, uint64_t& hash) const{
+    for (const auto& item : mEntries){
+        const Entry& entry = *item.second;
+        if (entry.shape.get() == shape && entry.onDisk){
+            meshName = entry.meshName;
+            hash = entry.hash;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BvhCache::loadFromDisk(const std::string& path, Entry& entry){
+    std::ifstream in(path, std::ios::binary);
+    if (!in){
+        return false;
+    }
+
+    BvhFileHeader header;
+    const bool hasTriangles = !entry.indices.empty();
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, "MBVH", 4) != 0 ||
+        header.version != BVH_CACHE_VERSION ||
+        header.bulletVersion != static_cast<uint32_t>(btGetVersion()) ||
+        header.pointerSize != sizeof(void*) ||
+        header.scalarSize != sizeof(btScalar) ||
+        header.endianMarker != ENDIAN_MARKER ||
+        header.meshHash != entry.hash ||
+        header.triangleCount == 0 ||
+        (hasTriangles && (header.triangleCount != entry.indices.size() / 3 ||
+                          header.vertexCount != entry.vertices.size() / 3))){
+        Ogre::LogManager::getSingleton().logWarning("BvhCache - fichier incompatible ignoré : " + path);
+        return false;
+    }
+
+    // Triangles du fichier : identiques à ceux du mesh, ou repris tels quels (sans mesh)
+    std::vector<float> vertices(3 * static_cast<size_t>(header.vertexCount));
+    std::vector<int> indices(3 * static_cast<size_t>(header.triangleCount));
+    if (!in.read(reinterpret_cast<char*>(vertices.data()), vertices.size() * sizeof(float)) ||
+        !in.read(reinterpret_cast<char*>(indices.data()), indices.size() * sizeof(int))){
+        Ogre::LogManager::getSingleton().logWarning("BvhCache - fichier tronqué ignoré : " + path);
+        return false;
+    }
+    if (hasTriangles){
+        if (std::memcmp(vertices.data(), entry.vertices.data(), vertices.size() * sizeof(float)) != 0 ||
+            std::memcmp(indices.data(), entry.indices.data(), indices.size() * sizeof(int)) != 0){
+            Ogre::LogManager::getSingleton().logWarning("BvhCache - triangles différents du mesh, fichier ignoré : " + path);
+            return false;
+        }
+    }
+    else{
+        bool valid = hashTriangles(vertices, indices, Ogre::Vector3(header.scale[0], header.scale[1], header.scale[2])) == entry.hash;
+        for (size_t i = 0; valid && i < indices.size(); ++i){
+            valid = indices[i] >= 0 && static_cast<uint32_t>(indices[i]) < header.vertexCount;
+        }
+        if (!valid){
+            Ogre::LogManager::getSingleton().logWarning("BvhCache - triangles corrompus, fichier ignoré : " + path);
+            return false;
+        }
+    }
+
+    void* buffer = btAlignedAlloc(header.bufferSize, 16);
+    if (!in.read(static_cast<char*>(buffer), header.bufferSize)){
+        btAlignedFree(buffer);
+        return false;
+    }
+
+    btOptimizedBvh* bvh = btOptimizedBvh::deSerializeInPlace(buffer, header.bufferSize, false);
+    if (!bvh || !bvh->isQuantized()){
+        btAlignedFree(buffer);
+        return false;
+    }
+
+    if (!hasTriangles){
+        entry.vertices = std::move(vertices);
+        entry.indices = std::move(indices);
+        buildMeshInterface(entry);
+    }
+
+    // buildBvh = false : la forme utilise la BVH relue (non possédée) au lieu d'en construire une
+    entry.bvhBuffer = buffer;
+    entry.shape = std::make_unique<btBvhTriangleMeshShape>(entry.meshInterface.get(), true, false);
+    entry.shape->setOptimizedBvh(bvh);
+    return true;
+}
+
+bool BvhCache::saveToDisk(const std::string& path, const Ogre::Vector3& scale, const Entry& entry) const{
+    const btOptimizedBvh* bvh = entry.shape->getOptimizedBvh();
+    if (!bvh){
+        return false;
+    }
+
+    std::error_code error;
+    fs::create_directories(mDirectory, error);
+
+    BvhFileHeader header;
+    std::memcpy(header.magic, "MBVH", 4);
+    header.version = BVH_CACHE_VERSION;
+    header.bulletVersion = static_cast<uint32_t>(btGetVersion());
+    header.pointerSize = sizeof(void*);
+    header.scalarSize = sizeof(btScalar);
+    header.endianMarker = ENDIAN_MARKER;
+    header.meshHash = entry.hash;
+    header.triangleCount = static_cast<uint32_t>(entry.indices.size() / 3);
+    header.bufferSize = bvh->calculateSerializeBufferSize();
+    header.vertexCount = static_cast<uint32_t>(entry.vertices.size() / 3);
+    header.scale[0] = scale.x;
+    header.scale[1] = scale.y;
+    header.scale[2] = scale.z;
+
+    void* buffer = btAlignedAlloc(header.bufferSize, 16);
+    bool serialized = bvh->serializeInPlace(buffer, header.bufferSize, false);
+
+    // Écriture dans un fichier temporaire puis renommage : jamais de fichier à moitié écrit
+    std::string temporaryPath = path + ".tmp";
+    bool written = false;
+    if (serialized){
+        std::ofstream out(temporaryPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(entry.vertices.data()), entry.vertices.size() * sizeof(float));
+        out.write(reinterpret_cast<const char*>(entry.indices.data()), entry.indices.size() * sizeof(int));
+        out.write(static_cast<const char*>(buffer), header.bufferSize);
+        written = static_cast<bool>(out);
+    }
+    btAlignedFree(buffer);
+
+    if (!written){
+        fs::remove(temporaryPath, error);
+        Ogre::LogManager::getSingleton().logWarning("BvhCache - impossible d'écrire " + path);
+        return false;
+    }
+    fs::rename(temporaryPath, path, error);
+    if (error){
+        fs::remove(temporaryPath, error);
+        Ogre::LogManager::getSingleton().logWarning("BvhCache - impossible d'écrire " + path);
+        return false;
+    }
+
+    // Les anciennes versions du même mesh (empreinte différente) ne serviront plus
+    std::string fileName = fs::path(path).filename().string();
+    std::string prefix = fileName.substr(0, fileName.size() - (16 + 4));  // "<mesh>_"
+    for (const fs::directory_entry& file : fs::directory_iterator(mDirectory, error)){
+        std::string other = file.path().filename().string();
+        if (other != fileName && other.size() == fileName.size() &&
+            other.compare(0, prefix.size(), prefix) == 0 && file.path().extension() == ".bvh"){
+            fs::remove(file.path(), error);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,96 @@
+#include "../../include/managers/LaneFrictionField.h"
+#include <OgreLogManager.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+// Boule (0.8 au lancer) x piste (0.8) : friction combinée de Bullet sans motif
+static const float DEFAULT_FRICTION = 0.64f;
+// Piste réglementaire par défaut (voir LaneDefinition)
+static const float DEFAULT_LANE_WIDTH = 1.05f;
+static const float DEFAULT_FOUL_LINE_Z = 7.5f;
+
+LaneFrictionField::LaneFrictionField()
+    : mName("uniforme"),
+      mRightEdgeX(0.0f),
+      mFoulLineZ(0.0f),
+      mInverseBoardWidth(0.0f) {
+    setUniform(DEFAULT_FRICTION);
+    setLaneGeometry(0.0f, DEFAULT_LANE_WIDTH, DEFAULT_FOUL_LINE_Z);
+}
+
+void LaneFrictionField::setUniform(float friction) {
+    for (int row = 0; row < ROW_COUNT; ++row) {
+        std::fill(mTable[row], mTable[row] + BOARD_COUNT, friction);
+    }
+}
+
+void LaneFrictionField::fillBand(float startDistance, float endDistance, int firstBoard, int lastBoard, float friction) {
+    // Rangées dont le milieu est dans la bande
+    int firstRow = std::max(0, static_cast<int>(std::ceil(startDistance / ROW_LENGTH - 0.5f)));
+    int lastRow = std::min(ROW_COUNT - 1, static_cast<int>(std::floor(endDistance / ROW_LENGTH - 0.5f)));
+    int first = std::max(1, std::min(firstBoard, lastBoard)) - 1;
+    int last = std::min(BOARD_COUNT, std::max(firstBoard, lastBoard)) - 1;
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int board = first; board <= last; ++board) {
+            mTable[row][board] = friction;
+        }
+    }
+}
+
+bool LaneFrictionField::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        Ogre::LogManager::getSingleton().logWarning("LaneFrictionField::load - motif introuvable : " + path);
+        return false;
+    }
+
+    // Lecture dans une copie : un fichier mal formé ne laisse pas un motif à moitié appliqué
+    LaneFrictionField loaded(*this);
+    loaded.mName = path;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+        std::istringstream input(line);
+        std::string command;
+        if (!(input >> command)) {
+            continue;
+        }
+
+        bool valid = false;
+        if (command == "name") {
+            std::getline(input >> std::ws, loaded.mName);
+            valid = true;
+        }
+        else if (command == "dry") {
+            float friction;
+            valid = static_cast<bool>(input >> friction) && friction >= 0.0f;
+            if (valid) loaded.setUniform(friction);
+        }
+        else if (command == "band") {
+            float start, end, friction;
+            int firstBoard, lastBoard;
+            valid = static_cast<bool>(input >> start >> end >> firstBoard >> lastBoard >> friction) && friction >= 0.0f;
+            if (valid) loaded.fillBand(start, end, firstBoard, lastBoard, friction);
+        }
+
+        if (!valid) {
+            Ogre::LogManager::getSingleton().logError("LaneFrictionField::load - " + path + ":" +
+                std::to_string(lineNumber) + " ligne invalide : " + line);
+            return false;
+        }
+    }
+
+    *this = loaded;
+    Ogre::LogManager::getSingleton().logMessage("LaneFrictionField::load - motif \"" + mName + "\" chargé");
+    return true;
+}
+
+void LaneFrictionField::setLaneGeometry(float centerX, float width, float foulLineZ) {
+    mRightEdgeX = centerX + 0.5f * width;
+    mFoulLineZ = foulLineZ;
+    mInverseBoardWidth = BOARD_COUNT / width;
+}
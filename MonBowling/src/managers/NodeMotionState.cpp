@@ -0,0 +1,24 @@
+#include "../../include/managers/NodeMotionState.h"
+
+NodeMotionState::NodeMotionState(const btTransform& startTransform)
+    : mTransform(startTransform),
+      mFlags(nullptr),
+      mSlot(-1)
+{}
+
+void NodeMotionState::getWorldTransform(btTransform& worldTransform) const {
+    worldTransform = mTransform;
+}
+
+void NodeMotionState::setWorldTransform(const btTransform& worldTransform) {
+    mTransform = worldTransform;
+    // Un octet par corps : sans conflit même si Bullet synchronise les corps en parallèle
+    if (mFlags) {
+        (*mFlags)[mSlot] |= FLAG_MOVED;
+    }
+}
+
+void NodeMotionState::setSlot(std::vector<char>* flags, int slot) {
+    mFlags = flags;
+    mSlot = slot;
+}
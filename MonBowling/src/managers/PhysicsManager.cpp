@@ -1,4 +1,34 @@
 #include "../../include/managers/PhysicsManager.h"
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletCollision/CollisionDispatch/btCollisionObjectWrapper.h>
+#include <BulletCollision/CollisionDispatch/btManifoldResult.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#include <LinearMath/btThreads.h>
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <utility>
+
+// Valeurs par défaut du pas fixe : 120 Hz, 5 pas de rattrapage au maximum par frame
+static const float DEFAULT_TICK_RATE = 120.0f;
+static const int DEFAULT_MAX_STEPS_PER_FRAME = 5;
+// Pas interne de Bullet quand le pas fixe est désactivé (valeur par défaut de stepSimulation)
+static const float VARIABLE_STEP_INTERNAL = 1.0f / 60.0f;
+
+// Taille des pools de collision du monde multithread (paires et algorithmes alloués en parallèle)
+static const int MT_COLLISION_POOL_SIZE = 8192;
+// Nombre de paires traitées par tâche lors de la détection de collision parallèle
+static const int MT_DISPATCHER_GRAIN_SIZE = 40;
+
+// Impulsion minimale d'un choc publié : au-dessus du poids de la boule sur un pas (~0.6 N.s)
+static const float DEFAULT_IMPACT_THRESHOLD = 1.0f;
+// Un point de contact est nouveau pendant le pas où il apparaît (durée de vie incrémentée
+// une fois par la détection de collision du même pas)
+static const int FRESH_CONTACT_LIFETIME = 1;
+
+// Ordonnanceur par défaut créé par Bullet, partagé par tous les mondes multithread
+static std::unique_ptr<btITaskScheduler> sDefaultScheduler;
 
 // Initialisation de l'instance statique à nullptr
 PhysicsManager* PhysicsManager::mInstance = nullptr;
@@ -13,16 +43,59 @@ PhysicsManager* PhysicsManager::getInstance(){
 
 PhysicsManager::PhysicsManager()
     : mSceneMgr(nullptr),
-      mDebugNode(nullptr)
+      mDebugNode(nullptr),
+      mFixedStepEnabled(true),
+      mFixedTimeStep(1.0f / DEFAULT_TICK_RATE),
+      mMaxStepsPerFrame(DEFAULT_MAX_STEPS_PER_FRAME),
+      mAccumulator(0.0f),
+      mInterpolationAlpha(1.0f),
+      mStepCount(0),
+      mSimulatedTime(0.0),
+      mLastFrameSteps(0),
+      mMultithreadRequested(false),
+      mMultithreaded(false),
+      mThreadCount(0),
+      mTaskSchedulerType(SCHEDULER_DEFAULT),
+      mCustomScheduler(nullptr),
+      mImpactEventsEnabled(false),
+      mImpactThreshold(DEFAULT_IMPACT_THRESHOLD),
+      mDroppedImpacts(0)
 {}
 
-PhysicsManager::~PhysicsManager(){}
+PhysicsManager::~PhysicsManager(){
+    // Les corps possédés doivent quitter le monde avant sa destruction
+    if (mDynamicsWorld){
+        for (auto& owned : mOwnedBodies){
+            mDynamicsWorld->getBtWorld()->removeRigidBody(owned.body.get());
+        }
+    }
+    mOwnedBodies.clear();
+}
 
 void PhysicsManager::initialize(Ogre::SceneManager* sceneMgr){
     mSceneMgr = sceneMgr;
     
     // Création du monde physique avec gravité (0, -9.81, 0)
-    mDynamicsWorld = std::make_unique<Ogre::Bullet::DynamicsWorld>(Ogre::Vector3(0, -9.81, 0));
+    mMultithreaded = mMultithreadRequested && createMultithreadedWorld();
+    if (!mMultithreaded){
+        mDynamicsWorld = std::make_unique<Ogre::Bullet::DynamicsWorld>(Ogre::Vector3(0, -9.81, 0));
+    }
+
+    // Paires traitées et manifolds résolus dans l'ordre des identifiants des proxies, et non
+    // dans l'ordre d'arrivée dans le cache de paires : un monde restauré depuis un instantané
+    // (restoreSnapshot) refait alors exactement les mêmes pas
+    mDynamicsWorld->getBtWorld()->getDispatchInfo().m_deterministicOverlappingPairs = true;
+
+    // Le callback de fin de pas installé par Ogre ne sert qu'aux CollisionListener (non utilisés ici)
+    // et suppose que chaque corps a été créé par addRigidBody : on le retire pour les corps primitifs.
+    mDynamicsWorld->getBtWorld()->setInternalTickCallback(nullptr);
+    // Callback de début de pas : modèles par sous-pas (effet de la boule)
+    mDynamicsWorld->getBtWorld()->setInternalTickCallback(&PhysicsManager::preTickCallback, this, true);
+
+    // Simulation sans rendu : pas de debugger visuel
+    if (!mSceneMgr){
+        return;
+    }
     
     // Configuration du debugger visuel
     mDebugNode = mSceneMgr->getRootSceneNode()->createChildSceneNode("BulletDebugNode");
@@ -38,9 +111,140 @@ void PhysicsManager::initialize(Ogre::SceneManager* sceneMgr){
     mDynamicsWorld->getBtWorld()->setDebugDrawer(mDebugDrawer.get());
 }
 
+bool PhysicsManager::createMultithreadedWorld(){
+#if BT_THREADSAFE
+    btITaskScheduler* scheduler = mCustomScheduler;
+    if (!scheduler){
+        switch (mTaskSchedulerType){
+            case SCHEDULER_SEQUENTIAL: scheduler = btGetSequentialTaskScheduler(); break;
+            case SCHEDULER_OPENMP: scheduler = btGetOpenMPTaskScheduler(); break;
+            case SCHEDULER_TBB: scheduler = btGetTBBTaskScheduler(); break;
+            case SCHEDULER_PPL: scheduler = btGetPPLTaskScheduler(); break;
+            default:
+                if (!sDefaultScheduler){
+                    sDefaultScheduler.reset(btCreateDefaultTaskScheduler());
+                }
+                scheduler = sDefaultScheduler.get();
+                break;
+        }
+    }
+    if (!scheduler){
+        Ogre::LogManager::getSingleton().logWarning("PhysicsManager - ordonnanceur de tâches indisponible, monde monothread utilisé.");
+        return false;
+    }
+
+    int maxThreads = scheduler->getMaxNumThreads();
+    scheduler->setNumThreads(mThreadCount > 0 ? std::min(mThreadCount, maxThreads) : maxThreads);
+    btSetTaskScheduler(scheduler);
+
+    btDefaultCollisionConstructionInfo constructionInfo;
+    constructionInfo.m_defaultMaxPersistentManifoldPoolSize = MT_COLLISION_POOL_SIZE;
+    constructionInfo.m_defaultMaxCollisionAlgorithmPoolSize = MT_COLLISION_POOL_SIZE;
+    mMtCollisionConfig = std::make_unique<btDefaultCollisionConfiguration>(constructionInfo);
+    mMtDispatcher = std::make_unique<btCollisionDispatcherMt>(mMtCollisionConfig.get(), MT_DISPATCHER_GRAIN_SIZE);
+    mMtBroadphase = std::make_unique<btDbvtBroadphase>();
+
+    // Un solveur par thread pour les îlots indépendants, et un solveur parallèle
+    // pour les gros îlots (un jeu de quilles qui s'effondre forme un seul îlot)
+    mMtSolverPool = std::make_unique<btConstraintSolverPoolMt>(scheduler->getNumThreads());
+    mMtSolver = std::make_unique<btSequentialImpulseConstraintSolverMt>();
+
+    btDiscreteDynamicsWorldMt* world = new btDiscreteDynamicsWorldMt(
+        mMtDispatcher.get(), mMtBroadphase.get(), mMtSolverPool.get(), mMtSolver.get(), mMtCollisionConfig.get());
+    world->setGravity(btVector3(0, -9.81f, 0));
+
+    // Le wrapper Ogre prend possession du monde (addRigidBody à partir d'entités reste disponible)
+    mDynamicsWorld = std::make_unique<Ogre::Bullet::DynamicsWorld>(world);
+
+    Ogre::LogManager::getSingleton().logMessage("PhysicsManager - monde multithread, " +
+        Ogre::StringConverter::toString(scheduler->getNumThreads()) + " threads (" + scheduler->getName() + ")");
+    return true;
+#else
+    Ogre::LogManager::getSingleton().logWarning("PhysicsManager - Bullet compilé sans BT_THREADSAFE, monde monothread utilisé.");
+    return false;
+#endif
+}
+
+void PhysicsManager::setMultithreaded(bool enabled, int threadCount){
+    if (mDynamicsWorld){
+        Ogre::LogManager::getSingleton().logWarning("PhysicsManager::setMultithreaded - sans effet après initialize()");
+        return;
+    }
+    mMultithreadRequested = enabled;
+    mThreadCount = std::max(0, threadCount);
+}
+
+void PhysicsManager::setTaskScheduler(TaskScheduler type){
+    mTaskSchedulerType = type;
+}
+
+void PhysicsManager::setCustomTaskScheduler(btITaskScheduler* scheduler){
+    mCustomScheduler = scheduler;
+}
+
+int PhysicsManager::getThreadCount() const{
+#if BT_THREADSAFE
+    if (mMultithreaded && btGetTaskScheduler()){
+        return btGetTaskScheduler()->getNumThreads();
+    }
+#endif
+    return 1;
+}
+
 void PhysicsManager::update(float deltaTime){
-    // Mise à jour de la simulation physique
-    mDynamicsWorld->getBtWorld()->stepSimulation(deltaTime, 10);
+    btDynamicsWorld* world = mDynamicsWorld->getBtWorld();
+    mProfiler.beginFrame();
+
+    if (!mFixedStepEnabled){
+        // Ancien comportement : le pas dépend directement du temps de rendu. Les sous-pas
+        // internes de Bullet sont comptés pour que le temps simulé (détection de fin de
+        // lancer, horodatage des chocs) avance aussi dans ce mode.
+        clearMovedFlags();
+        storePreviousTransforms();
+        mProfiler.beginStep();
+        int subSteps = world->stepSimulation(deltaTime, 10, VARIABLE_STEP_INTERNAL);
+        mProfiler.endStep(world);
+        mStepCount += subSteps;
+        mSimulatedTime += subSteps * VARIABLE_STEP_INTERNAL;
+        publishImpacts();
+        mInterpolationAlpha = 1.0f;
+        mLastFrameSteps = 1;
+    }
+    else{
+        mAccumulator += deltaTime;
+
+        // On consomme le temps accumulé par pas de durée constante.
+        // maxSubSteps = 0 : Bullet fait exactement un pas de mFixedTimeStep, sans
+        // accumulateur interne, ce qui rend le résultat indépendant de la fréquence d'affichage.
+        int steps = 0;
+        while (mAccumulator >= mFixedTimeStep && steps < mMaxStepsPerFrame){
+            // Sans pas cette frame, les corps marqués à la précédente restent à interpoler
+            if (steps == 0){
+                clearMovedFlags();
+            }
+            storePreviousTransforms();
+            mProfiler.beginStep();
+            world->stepSimulation(mFixedTimeStep, 0);
+            mProfiler.endStep(world);
+            mAccumulator -= mFixedTimeStep;
+            ++steps;
+            ++mStepCount;
+            mSimulatedTime += mFixedTimeStep;
+            publishImpacts();
+        }
+
+        // Plafond atteint (grosse frame) : on abandonne le retard au lieu de le reporter,
+        // sinon les frames suivantes deviendraient elles aussi trop longues.
+        if (mAccumulator >= mFixedTimeStep){
+            mAccumulator = std::fmod(mAccumulator, mFixedTimeStep);
+        }
+
+        mLastFrameSteps = steps;
+        mInterpolationAlpha = mAccumulator / mFixedTimeStep;
+    }
+    mProfiler.endFrame();
+
+    syncSceneNodes();
     
     // Mise à jour du debugger visuel
     if (mDebugDrawer && mDebugDrawer->getDebugMode() > 0){
@@ -48,6 +252,533 @@ void PhysicsManager::update(float deltaTime){
     }
 }
 
+void PhysicsManager::step(int steps){
+    btDynamicsWorld* world = mDynamicsWorld->getBtWorld();
+    mProfiler.beginFrame();
+    if (steps > 0){
+        clearMovedFlags();
+    }
+    for (int i = 0; i < steps; ++i){
+        storePreviousTransforms();
+        mProfiler.beginStep();
+        world->stepSimulation(mFixedTimeStep, 0);
+        mProfiler.endStep(world);
+        ++mStepCount;
+        mSimulatedTime += mFixedTimeStep;
+        publishImpacts();
+    }
+    mProfiler.endFrame();
+    mLastFrameSteps = steps;
+    mInterpolationAlpha = 1.0f;
+}
+
+void PhysicsManager::addTickListener(PhysicsTickListener* listener){
+    if (listener && std::find(mTickListeners.begin(), mTickListeners.end(), listener) == mTickListeners.end()){
+        mTickListeners.push_back(listener);
+    }
+}
+
+void PhysicsManager::removeTickListener(PhysicsTickListener* listener){
+    mTickListeners.erase(std::remove(mTickListeners.begin(), mTickListeners.end(), listener), mTickListeners.end());
+}
+
+void PhysicsManager::preTickCallback(btDynamicsWorld* world, btScalar timeStep){
+    PhysicsManager* manager = static_cast<PhysicsManager*>(world->getWorldUserInfo());
+    for (PhysicsTickListener* listener : manager->mTickListeners){
+        listener->onPhysicsTick(timeStep);
+    }
+}
+
+void PhysicsManager::setImpactEventsEnabled(bool enabled){
+    mImpactEventsEnabled = enabled;
+}
+
+void PhysicsManager::setBodyRole(btCollisionObject* body, BodyRole role){
+    if (body){
+        body->setUserIndex(static_cast<int>(role));
+    }
+}
+
+BodyRole PhysicsManager::getBodyRole(const btCollisionObject* body){
+    switch (body->getUserIndex()){
+        case static_cast<int>(BodyRole::BALL): return BodyRole::BALL;
+        case static_cast<int>(BodyRole::PIN): return BodyRole::PIN;
+        case static_cast<int>(BodyRole::LANE): return BodyRole::LANE;
+        default: return BodyRole::NONE;
+    }
+}
+
+// Partie de la piste touchée : index de l'enfant pour une forme composée (piste analytique),
+// index du triangle pour un maillage classé par BvhCache, le plateau sinon (boîte sans rendu)
+static LanePart findLanePart(const btCollisionObject* lane, int childIndex){
+    const btCollisionShape* shape = lane->getCollisionShape();
+    if (shape->getShapeType() == TRIANGLE_MESH_SHAPE_PROXYTYPE){
+        const uint8_t* parts = static_cast<const uint8_t*>(shape->getUserPointer());
+        if (!parts || childIndex < 0 || childIndex >= shape->getUserIndex()){
+            return LanePart::DECK;
+        }
+        return static_cast<LanePart>(parts[childIndex]);
+    }
+    if (!shape->isCompound()){
+        return LanePart::DECK;
+    }
+    const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+    if (childIndex < 0 || childIndex >= compound->getNumChildShapes()){
+        return LanePart::DECK;
+    }
+    return static_cast<LanePart>(compound->getChildShape(childIndex)->getUserIndex());
+}
+
+// Contact boule/plateau d'une piste avec un champ de friction : friction combinée lue dans
+// le champ à la position du contact. Bullet l'appelle pour chaque point ajouté ou rafraîchi,
+// donc à chaque pas tant que la boule roule.
+static bool laneFrictionCallback(btManifoldPoint& point,
+                                 const btCollisionObjectWrapper* wrapper0, int partId0, int index0,
+                                 const btCollisionObjectWrapper* wrapper1, int partId1, int index1){
+    const btCollisionObject* lane = wrapper0->getCollisionObject();
+    const btCollisionObject* other = wrapper1->getCollisionObject();
+    int laneIndex = index0;
+    if (PhysicsManager::getBodyRole(lane) != BodyRole::LANE){
+        std::swap(lane, other);
+        laneIndex = index1;
+    }
+    if (PhysicsManager::getBodyRole(lane) != BodyRole::LANE || PhysicsManager::getBodyRole(other) != BodyRole::BALL){
+        return false;
+    }
+
+    const LaneFrictionField* field = static_cast<const LaneFrictionField*>(lane->getUserPointer());
+    if (!field || findLanePart(lane, laneIndex) != LanePart::DECK){
+        return false;
+    }
+    const btVector3& position = point.getPositionWorldOnA();
+    point.m_combinedFriction = field->sample(position.x(), position.z());
+    return true;
+}
+
+void PhysicsManager::setLaneFrictionField(btCollisionObject* lane, const LaneFrictionField* field){
+    if (!lane){
+        return;
+    }
+    lane->setUserPointer(const_cast<LaneFrictionField*>(field));
+    if (field){
+        // Callback global de Bullet, le même pour tous les mondes : le champ est porté par la piste
+        gContactAddedCallback = &laneFrictionCallback;
+        lane->setCollisionFlags(lane->getCollisionFlags() | btCollisionObject::CF_CUSTOM_MATERIAL_CALLBACK);
+    }
+    else{
+        lane->setCollisionFlags(lane->getCollisionFlags() & ~btCollisionObject::CF_CUSTOM_MATERIAL_CALLBACK);
+    }
+}
+
+void PhysicsManager::publishImpacts(){
+    if (!mImpactEventsEnabled){
+        return;
+    }
+
+    btDispatcher* dispatcher = mDynamicsWorld->getBtWorld()->getDispatcher();
+    const float time = static_cast<float>(mSimulatedTime);
+    const int manifoldCount = dispatcher->getNumManifolds();
+
+    for (int m = 0; m < manifoldCount; ++m){
+        const btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(m);
+        const btCollisionObject* body0 = manifold->getBody0();
+        const btCollisionObject* body1 = manifold->getBody1();
+        BodyRole role0 = getBodyRole(body0);
+        BodyRole role1 = getBodyRole(body1);
+        if (role0 == BodyRole::NONE || role1 == BodyRole::NONE){
+            continue;
+        }
+
+        // Contact nouveau le plus fort de la paire (les contacts qui persistent, comme la
+        // boule qui roule, ne sont pas des chocs)
+        int strongest = -1;
+        float impulse = mImpactThreshold;
+        for (int p = 0; p < manifold->getNumContacts(); ++p){
+            const btManifoldPoint& point = manifold->getContactPoint(p);
+            if (point.getLifeTime() <= FRESH_CONTACT_LIFETIME && point.getAppliedImpulse() > impulse){
+                impulse = point.getAppliedImpulse();
+                strongest = p;
+            }
+        }
+        if (strongest < 0){
+            continue;
+        }
+        const btManifoldPoint& point = manifold->getContactPoint(strongest);
+
+        // Ordre du type : boule, puis quille, puis piste
+        bool swapped = static_cast<int>(role1) < static_cast<int>(role0);
+        BodyRole first = swapped ? role1 : role0;
+        BodyRole second = swapped ? role0 : role1;
+
+        ImpactEvent event;
+        if (first == BodyRole::BALL && second == BodyRole::PIN){
+            event.type = ImpactType::BALL_PIN;
+        }
+        else if (first == BodyRole::PIN && second == BodyRole::PIN){
+            event.type = ImpactType::PIN_PIN;
+        }
+        else if (first == BodyRole::PIN && second == BodyRole::LANE){
+            event.type = ImpactType::PIN_LANE;
+        }
+        else if (first == BodyRole::BALL && second == BodyRole::LANE){
+            LanePart part = swapped ? findLanePart(body0, point.m_index0) : findLanePart(body1, point.m_index1);
+            event.type = part == LanePart::GUTTER ? ImpactType::BALL_GUTTER : ImpactType::BALL_LANE;
+        }
+        else{
+            continue;
+        }
+
+        btVector3 position = (point.getPositionWorldOnA() + point.getPositionWorldOnB()) * 0.5f;
+        event.impulse = impulse;
+        event.point = Ogre::Vector3(position.x(), position.y(), position.z());
+        event.time = time;
+        event.bodyA = btRigidBody::upcast(swapped ? body1 : body0);
+        event.bodyB = btRigidBody::upcast(swapped ? body0 : body1);
+
+        if (!mImpactQueue.push(event)){
+            mDroppedImpacts.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void PhysicsManager::teleportBodies(btRigidBody* const* bodies, const btTransform* transforms, size_t count){
+    if (!mDynamicsWorld){
+        return;
+    }
+
+    btDynamicsWorld* world = mDynamicsWorld->getBtWorld();
+    const btVector3 zero(0.0f, 0.0f, 0.0f);
+
+    mCleanProxies.clear();
+    for (size_t i = 0; i < count; ++i){
+        btRigidBody* body = bodies[i];
+        const btTransform& transform = transforms[i];
+
+        body->setWorldTransform(transform);
+        body->setInterpolationWorldTransform(transform);
+        body->setLinearVelocity(zero);
+        body->setAngularVelocity(zero);
+        body->setInterpolationLinearVelocity(zero);
+        body->setInterpolationAngularVelocity(zero);
+        body->clearForces();
+        if (body->getMotionState()){
+            body->getMotionState()->setWorldTransform(transform);
+        }
+        body->forceActivationState(ACTIVE_TAG);
+        body->setDeactivationTime(0.0f);
+
+        if (body->getBroadphaseHandle()){
+            mCleanProxies.push_back(body->getBroadphaseHandle());
+            world->updateSingleAabb(body);
+        }
+        resetInterpolation(body);
+    }
+    cleanMarkedProxyPairs();
+}
+
+void PhysicsManager::cleanMarkedProxyPairs(){
+    if (mCleanProxies.empty()){
+        return;
+    }
+    std::sort(mCleanProxies.begin(), mCleanProxies.end());
+
+    btDynamicsWorld* world = mDynamicsWorld->getBtWorld();
+    btDispatcher* dispatcher = world->getDispatcher();
+    btOverlappingPairCache* pairCache = world->getBroadphase()->getOverlappingPairCache();
+    btBroadphasePairArray& pairs = pairCache->getOverlappingPairArray();
+    for (int i = 0; i < pairs.size(); ++i){
+        btBroadphasePair& pair = pairs[i];
+        if (pair.m_algorithm &&
+            (std::binary_search(mCleanProxies.begin(), mCleanProxies.end(), pair.m_pProxy0) ||
+             std::binary_search(mCleanProxies.begin(), mCleanProxies.end(), pair.m_pProxy1))){
+            pairCache->cleanOverlappingPair(pair, dispatcher);
+        }
+    }
+    mCleanProxies.clear();
+}
+
+bool PhysicsManager::captureSnapshot(PhysicsSnapshot& snapshot) const{
+    snapshot.mValid = false;
+    snapshot.mBodies.clear();
+    snapshot.mPairs.clear();
+    snapshot.mManifolds.clear();
+    snapshot.mManifoldOrder.clear();
+    snapshot.mPoints.clear();
+    if (!mDynamicsWorld){
+        return false;
+    }
+
+    btDynamicsWorld* world = mDynamicsWorld->getBtWorld();
+    const btCollisionObjectArray& objects = world->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); ++i){
+        btRigidBody* body = btRigidBody::upcast(objects[i]);
+        if (!body || body->isStaticOrKinematicObject()){
+            continue;
+        }
+        if (snapshot.mBodies.size() == snapshot.mMaxBodies){
+            Ogre::LogManager::getSingleton().logWarning("PhysicsManager::captureSnapshot - trop de corps pour l'instantané");
+            return false;
+        }
+        PhysicsSnapshot::BodyState state;
+        state.body = body;
+        state.transform = body->getWorldTransform();
+        state.interpolationTransform = body->getInterpolationWorldTransform();
+        state.linearVelocity = body->getLinearVelocity();
+        state.angularVelocity = body->getAngularVelocity();
+        state.interpolationLinearVelocity = body->getInterpolationLinearVelocity();
+        state.interpolationAngularVelocity = body->getInterpolationAngularVelocity();
+        state.totalForce = body->getTotalForce();
+        state.totalTorque = body->getTotalTorque();
+        state.activationState = body->getActivationState();
+        state.deactivationTime = body->getDeactivationTime();
+        snapshot.mBodies.push_back(state);
+    }
+
+    const btBroadphasePairArray& pairs = world->getBroadphase()->getOverlappingPairCache()->getOverlappingPairArray();
+    if (static_cast<size_t>(pairs.size()) > snapshot.mMaxPairs){
+        Ogre::LogManager::getSingleton().logWarning("PhysicsManager::captureSnapshot - trop de paires pour l'instantané");
+        return false;
+    }
+    for (int i = 0; i < pairs.size(); ++i){
+        snapshot.mPairs.push_back({pairs[i].m_pProxy0, pairs[i].m_pProxy1});
+    }
+    std::sort(snapshot.mPairs.begin(), snapshot.mPairs.end(),
+              [](const PhysicsSnapshot::PairState& a, const PhysicsSnapshot::PairState& b){
+                  return std::tie(a.proxy0, a.proxy1) < std::tie(b.proxy0, b.proxy1);
+              });
+
+    btDispatcher* dispatcher = world->getDispatcher();
+    for (int m = 0; m < dispatcher->getNumManifolds(); ++m){
+        const btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(m);
+        int pointCount = manifold->getNumContacts();
+        if (pointCount == 0){
+            continue;
+        }
+        if (snapshot.mManifolds.size() == snapshot.mMaxManifolds ||
+            snapshot.mPoints.size() + pointCount > snapshot.mMaxPoints){
+            Ogre::LogManager::getSingleton().logWarning("PhysicsManager::captureSnapshot - trop de contacts pour l'instantané");
+            return false;
+        }
+        snapshot.mManifolds.push_back({manifold->getBody0(), manifold->getBody1(),
+                                       static_cast<int>(snapshot.mPoints.size()), pointCount});
+        for (int p = 0; p < pointCount; ++p){
+            snapshot.mPoints.push_back(manifold->getContactPoint(p));
+        }
+    }
+
+    for (size_t i = 0; i < snapshot.mManifolds.size(); ++i){
+        snapshot.mManifoldOrder.push_back(static_cast<int>(i));
+    }
+    std::sort(snapshot.mManifoldOrder.begin(), snapshot.mManifoldOrder.end(), [&snapshot](int a, int b){
+        const PhysicsSnapshot::ManifoldState& first = snapshot.mManifolds[a];
+        const PhysicsSnapshot::ManifoldState& second = snapshot.mManifolds[b];
+        return std::tie(first.body0, first.body1, a) < std::tie(second.body0, second.body1, b);
+    });
+
+    snapshot.mStepCount = mStepCount;
+    snapshot.mSimulatedTime = mSimulatedTime;
+    snapshot.mValid = true;
+    return true;
+}
+
+bool PhysicsManager::restoreManifoldPoints(const PhysicsSnapshot& snapshot, btPersistentManifold* manifold){
+    const btCollisionObject* body0 = manifold->getBody0();
+    const btCollisionObject* body1 = manifold->getBody1();
+    auto it = std::lower_bound(snapshot.mManifoldOrder.begin(), snapshot.mManifoldOrder.end(), manifold,
+        [&snapshot](int index, const btPersistentManifold* key){
+            const PhysicsSnapshot::ManifoldState& captured = snapshot.mManifolds[index];
+            return std::tie(captured.body0, captured.body1) < std::make_tuple(key->getBody0(), key->getBody1());
+        });
+    for (; it != snapshot.mManifoldOrder.end(); ++it){
+        const PhysicsSnapshot::ManifoldState& captured = snapshot.mManifolds[*it];
+        if (captured.body0 != body0 || captured.body1 != body1){
+            break;
+        }
+        // Paire à plusieurs manifolds (formes composées) : dans l'ordre de la capture
+        if (mRestoredManifolds[*it]){
+            continue;
+        }
+        mRestoredManifolds[*it] = 1;
+        manifold->clearManifold();
+        for (int p = 0; p < captured.pointCount; ++p){
+            manifold->addManifoldPoint(snapshot.mPoints[captured.firstPoint + p]);
+        }
+        return true;
+    }
+    return false;
+}
+
+bool PhysicsManager::restoreSnapshot(const PhysicsSnapshot& snapshot){
+    if (!snapshot.mValid || !mDynamicsWorld){
+        return false;
+    }
+
+    btDynamicsWorld* world = mDynamicsWorld->getBtWorld();
+    btDispatcher* dispatcher = world->getDispatcher();
+    btOverlappingPairCache* pairCache = world->getBroadphase()->getOverlappingPairCache();
+
+    // Les corps capturés doivent toujours appartenir au monde (comparaison d'adresses seulement)
+    const btCollisionObjectArray& objects = world->getCollisionObjectArray();
+    for (const PhysicsSnapshot::BodyState& state : snapshot.mBodies){
+        if (objects.findLinearSearch(state.body) == objects.size()){
+            Ogre::LogManager::getSingleton().logWarning("PhysicsManager::restoreSnapshot - corps absent du monde");
+            return false;
+        }
+    }
+
+    for (const PhysicsSnapshot::BodyState& state : snapshot.mBodies){
+        btRigidBody* body = state.body;
+        body->setWorldTransform(state.transform);
+        body->setInterpolationWorldTransform(state.interpolationTransform);
+        body->setLinearVelocity(state.linearVelocity);
+        body->setAngularVelocity(state.angularVelocity);
+        body->setInterpolationLinearVelocity(state.interpolationLinearVelocity);
+        body->setInterpolationAngularVelocity(state.interpolationAngularVelocity);
+        body->clearForces();
+        body->applyCentralForce(state.totalForce);
+        body->applyTorque(state.totalTorque);
+        body->forceActivationState(state.activationState);
+        body->setDeactivationTime(state.deactivationTime);
+        if (body->getMotionState()){
+            body->getMotionState()->setWorldTransform(state.transform);
+        }
+        resetInterpolation(body);
+    }
+
+    // Paires apparues depuis la capture : retirées avec leurs algorithmes et manifolds (en
+    // partant de la fin, une paire retirée est remplacée par la dernière, déjà vue)
+    auto pairBefore = [](const PhysicsSnapshot::PairState& a, const PhysicsSnapshot::PairState& b){
+        return std::tie(a.proxy0, a.proxy1) < std::tie(b.proxy0, b.proxy1);
+    };
+    btBroadphasePairArray& pairs = pairCache->getOverlappingPairArray();
+    for (int i = pairs.size() - 1; i >= 0; --i){
+        PhysicsSnapshot::PairState live = {pairs[i].m_pProxy0, pairs[i].m_pProxy1};
+        if (!std::binary_search(snapshot.mPairs.begin(), snapshot.mPairs.end(), live, pairBefore)){
+            pairCache->removeOverlappingPair(live.proxy0, live.proxy1, dispatcher);
+        }
+    }
+    // Paires disparues depuis : rajoutées (sans effet pour celles toujours présentes)
+    for (const PhysicsSnapshot::PairState& captured : snapshot.mPairs){
+        pairCache->addOverlappingPair(captured.proxy0, captured.proxy1);
+    }
+
+    // Manifolds gardés : vidés puis remplis des points capturés de leur paire de corps
+    mRestoredManifolds.assign(snapshot.mManifolds.size(), 0);
+    for (int m = 0; m < dispatcher->getNumManifolds(); ++m){
+        btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(m);
+        if (!restoreManifoldPoints(snapshot, manifold)){
+            manifold->clearManifold();
+        }
+    }
+
+    // Paires séparées depuis la capture : leur manifold a été libéré. L'algorithme de la paire
+    // le recrée (narrowphase de cette paire seulement) et les points capturés le remplacent.
+    for (size_t i = 0; i < snapshot.mManifolds.size(); ++i){
+        if (mRestoredManifolds[i]){
+            continue;
+        }
+        const PhysicsSnapshot::ManifoldState& captured = snapshot.mManifolds[i];
+        btBroadphasePair* pair = pairCache->findPair(const_cast<btCollisionObject*>(captured.body0)->getBroadphaseHandle(),
+                                                     const_cast<btCollisionObject*>(captured.body1)->getBroadphaseHandle());
+        if (!pair){
+            continue;
+        }
+        btCollisionObject* object0 = static_cast<btCollisionObject*>(pair->m_pProxy0->m_clientObject);
+        btCollisionObject* object1 = static_cast<btCollisionObject*>(pair->m_pProxy1->m_clientObject);
+        btCollisionObjectWrapper wrapper0(nullptr, object0->getCollisionShape(), object0, object0->getWorldTransform(), -1, -1);
+        btCollisionObjectWrapper wrapper1(nullptr, object1->getCollisionShape(), object1, object1->getWorldTransform(), -1, -1);
+        if (!pair->m_algorithm){
+            pair->m_algorithm = dispatcher->findAlgorithm(&wrapper0, &wrapper1, nullptr, BT_CONTACT_POINT_ALGORITHMS);
+        }
+        if (!pair->m_algorithm){
+            continue;
+        }
+        btManifoldResult result(&wrapper0, &wrapper1);
+        pair->m_algorithm->processCollision(&wrapper0, &wrapper1, world->getDispatchInfo(), &result);
+
+        mPairManifolds.resize(0);
+        pair->m_algorithm->getAllContactManifolds(mPairManifolds);
+        for (int m = 0; m < mPairManifolds.size(); ++m){
+            if (!restoreManifoldPoints(snapshot, mPairManifolds[m])){
+                mPairManifolds[m]->clearManifold();
+            }
+        }
+    }
+
+    mStepCount = snapshot.mStepCount;
+    mSimulatedTime = snapshot.mSimulatedTime;
+    mAccumulator = 0.0f;
+    mInterpolationAlpha = 1.0f;
+    return true;
+}
+
+btRigidBody* PhysicsManager::addOwnedBody(float mass, btCollisionShape* shape, bool ownsShape, const btTransform& startTransform,
+                                          Ogre::SceneNode* node){
+    btVector3 inertia(0, 0, 0);
+    if (mass != 0.0f){
+        shape->calculateLocalInertia(mass, inertia);
+    }
+
+    OwnedBody owned;
+    if (ownsShape){
+        owned.shape.reset(shape);
+    }
+    // Corps statique (piste) : jamais intégré, son nœud est posé une fois pour toutes
+    NodeMotionState* nodeState = (node && mass != 0.0f) ? new NodeMotionState(startTransform) : nullptr;
+    btMotionState* motionState = nodeState ? static_cast<btMotionState*>(nodeState)
+                                           : new btDefaultMotionState(startTransform);
+    owned.motionState.reset(motionState);
+    owned.body = std::make_unique<btRigidBody>(mass, motionState, shape, inertia);
+
+    btRigidBody* body = owned.body.get();
+    mDynamicsWorld->getBtWorld()->addRigidBody(body);
+    mOwnedBodies.push_back(std::move(owned));
+
+    // Corps dynamique affiché : enregistré d'office, son état marquera son entrée à chaque intégration
+    if (nodeState){
+        registerInterpolatedBody(body);
+        int index = findInterpolatedBody(body);
+        mInterpolatedNodes[index] = node;
+        mInterpolatedStates[index] = nodeState;
+        mNodeFlags[index] = NodeMotionState::FLAG_UNSETTLED;
+        nodeState->setSlot(&mNodeFlags, index);
+    }
+    return body;
+}
+
+btRigidBody* PhysicsManager::addPrimitiveRigidBody(float mass, btCollisionShape* shape, const btTransform& startTransform,
+                                                   Ogre::SceneNode* node){
+    if (!mDynamicsWorld || !shape){
+        Ogre::LogManager::getSingleton().logError("PhysicsManager::addPrimitiveRigidBody - monde ou forme non initialisé");
+        return nullptr;
+    }
+    return addOwnedBody(mass, shape, true, startTransform, node);
+}
+
+btRigidBody* PhysicsManager::addSharedShapeRigidBody(float mass, btCollisionShape* shape, const btTransform& startTransform,
+                                                     Ogre::SceneNode* node){
+    if (!mDynamicsWorld || !shape){
+        Ogre::LogManager::getSingleton().logError("PhysicsManager::addSharedShapeRigidBody - monde ou forme non initialisé");
+        return nullptr;
+    }
+    return addOwnedBody(mass, shape, false, startTransform, node);
+}
+
+void PhysicsManager::removeRigidBody(btRigidBody* body){
+    if (!body || !mDynamicsWorld) return;
+
+    unregisterInterpolatedBody(body);
+    mDynamicsWorld->getBtWorld()->removeRigidBody(body);
+
+    for (size_t i = 0; i < mOwnedBodies.size(); ++i){
+        if (mOwnedBodies[i].body.get() == body){
+            mOwnedBodies[i] = std::move(mOwnedBodies.back());
+            mOwnedBodies.pop_back();
+            break;
+        }
+    }
+}
+
 void PhysicsManager::toggleDebugDrawing(){
     if (mDebugDrawer){
         int mode = mDebugDrawer->getDebugMode();
@@ -61,4 +792,183 @@ void PhysicsManager::toggleDebugDrawing(){
                                       Ogre::Bullet::DebugDrawer::DBG_DrawContactPoints);
         }
     }
-}
\ No newline at end of file
+}
+
+// --- Pas de temps fixe ---
+
+void PhysicsManager::setTickRate(float ticksPerSecond){
+    if (ticksPerSecond <= 0.0f){
+        Ogre::LogManager::getSingleton().logWarning("PhysicsManager::setTickRate - fréquence invalide, ignorée.");
+        return;
+    }
+    mFixedTimeStep = 1.0f / ticksPerSecond;
+    mAccumulator = 0.0f;
+}
+
+void PhysicsManager::setMaxStepsPerFrame(int maxSteps){
+    mMaxStepsPerFrame = std::max(1, maxSteps);
+}
+
+void PhysicsManager::setFixedStepEnabled(bool enabled){
+    mFixedStepEnabled = enabled;
+    mAccumulator = 0.0f;
+    mInterpolationAlpha = 1.0f;
+}
+
+// --- Interpolation de rendu ---
+
+// L'entrée d'un corps dans le registre est gardée dans le corps (userIndex2, -1 par défaut) :
+// recherche en temps constant, vérifiée contre le registre de ce gestionnaire
+int PhysicsManager::findInterpolatedBody(const btRigidBody* body) const{
+    if (!body){
+        return -1;
+    }
+    int index = body->getUserIndex2();
+    if (index >= 0 && index < static_cast<int>(mInterpolatedBodies.size()) && mInterpolatedBodies[index] == body){
+        return index;
+    }
+    return -1;
+}
+
+void PhysicsManager::registerInterpolatedBody(btRigidBody* body){
+    // Un corps statique ne bouge jamais : rien à conserver ni à interpoler à chaque pas
+    if (!body || body->isStaticObject() || findInterpolatedBody(body) >= 0) return;
+    body->setUserIndex2(static_cast<int>(mInterpolatedBodies.size()));
+    mInterpolatedBodies.push_back(body);
+    mPreviousTransforms.push_back(body->getWorldTransform());
+    mInterpolatedNodes.push_back(nullptr);
+    mInterpolatedStates.push_back(nullptr);
+    mNodeFlags.push_back(0);
+}
+
+void PhysicsManager::unregisterInterpolatedBody(btRigidBody* body){
+    int index = findInterpolatedBody(body);
+    if (index < 0) return;
+    // Échange avec le dernier élément pour garder les tableaux compacts
+    mInterpolatedBodies[index] = mInterpolatedBodies.back();
+    mInterpolatedBodies[index]->setUserIndex2(index);
+    mPreviousTransforms[index] = mPreviousTransforms.back();
+    mInterpolatedNodes[index] = mInterpolatedNodes.back();
+    mInterpolatedStates[index] = mInterpolatedStates.back();
+    mNodeFlags[index] = mNodeFlags.back();
+    if (mInterpolatedStates[index]){
+        mInterpolatedStates[index]->setSlot(&mNodeFlags, index);
+    }
+    mInterpolatedBodies.pop_back();
+    mPreviousTransforms.pop_back();
+    mInterpolatedNodes.pop_back();
+    mInterpolatedStates.pop_back();
+    mNodeFlags.pop_back();
+    body->setUserIndex2(-1);
+}
+
+void PhysicsManager::resetInterpolation(btRigidBody* body){
+    int index = findInterpolatedBody(body);
+    if (index >= 0){
+        mPreviousTransforms[index] = body->getWorldTransform();
+        // Corps téléporté, même endormi (instantané restauré) : son nœud doit suivre
+        mNodeFlags[index] |= NodeMotionState::FLAG_UNSETTLED;
+    }
+}
+
+void PhysicsManager::syncSceneNodes(){
+    const size_t count = mInterpolatedBodies.size();
+
+    // 1. Corps à recopier : intégrés depuis le début de la frame physique, ou arrêtés
+    // (endormis, téléportés) dont le nœud n'est pas encore posé. Les autres sont ignorés
+    // sans même lire leur corps Bullet.
+    mSyncIndices.clear();
+    for (size_t i = 0; i < count; ++i){
+        if (mNodeFlags[i] && mInterpolatedNodes[i]){
+            mSyncIndices.push_back(static_cast<int>(i));
+        }
+    }
+
+    const size_t syncCount = mSyncIndices.size();
+    if (syncCount == 0){
+        return;
+    }
+    mSyncPrevious.resize(syncCount * SYNC_STRIDE);
+    mSyncCurrent.resize(syncCount * SYNC_STRIDE);
+    mSyncResult.resize(syncCount * SYNC_STRIDE);
+
+    // 2. Transformations Bullet recopiées dans les tableaux contigus. Un corps intégré est
+    // interpolé ; un corps qui ne l'a pas été est posé sur sa transformation courante
+    // (t = 1), une seule fois.
+    for (size_t k = 0; k < syncCount; ++k){
+        int i = mSyncIndices[k];
+        const btTransform& previous = mPreviousTransforms[i];
+        const btTransform& current = mInterpolatedBodies[i]->getWorldTransform();
+        btQuaternion previousRotation = previous.getRotation();
+        btQuaternion currentRotation = current.getRotation();
+        // Même hémisphère : l'interpolation prend le plus court chemin
+        if (previousRotation.dot(currentRotation) < 0.0f){
+            currentRotation = -currentRotation;
+        }
+        bool atRest = !(mNodeFlags[i] & NodeMotionState::FLAG_MOVED);
+        mNodeFlags[i] = atRest ? 0 : NodeMotionState::FLAG_MOVED | NodeMotionState::FLAG_UNSETTLED;
+
+        float* from = &mSyncPrevious[k * SYNC_STRIDE];
+        float* to = &mSyncCurrent[k * SYNC_STRIDE];
+        from[0] = previous.getOrigin().x(); from[1] = previous.getOrigin().y(); from[2] = previous.getOrigin().z();
+        from[3] = atRest ? 1.0f : mInterpolationAlpha;
+        from[4] = previousRotation.x(); from[5] = previousRotation.y(); from[6] = previousRotation.z(); from[7] = previousRotation.w();
+        to[0] = current.getOrigin().x(); to[1] = current.getOrigin().y(); to[2] = current.getOrigin().z();
+        to[3] = 0.0f;
+        to[4] = currentRotation.x(); to[5] = currentRotation.y(); to[6] = currentRotation.z(); to[7] = currentRotation.w();
+    }
+
+    // 3. Interpolation sans branchement ni indirection : position linéaire, rotation
+    // normalisée (nlerp, égal au slerp à mieux que l'affichage près entre deux pas)
+    const float* from = mSyncPrevious.data();
+    const float* to = mSyncCurrent.data();
+    float* result = mSyncResult.data();
+    for (size_t k = 0; k < syncCount; ++k){
+        const size_t o = k * SYNC_STRIDE;
+        const float t = from[o + 3];
+        for (int c = 0; c < SYNC_STRIDE; ++c){
+            result[o + c] = from[o + c] + (to[o + c] - from[o + c]) * t;
+        }
+        float lengthSq = result[o + 4] * result[o + 4] + result[o + 5] * result[o + 5] +
+                         result[o + 6] * result[o + 6] + result[o + 7] * result[o + 7];
+        float inverseLength = 1.0f / std::sqrt(lengthSq);
+        result[o + 4] *= inverseLength;
+        result[o + 5] *= inverseLength;
+        result[o + 6] *= inverseLength;
+        result[o + 7] *= inverseLength;
+    }
+
+    // 4. Écriture dans les nœuds
+    for (size_t k = 0; k < syncCount; ++k){
+        const float* r = &result[k * SYNC_STRIDE];
+        Ogre::SceneNode* node = mInterpolatedNodes[mSyncIndices[k]];
+        node->setPosition(r[0], r[1], r[2]);
+        node->setOrientation(r[7], r[4], r[5], r[6]);
+    }
+}
+
+void PhysicsManager::clearMovedFlags(){
+    for (char& flags : mNodeFlags){
+        flags &= ~NodeMotionState::FLAG_MOVED;
+    }
+}
+
+void PhysicsManager::storePreviousTransforms(){
+    for (size_t i = 0; i < mInterpolatedBodies.size(); ++i){
+        mPreviousTransforms[i] = mInterpolatedBodies[i]->getWorldTransform();
+    }
+}
+
+btTransform PhysicsManager::getInterpolatedTransform(const btRigidBody* body) const{
+    const btTransform& current = body->getWorldTransform();
+    int index = findInterpolatedBody(body);
+    if (index < 0 || mInterpolationAlpha >= 1.0f){
+        return current;
+    }
+
+    const btTransform& previous = mPreviousTransforms[index];
+    btTransform blended;
+    blended.setOrigin(previous.getOrigin().lerp(current.getOrigin(), mInterpolationAlpha));
+    blended.setRotation(previous.getRotation().slerp(current.getRotation(), mInterpolationAlpha));
+    return blended;
+}
@@ -0,0 +1,239 @@
+#include "../../include/managers/PhysicsProfiler.h"
+#include <OgreBullet.h>
+#include <OgreLogManager.h>
+#include <LinearMath/btQuickprof.h>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Profileur qui reçoit les zones Bullet du thread courant (nullptr hors d'une frame mesurée)
+thread_local PhysicsProfiler* tActiveProfiler = nullptr;
+
+// Pile des zones ouvertes : btLeaveProfileZone ne donne pas le nom de la zone fermée
+struct OpenZone {
+    PhysicsProfiler::Phase phase;
+    Clock::time_point start;
+};
+const int MAX_ZONE_DEPTH = 32;
+thread_local OpenZone tZones[MAX_ZONE_DEPTH];
+thread_local int tZoneDepth = 0;
+
+// Les noms de zone sont des littéraux : après la première comparaison de chaînes,
+// la phase est retrouvée par l'adresse du nom
+struct KnownZone {
+    const char* name;
+    PhysicsProfiler::Phase phase;
+};
+const int MAX_KNOWN_ZONES = 64;
+thread_local KnownZone tKnownZones[MAX_KNOWN_ZONES];
+thread_local int tKnownZoneCount = 0;
+
+// Zones de btCollisionWorld / btDiscreteDynamicsWorld rattachées à chaque phase.
+// Aucune de ces zones n'est imbriquée dans une autre de la liste.
+const KnownZone PHASE_ZONES[] = {
+    {"updateAabbs", PhysicsProfiler::PHASE_BROADPHASE},
+    {"calculateOverlappingPairs", PhysicsProfiler::PHASE_BROADPHASE},
+    {"dispatchAllCollisionPairs", PhysicsProfiler::PHASE_NARROWPHASE},
+    {"calculateSimulationIslands", PhysicsProfiler::PHASE_SOLVER},
+    {"solveConstraints", PhysicsProfiler::PHASE_SOLVER},
+    {"predictUnconstraintMotion", PhysicsProfiler::PHASE_INTEGRATION},
+    {"createPredictiveContacts", PhysicsProfiler::PHASE_INTEGRATION},
+    {"integrateTransforms", PhysicsProfiler::PHASE_INTEGRATION},
+    {"updateActivationState", PhysicsProfiler::PHASE_INTEGRATION},
+    {"synchronizeMotionStates", PhysicsProfiler::PHASE_INTEGRATION},
+};
+
+PhysicsProfiler::Phase findZonePhase(const char* name) {
+    for (int i = 0; i < tKnownZoneCount; ++i) {
+        if (tKnownZones[i].name == name) {
+            return tKnownZones[i].phase;
+        }
+    }
+    PhysicsProfiler::Phase phase = PhysicsProfiler::PHASE_NONE;
+    for (const KnownZone& zone : PHASE_ZONES) {
+        if (std::strcmp(zone.name, name) == 0) {
+            phase = zone.phase;
+            break;
+        }
+    }
+    if (tKnownZoneCount < MAX_KNOWN_ZONES) {
+        tKnownZones[tKnownZoneCount++] = {name, phase};
+    }
+    return phase;
+}
+
+void enterProfileZone(const char* name) {
+    if (!tActiveProfiler) {
+        return;
+    }
+    if (tZoneDepth < MAX_ZONE_DEPTH) {
+        tZones[tZoneDepth] = {findZonePhase(name), Clock::now()};
+    }
+    ++tZoneDepth;
+}
+
+void leaveProfileZone() {
+    if (!tActiveProfiler || tZoneDepth == 0) {
+        return;
+    }
+    --tZoneDepth;
+    if (tZoneDepth < MAX_ZONE_DEPTH && tZones[tZoneDepth].phase != PhysicsProfiler::PHASE_NONE) {
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - tZones[tZoneDepth].start).count();
+        tActiveProfiler->addPhaseTime(tZones[tZoneDepth].phase, ms);
+    }
+}
+
+// Les fonctions de zone sont globales dans Bullet : installées une seule fois, elles
+// remplacent le CProfileManager par défaut (qui n'est pas utilisé ici)
+void installProfileZoneHooks() {
+    static std::once_flag installed;
+    std::call_once(installed, []() {
+        btSetCustomEnterProfileZoneFunc(enterProfileZone);
+        btSetCustomLeaveProfileZoneFunc(leaveProfileZone);
+    });
+}
+
+} // namespace
+
+PhysicsProfiler::PhysicsProfiler()
+    : mEnabled(false),
+      mFrameCount(0),
+      mPhaseMs{},
+      mDumpFormat(DUMP_CSV)
+{}
+
+PhysicsProfiler::~PhysicsProfiler() {
+    if (tActiveProfiler == this) {
+        tActiveProfiler = nullptr;
+    }
+    stopDump();
+}
+
+void PhysicsProfiler::setEnabled(bool enabled) {
+    if (enabled) {
+        installProfileZoneHooks();
+    }
+    mEnabled = enabled;
+}
+
+const char* PhysicsProfiler::getPhaseName(Phase phase) {
+    switch (phase) {
+        case PHASE_BROADPHASE: return "broadphase";
+        case PHASE_NARROWPHASE: return "narrowphase";
+        case PHASE_SOLVER: return "solver";
+        case PHASE_INTEGRATION: return "integration";
+        default: return "none";
+    }
+}
+
+void PhysicsProfiler::beginFrame() {
+    if (!mEnabled) {
+        return;
+    }
+    mCurrent = PhysicsFrameStats();
+    std::fill(std::begin(mPhaseMs), std::end(mPhaseMs), 0.0);
+    tActiveProfiler = this;
+    tZoneDepth = 0;
+}
+
+void PhysicsProfiler::beginStep() {
+    if (mEnabled) {
+        mStepStart = Clock::now();
+    }
+}
+
+void PhysicsProfiler::endStep(btDynamicsWorld* world) {
+    if (!mEnabled) {
+        return;
+    }
+    mCurrent.totalMs += std::chrono::duration<double, std::milli>(Clock::now() - mStepStart).count();
+    ++mCurrent.steps;
+    collectCounters(world);
+}
+
+void PhysicsProfiler::endFrame() {
+    if (!mEnabled) {
+        return;
+    }
+    tActiveProfiler = nullptr;
+
+    mCurrent.frame = ++mFrameCount;
+    mCurrent.broadphaseMs = mPhaseMs[PHASE_BROADPHASE];
+    mCurrent.narrowphaseMs = mPhaseMs[PHASE_NARROWPHASE];
+    mCurrent.solverMs = mPhaseMs[PHASE_SOLVER];
+    mCurrent.integrationMs = mPhaseMs[PHASE_INTEGRATION];
+    mLast = mCurrent;
+
+    if (mDump.is_open()) {
+        writeDumpRow(mLast);
+    }
+}
+
+void PhysicsProfiler::collectCounters(btDynamicsWorld* world) {
+    const btCollisionObjectArray& objects = world->getCollisionObjectArray();
+    mCurrent.bodies = objects.size();
+    mCurrent.activeBodies = 0;
+    mIslandTags.clear();
+    for (int i = 0; i < objects.size(); ++i) {
+        const btCollisionObject* object = objects[i];
+        if (object->isStaticOrKinematicObject() || !object->isActive()) {
+            continue;
+        }
+        ++mCurrent.activeBodies;
+        mIslandTags.push_back(object->getIslandTag());
+    }
+    std::sort(mIslandTags.begin(), mIslandTags.end());
+    mCurrent.islands = static_cast<int>(std::unique(mIslandTags.begin(), mIslandTags.end()) - mIslandTags.begin());
+
+    mCurrent.overlappingPairs = world->getBroadphase()->getOverlappingPairCache()->getNumOverlappingPairs();
+
+    btDispatcher* dispatcher = world->getDispatcher();
+    mCurrent.manifolds = dispatcher->getNumManifolds();
+    mCurrent.contactPoints = 0;
+    for (int m = 0; m < mCurrent.manifolds; ++m) {
+        mCurrent.contactPoints += dispatcher->getManifoldByIndexInternal(m)->getNumContacts();
+    }
+}
+
+bool PhysicsProfiler::startDump(const std::string& path, DumpFormat format) {
+    stopDump();
+    mDump.open(path, std::ios::out | std::ios::trunc);
+    if (!mDump.is_open()) {
+        Ogre::LogManager::getSingleton().logWarning("PhysicsProfiler::startDump - impossible d'ouvrir " + path);
+        return false;
+    }
+    mDumpFormat = format;
+    if (format == DUMP_CSV) {
+        mDump << "frame,steps,total_ms,broadphase_ms,narrowphase_ms,solver_ms,integration_ms,"
+                 "bodies,active_bodies,islands,pairs,manifolds,contacts\n";
+    }
+    setEnabled(true);
+    return true;
+}
+
+void PhysicsProfiler::stopDump() {
+    if (mDump.is_open()) {
+        mDump.close();
+    }
+}
+
+void PhysicsProfiler::writeDumpRow(const PhysicsFrameStats& stats) {
+    if (mDumpFormat == DUMP_CSV) {
+        mDump << stats.frame << ',' << stats.steps << ',' << stats.totalMs << ',' << stats.broadphaseMs << ','
+              << stats.narrowphaseMs << ',' << stats.solverMs << ',' << stats.integrationMs << ','
+              << stats.bodies << ',' << stats.activeBodies << ',' << stats.islands << ','
+              << stats.overlappingPairs << ',' << stats.manifolds << ',' << stats.contactPoints << '\n';
+        return;
+    }
+    mDump << "{\"frame\":" << stats.frame << ",\"steps\":" << stats.steps
+          << ",\"total_ms\":" << stats.totalMs << ",\"broadphase_ms\":" << stats.broadphaseMs
+          << ",\"narrowphase_ms\":" << stats.narrowphaseMs << ",\"solver_ms\":" << stats.solverMs
+          << ",\"integration_ms\":" << stats.integrationMs << ",\"bodies\":" << stats.bodies
+          << ",\"active_bodies\":" << stats.activeBodies << ",\"islands\":" << stats.islands
+          << ",\"pairs\":" << stats.overlappingPairs << ",\"manifolds\":" << stats.manifolds
+          << ",\"contacts\":" << stats.contactPoints << "}\n";
+}
@@ -0,0 +1,22 @@
+#include "../../include/managers/PhysicsSnapshot.h"
+
+PhysicsSnapshot::PhysicsSnapshot(size_t maxBodies, size_t maxManifolds, size_t maxPoints, size_t maxPairs)
+    : mMaxBodies(maxBodies),
+      mMaxPairs(maxPairs),
+      mMaxManifolds(maxManifolds),
+      mMaxPoints(maxPoints),
+      mStepCount(0),
+      mSimulatedTime(0.0),
+      mValid(false)
+{
+    mBodies.reserve(maxBodies);
+    mPairs.reserve(maxPairs);
+    mManifolds.reserve(maxManifolds);
+    mManifoldOrder.reserve(maxManifolds);
+    mPoints.reserve(maxPoints);
+}
+
+size_t PhysicsSnapshot::getCapacityBytes() const {
+    return mMaxBodies * sizeof(BodyState) + mMaxPairs * sizeof(PairState) +
+           mMaxManifolds * (sizeof(ManifoldState) + sizeof(int)) + mMaxPoints * sizeof(btManifoldPoint);
+}
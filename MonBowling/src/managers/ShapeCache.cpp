@@ -0,0 +1,438 @@
+#include "../../include/managers/ShapeCache.h"
+#include <BulletCollision/BroadphaseCollision/btDbvt.h>
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+// Réglages par défaut : 32 sommets suffisent à la silhouette d'une quille,
+// 4 cylindres décrivent la base, le ventre, le col et la tête
+static const int DEFAULT_HULL_VERTEX_BUDGET = 32;
+static const int DEFAULT_CYLINDER_SEGMENTS = 4;
+static const int MIN_HULL_VERTEX_BUDGET = 8;
+// Marge Bullet par défaut, réduite pour les cylindres trop fins
+static const float DEFAULT_SHAPE_MARGIN = 0.04f;
+static const float MIN_CYLINDER_RADIUS = 0.005f;
+// Valeurs d'une description : dimensions internes (3), échelle (3), marge pour les formes
+// simples ; 12 valeurs par enfant (base ligne par ligne puis origine) pour une forme composée
+static const size_t PRIMITIVE_VALUE_COUNT = 7;
+static const size_t HULL_HEADER_COUNT = 4;
+static const size_t PLANE_VALUE_COUNT = 7;
+static const size_t COMPOUND_HEADER_COUNT = 2;
+static const size_t CHILD_TRANSFORM_COUNT = 12;
+
+void ShapeDeleter::operator()(btCollisionShape* shape) const{
+    if (shape && shape->isCompound()){
+        btCompoundShape* compound = static_cast<btCompoundShape*>(shape);
+        for (int i = compound->getNumChildShapes() - 1; i >= 0; --i){
+            delete compound->getChildShape(i);
+        }
+    }
+    delete shape;
+}
+
+ShapeCache::ShapeCache()
+    : mQuality(QUALITY_MEDIUM),
+      mHullVertexBudget(DEFAULT_HULL_VERTEX_BUDGET),
+      mCylinderSegments(DEFAULT_CYLINDER_SEGMENTS)
+{}
+
+void ShapeCache::setHullVertexBudget(int vertices){
+    mHullVertexBudget = std::max(MIN_HULL_VERTEX_BUDGET, vertices);
+}
+
+void ShapeCache::setCylinderSegments(int segments){
+    mCylinderSegments = std::max(1, segments);
+}
+
+std::string ShapeCache::makeMeshKey(const Ogre::MeshPtr& mesh, const Ogre::Vector3& scale) const{
+    std::string key = mesh->getName() + "|" + Ogre::StringConverter::toString(scale) + "|";
+    switch (mQuality){
+        case QUALITY_LOW: return key + "cylinders" + Ogre::StringConverter::toString(mCylinderSegments);
+        case QUALITY_MEDIUM: return key + "hull" + Ogre::StringConverter::toString(mHullVertexBudget);
+        default: return key + "hull";
+    }
+}
+
+btCollisionShape* ShapeCache::getMeshShape(const Ogre::MeshPtr& mesh, const Ogre::Vector3& scale){
+    if (!mesh){
+        return nullptr;
+    }
+
+    std::string key = makeMeshKey(mesh, scale);
+    btCollisionShape* cached = findShape(key);
+    if (cached){
+        return cached;
+    }
+
+    std::vector<btVector3> vertices = collectVertices(mesh, scale);
+    if (vertices.empty()){
+        Ogre::LogManager::getSingleton().logError("ShapeCache::getMeshShape - aucun sommet dans " + mesh->getName());
+        return nullptr;
+    }
+
+    btCollisionShape* shape = nullptr;
+    switch (mQuality){
+        case QUALITY_LOW:
+            shape = buildCylinderStack(vertices, mCylinderSegments);
+            break;
+        case QUALITY_MEDIUM:
+            shape = buildReducedHull(vertices, mHullVertexBudget);
+            break;
+        default: {
+            // Même volume que CT_HULL, sans les sommets intérieurs
+            btConvexHullShape* hull = buildHull(vertices);
+            hull->optimizeConvexHull();
+            // Boîte englobante recalculée sur les seuls sommets gardés, comme le fera
+            // createShape à partir de la description de la forme
+            hull->recalcLocalAabb();
+            shape = hull;
+            break;
+        }
+    }
+
+    Ogre::LogManager::getSingleton().logMessage("ShapeCache - forme " + key + " construite (" +
+        Ogre::StringConverter::toString(vertices.size()) + " sommets source, " +
+        Ogre::StringConverter::toString(estimateMemory(shape)) + " octets)");
+    return addShape(key, shape);
+}
+
+btCollisionShape* ShapeCache::findShape(const std::string& key) const{
+    auto it = mShapes.find(key);
+    return (it != mShapes.end()) ? it->second.get() : nullptr;
+}
+
+btCollisionShape* ShapeCache::addShape(const std::string& key, btCollisionShape* shape){
+    auto it = mShapes.find(key);
+    if (it != mShapes.end()){
+        ShapeDeleter()(shape);
+        return it->second.get();
+    }
+    btCollisionShape* stored = shape;
+    mShapes.emplace(key, std::unique_ptr<btCollisionShape, ShapeDeleter>(shape));
+    return stored;
+}
+
+size_t ShapeCache::getMemoryUsage() const{
+    size_t bytes = 0;
+    for (const auto& entry : mShapes){
+        bytes += estimateMemory(entry.second.get());
+    }
+    return bytes;
+}
+
+std::vector<btVector3> ShapeCache::collectVertices(const Ogre::MeshPtr& mesh, const Ogre::Vector3& scale){
+    std::vector<btVector3> vertices;
+
+    auto addVertexData = [&](const Ogre::VertexData* data){
+        const Ogre::VertexElement* position = data->vertexDeclaration->findElementBySemantic(Ogre::VES_POSITION);
+        if (!position){
+            return;
+        }
+        Ogre::HardwareVertexBufferSharedPtr buffer = data->vertexBufferBinding->getBuffer(position->getSource());
+        Ogre::HardwareBufferLockGuard lock(buffer, Ogre::HardwareBuffer::HBL_READ_ONLY);
+
+        const size_t stride = buffer->getVertexSize();
+        unsigned char* vertex = static_cast<unsigned char*>(lock.pData) + data->vertexStart * stride;
+        for (size_t i = 0; i < data->vertexCount; ++i, vertex += stride){
+            float* xyz;
+            position->baseVertexPointerToElement(vertex, &xyz);
+            vertices.emplace_back(xyz[0] * scale.x, xyz[1] * scale.y, xyz[2] * scale.z);
+        }
+    };
+
+    if (mesh->sharedVertexData){
+        addVertexData(mesh->sharedVertexData);
+    }
+    for (const Ogre::SubMesh* subMesh : mesh->getSubMeshes()){
+        if (!subMesh->useSharedVertices && subMesh->vertexData){
+            addVertexData(subMesh->vertexData);
+        }
+    }
+    return vertices;
+}
+
+btConvexHullShape* ShapeCache::buildHull(const std::vector<btVector3>& vertices){
+    btConvexHullShape* hull = new btConvexHullShape();
+    for (const btVector3& vertex : vertices){
+        hull->addPoint(vertex, false);
+    }
+    hull->recalcLocalAabb();
+    return hull;
+}
+
+btConvexHullShape* ShapeCache::buildReducedHull(const std::vector<btVector3>& vertices, int vertexBudget){
+    if (static_cast<int>(vertices.size()) <= vertexBudget){
+        return buildHull(vertices);
+    }
+
+    // Directions réparties uniformément (spirale de Fibonacci) ; pour chacune on garde
+    // le sommet le plus loin dans cette direction, qui est un sommet de l'enveloppe
+    const float goldenAngle = 3.14159265f * (3.0f - std::sqrt(5.0f));
+    std::set<size_t> selected;
+    for (int i = 0; i < vertexBudget; ++i){
+        float y = 1.0f - 2.0f * (i + 0.5f) / vertexBudget;
+        float radius = std::sqrt(std::max(0.0f, 1.0f - y * y));
+        float angle = goldenAngle * i;
+        btVector3 direction(radius * std::cos(angle), y, radius * std::sin(angle));
+
+        size_t best = 0;
+        btScalar bestDot = vertices[0].dot(direction);
+        for (size_t v = 1; v < vertices.size(); ++v){
+            btScalar dot = vertices[v].dot(direction);
+            if (dot > bestDot){
+                bestDot = dot;
+                best = v;
+            }
+        }
+        selected.insert(best);
+    }
+
+    btConvexHullShape* hull = new btConvexHullShape();
+    for (size_t index : selected){
+        hull->addPoint(vertices[index], false);
+    }
+    hull->recalcLocalAabb();
+    return hull;
+}
+
+btCompoundShape* ShapeCache::buildCylinderStack(const std::vector<btVector3>& vertices, int segments){
+    btVector3 minimum = vertices[0];
+    btVector3 maximum = vertices[0];
+    for (const btVector3& vertex : vertices){
+        minimum.setMin(vertex);
+        maximum.setMax(vertex);
+    }
+
+    // Axe vertical au centre de la boîte englobante
+    const float centerX = 0.5f * (minimum.x() + maximum.x());
+    const float centerZ = 0.5f * (minimum.z() + maximum.z());
+    const float height = std::max(maximum.y() - minimum.y(), 0.001f);
+    const float segmentHeight = height / segments;
+
+    std::vector<float> radii(segments, 0.0f);
+    std::vector<bool> filled(segments, false);
+    for (const btVector3& vertex : vertices){
+        int segment = std::min(segments - 1, static_cast<int>((vertex.y() - minimum.y()) / segmentHeight));
+        float dx = vertex.x() - centerX;
+        float dz = vertex.z() - centerZ;
+        radii[segment] = std::max(radii[segment], std::sqrt(dx * dx + dz * dz));
+        filled[segment] = true;
+    }
+
+    // Tranche sans sommet (mesh peu détaillé) : rayon des tranches voisines
+    for (int i = 0; i < segments; ++i){
+        if (filled[i]) continue;
+        float neighbour = 0.0f;
+        for (int j = i - 1; j >= 0; --j){ if (filled[j]) { neighbour = std::max(neighbour, radii[j]); break; } }
+        for (int j = i + 1; j < segments; ++j){ if (filled[j]) { neighbour = std::max(neighbour, radii[j]); break; } }
+        radii[i] = neighbour;
+    }
+
+    btCompoundShape* compound = new btCompoundShape(true, segments);
+    for (int i = 0; i < segments; ++i){
+        float radius = std::max(radii[i], MIN_CYLINDER_RADIUS);
+        float halfHeight = 0.5f * segmentHeight;
+        btCylinderShape* cylinder = new btCylinderShape(btVector3(radius, halfHeight, radius));
+        cylinder->setMargin(std::min(DEFAULT_SHAPE_MARGIN, 0.5f * std::min(radius, halfHeight)));
+
+        btTransform childTransform;
+        childTransform.setIdentity();
+        childTransform.setOrigin(btVector3(centerX, minimum.y() + (i + 0.5f) * segmentHeight, centerZ));
+        compound->addChildShape(childTransform, cylinder);
+    }
+    return compound;
+}
+
+size_t ShapeCache::estimateMemory(const btCollisionShape* shape){
+    if (!shape){
+        return 0;
+    }
+    switch (shape->getShapeType()){
+        case CONVEX_HULL_SHAPE_PROXYTYPE:
+            return sizeof(btConvexHullShape) +
+                   static_cast<const btConvexHullShape*>(shape)->getNumPoints() * sizeof(btVector3);
+        case COMPOUND_SHAPE_PROXYTYPE: {
+            const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+            int children = compound->getNumChildShapes();
+            size_t bytes = sizeof(btCompoundShape) + children * sizeof(btCompoundShapeChild);
+            if (compound->getDynamicAabbTree()){
+                bytes += sizeof(btDbvt) + std::max(0, 2 * children - 1) * sizeof(btDbvtNode);
+            }
+            for (int i = 0; i < children; ++i){
+                bytes += estimateMemory(compound->getChildShape(i));
+            }
+            return bytes;
+        }
+        case CYLINDER_SHAPE_PROXYTYPE: return sizeof(btCylinderShape);
+        case BOX_SHAPE_PROXYTYPE: return sizeof(btBoxShape);
+        case SPHERE_SHAPE_PROXYTYPE: return sizeof(btSphereShape);
+        case STATIC_PLANE_PROXYTYPE: return sizeof(btStaticPlaneShape);
+        default: return sizeof(btCollisionShape);
+    }
+}
+
+namespace {
+    void appendVector(std::vector<float>& values, const btVector3& vector){
+        values.push_back(vector.x());
+        values.push_back(vector.y());
+        values.push_back(vector.z());
+    }
+
+    btVector3 readVector(const std::vector<float>& values, size_t offset){
+        return btVector3(values[offset], values[offset + 1], values[offset + 2]);
+    }
+
+    bool sameVector(const btVector3& a, const btVector3& b){
+        return a.x() == b.x() && a.y() == b.y() && a.z() == b.z();
+    }
+}
+
+bool ShapeCache::describeShape(const btCollisionShape* shape, ShapeDescription& description){
+    description = ShapeDescription();
+    if (!shape){
+        return false;
+    }
+
+    const int type = shape->getShapeType();
+    std::vector<float>& values = description.values;
+    switch (type){
+        case SPHERE_SHAPE_PROXYTYPE:
+        case BOX_SHAPE_PROXYTYPE:
+        case CYLINDER_SHAPE_PROXYTYPE: {
+            if (type == CYLINDER_SHAPE_PROXYTYPE &&
+                static_cast<const btCylinderShape*>(shape)->getUpAxis() != 1){
+                return false;
+            }
+            const btConvexInternalShape* convex = static_cast<const btConvexInternalShape*>(shape);
+            appendVector(values, convex->getImplicitShapeDimensions());
+            appendVector(values, convex->getLocalScaling());
+            values.push_back(convex->getMargin());
+            break;
+        }
+        case CONVEX_HULL_SHAPE_PROXYTYPE: {
+            const btConvexHullShape* hull = static_cast<const btConvexHullShape*>(shape);
+            appendVector(values, hull->getLocalScaling());
+            values.push_back(hull->getMargin());
+            const btVector3* points = hull->getUnscaledPoints();
+            for (int i = 0; i < hull->getNumPoints(); ++i){
+                appendVector(values, points[i]);
+            }
+            break;
+        }
+        case STATIC_PLANE_PROXYTYPE: {
+            const btStaticPlaneShape* plane = static_cast<const btStaticPlaneShape*>(shape);
+            // Le constructeur normalise la normale : elle doit revenir identique
+            if (!sameVector(plane->getPlaneNormal(), plane->getPlaneNormal().normalized())){
+                return false;
+            }
+            appendVector(values, plane->getPlaneNormal());
+            values.push_back(plane->getPlaneConstant());
+            appendVector(values, plane->getLocalScaling());
+            break;
+        }
+        case COMPOUND_SHAPE_PROXYTYPE: {
+            const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+            // Une échelle différente de 1 a déjà été appliquée aux enfants
+            if (!sameVector(compound->getLocalScaling(), btVector3(1, 1, 1))){
+                return false;
+            }
+            values.push_back(compound->getMargin());
+            values.push_back(compound->getDynamicAabbTree() ? 1.0f : 0.0f);
+            for (int i = 0; i < compound->getNumChildShapes(); ++i){
+                const btTransform& transform = compound->getChildTransform(i);
+                for (int row = 0; row < 3; ++row){
+                    appendVector(values, transform.getBasis()[row]);
+                }
+                appendVector(values, transform.getOrigin());
+
+                ShapeDescription child;
+                if (!describeShape(compound->getChildShape(i), child)){
+                    description = ShapeDescription();
+                    return false;
+                }
+                description.children.push_back(std::move(child));
+            }
+            break;
+        }
+        default:
+            return false;
+    }
+    description.type = type;
+    return true;
+}
+
+btCollisionShape* ShapeCache::createShape(const ShapeDescription& description){
+    const std::vector<float>& values = description.values;
+    switch (description.type){
+        case SPHERE_SHAPE_PROXYTYPE:
+        case BOX_SHAPE_PROXYTYPE:
+        case CYLINDER_SHAPE_PROXYTYPE: {
+            if (values.size() != PRIMITIVE_VALUE_COUNT || !description.children.empty()){
+                return nullptr;
+            }
+            const btVector3 implicit = readVector(values, 0);
+            btConvexInternalShape* convex;
+            if (description.type == SPHERE_SHAPE_PROXYTYPE){
+                convex = new btSphereShape(implicit.x());
+            } else if (description.type == BOX_SHAPE_PROXYTYPE){
+                convex = new btBoxShape(implicit);
+            } else {
+                convex = new btCylinderShape(implicit);
+            }
+            // setLocalScaling et setMargin retouchent les dimensions internes des boîtes et
+            // des cylindres : les valeurs enregistrées sont posées en dernier. La marge d'une
+            // sphère est son rayon (getMargin), déjà fixée par le constructeur.
+            convex->setLocalScaling(readVector(values, 3));
+            if (description.type != SPHERE_SHAPE_PROXYTYPE){
+                convex->setMargin(values[6]);
+            }
+            convex->setImplicitShapeDimensions(implicit);
+            return convex;
+        }
+        case CONVEX_HULL_SHAPE_PROXYTYPE: {
+            if (values.size() < HULL_HEADER_COUNT || (values.size() - HULL_HEADER_COUNT) % 3 != 0 ||
+                !description.children.empty()){
+                return nullptr;
+            }
+            btConvexHullShape* hull = new btConvexHullShape();
+            hull->setMargin(values[3]);
+            hull->setLocalScaling(readVector(values, 0));
+            for (size_t i = HULL_HEADER_COUNT; i < values.size(); i += 3){
+                hull->addPoint(readVector(values, i), false);
+            }
+            hull->recalcLocalAabb();
+            return hull;
+        }
+        case STATIC_PLANE_PROXYTYPE: {
+            if (values.size() != PLANE_VALUE_COUNT || !description.children.empty()){
+                return nullptr;
+            }
+            btStaticPlaneShape* plane = new btStaticPlaneShape(readVector(values, 0), values[3]);
+            plane->setLocalScaling(readVector(values, 4));
+            return plane;
+        }
+        case COMPOUND_SHAPE_PROXYTYPE: {
+            const size_t children = description.children.size();
+            if (values.size() != COMPOUND_HEADER_COUNT + children * CHILD_TRANSFORM_COUNT){
+                return nullptr;
+            }
+            btCompoundShape* compound = new btCompoundShape(values[1] != 0.0f, static_cast<int>(children));
+            compound->setMargin(values[0]);
+            for (size_t i = 0; i < children; ++i){
+                btCollisionShape* child = createShape(description.children[i]);
+                if (!child){
+                    ShapeDeleter()(compound);
+                    return nullptr;
+                }
+                const size_t offset = COMPOUND_HEADER_COUNT + i * CHILD_TRANSFORM_COUNT;
+                btMatrix3x3 basis(values[offset], values[offset + 1], values[offset + 2],
+                                  values[offset + 3], values[offset + 4], values[offset + 5],
+                                  values[offset + 6], values[offset + 7], values[offset + 8]);
+                compound->addChildShape(btTransform(basis, readVector(values, offset + 9)), child);
+            }
+            return compound;
+        }
+        default:
+            return nullptr;
+    }
+}
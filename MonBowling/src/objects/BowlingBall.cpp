@@ -2,31 +2,31 @@
 #include "../../include/managers/PhysicsManager.h" 
 #include <OgreLogManager.h>
 #include <OgreStringConverter.h>
+#include "../../include/utils/SimulationLog.h"
 
-BowlingBall::BowlingBall(Ogre::SceneManager* sceneMgr, const Ogre::String& meshName)
+BowlingBall::BowlingBall(Ogre::SceneManager* sceneMgr, const Ogre::String& meshName, PhysicsManager* physics)
     : sceneMgr(sceneMgr),
+      physicsManager(physics ? physics : PhysicsManager::getInstance()),
       ballNode(nullptr),
       ballEntity(nullptr),
       ballBody(nullptr),
       radius(0.108f), 
       mass(7.0f),     
       rolling(false),
+      hasBodyProperties(false),
       initialPosition(Ogre::Vector3::ZERO),
       scale(0.02f) 
 {}
 
 BowlingBall::~BowlingBall() {
+    physicsManager->removeTickListener(this);
     if (ballBody) {
-        auto* world = PhysicsManager::getInstance()->getDynamicsWorld()->getBtWorld();
-        if (world) {
-            world->removeRigidBody(ballBody);
-        }
+        physicsManager->removeRigidBody(ballBody);
         ballBody = nullptr; 
     }
 }
 
 void BowlingBall::create(const Ogre::Vector3& position) {
-    auto physicsManager = PhysicsManager::getInstance();
     if (!physicsManager || !physicsManager->getDynamicsWorld()) {
         Ogre::LogManager::getSingleton().logError("BowlingBall::create - PhysicsManager ou DynamicsWorld non initialisé");
         return;
@@ -34,6 +34,29 @@ void BowlingBall::create(const Ogre::Vector3& position) {
 
     initialPosition = position;
 
+    // Simulation sans rendu : sphère Bullet directe, sans nœud ni entité
+    if (!sceneMgr) {
+        btTransform startTransform;
+        startTransform.setIdentity();
+        startTransform.setOrigin(btVector3(position.x, position.y, position.z));
+        float sphereRadius = hasBodyProperties ? bodyProperties.collisionRadius : radius;
+        btCollisionShape* shape = headlessShape ? headlessShape.release() : new btSphereShape(sphereRadius);
+        ballBody = physicsManager->addPrimitiveRigidBody(mass, shape, startTransform);
+        if (ballBody) {
+            configureBody();
+            if (hasBodyProperties) {
+                ballBody->setMassProps(bodyProperties.mass, bodyProperties.localInertia);
+                ballBody->updateInertiaTensor();
+                ballBody->setFriction(bodyProperties.friction);
+                ballBody->setRestitution(bodyProperties.restitution);
+                ballBody->setRollingFriction(bodyProperties.rollingFriction);
+                ballBody->setSpinningFriction(bodyProperties.spinningFriction);
+                ballBody->setDamping(bodyProperties.linearDamping, bodyProperties.angularDamping);
+            }
+        }
+        return;
+    }
+
     // Création du nœud de scène
     ballNode = sceneMgr->getRootSceneNode()->createChildSceneNode("BowlingBallNode");
     ballNode->setPosition(position);
@@ -53,17 +76,15 @@ void BowlingBall::create(const Ogre::Vector3& position) {
 
     // Création du corps rigide
     try {
-        ballBody = physicsManager->getDynamicsWorld()->addRigidBody(
-                mass, ballEntity, Ogre::Bullet::CT_SPHERE);
+        // Sphère ajustée au mesh ; le nœud est placé par PhysicsManager::syncSceneNodes
+        btTransform startTransform;
+        startTransform.setIdentity();
+        startTransform.setOrigin(btVector3(position.x, position.y, position.z));
+        ballBody = physicsManager->addPrimitiveRigidBody(
+                mass, Ogre::Bullet::createSphereCollider(ballEntity), startTransform, ballNode);
 
         if (ballBody) {
-            ballBody->setFriction(0.3f);
-            ballBody->setRestitution(0.3f);
-            ballBody->setRollingFriction(0.3f);
-            ballBody->setSpinningFriction(0.2f);
-
-            // Empêcher la désactivation pour que la boule continue de rouler
-            ballBody->setActivationState(DISABLE_DEACTIVATION);
+            configureBody();
             Ogre::LogManager::getSingleton().logMessage("BowlingBall::create - Corps rigide créé avec succès.");
         } else {
              Ogre::LogManager::getSingleton().logError("BowlingBall::create - addRigidBody a retourné nullptr.");
@@ -79,13 +100,51 @@ void BowlingBall::create(const Ogre::Vector3& position) {
     }
 }
 
+void BowlingBall::configureBody() {
+    PhysicsManager::setBodyRole(ballBody, BodyRole::BALL);
+    ballBody->setFriction(0.3f);
+    ballBody->setRestitution(0.3f);
+    ballBody->setRollingFriction(0.3f);
+    ballBody->setSpinningFriction(0.2f);
+
+    // Empêcher la désactivation pour que la boule continue de rouler
+    ballBody->setActivationState(DISABLE_DEACTIVATION);
+
+    // Interpolation entre deux pas fixes (déjà enregistrée quand la boule a un nœud)
+    physicsManager->registerInterpolatedBody(ballBody);
+
+    // Effet du spin à chaque pas interne de Bullet
+    physicsManager->addTickListener(this);
+
+    applyCcdProfile();
+}
+
+void BowlingBall::applyCcdProfile() {
+    if (!ballBody) {
+        return;
+    }
+    // Rapports appliqués à la forme réelle, pas au rayon nominal : en jeu la sphère est
+    // ajustée au mesh. Un seuil nul désactive la détection continue dans Bullet.
+    float collisionRadius = getCollisionRadius();
+    float threshold = ccdProfile.enabled ? collisionRadius * ccdProfile.motionThresholdRatio : 0.0f;
+    ballBody->setCcdMotionThreshold(threshold);
+    ballBody->setCcdSweptSphereRadius(collisionRadius * ccdProfile.sweptSphereRatio);
+}
+
+void BowlingBall::setCcdProfile(const BallCcdProfile& profile) {
+    ccdProfile = profile;
+    applyCcdProfile();
+}
+
 void BowlingBall::reset() {
-    if (ballNode && ballBody) {
-        // Réinitialiser la position et l'orientation Ogre
-        ballNode->setPosition(initialPosition);
-        ballNode->setOrientation(Ogre::Quaternion::IDENTITY);
-        Ogre::LogManager::getSingleton().logMessage("[BowlingBall::reset] Noeud Ogre réinitialisé à : " +
-            Ogre::StringConverter::toString(initialPosition));
+    if (ballBody) {
+        // Réinitialiser la position et l'orientation Ogre (absent en simulation sans rendu)
+        if (ballNode) {
+            ballNode->setPosition(initialPosition);
+            ballNode->setOrientation(Ogre::Quaternion::IDENTITY);
+            SimulationLog::message("[BowlingBall::reset] Noeud Ogre réinitialisé à : " +
+                Ogre::StringConverter::toString(initialPosition));
+        }
 
         ballBody->setLinearVelocity(btVector3(0, 0, 0));
         ballBody->setAngularVelocity(btVector3(0, 0, 0));
@@ -105,12 +164,15 @@ void BowlingBall::reset() {
         // Réactiver le corps si nécessaire (même si on utilise DISABLE_DEACTIVATION)
         ballBody->activate(true);
 
-        Ogre::LogManager::getSingleton().logMessage("[BowlingBall::reset] Corps physique réinitialisé à : " +
+        // Pas d'interpolation depuis l'ancienne position après la téléportation
+        physicsManager->resetInterpolation(ballBody);
+
+        SimulationLog::message("[BowlingBall::reset] Corps physique réinitialisé à : " +
             Ogre::StringConverter::toString(initialPosition));
 
         rolling = false;
     } else {
-        Ogre::LogManager::getSingleton().logWarning("[BowlingBall::reset] Tentative de réinitialisation mais ballNode ou ballBody est nul.");
+        Ogre::LogManager::getSingleton().logWarning("[BowlingBall::reset] Tentative de réinitialisation mais ballBody est nul.");
     }
 }
 
@@ -143,7 +205,7 @@ void BowlingBall::launch(const Ogre::Vector3& direction, float power, float spin
         ballBody->activate(true);
         rolling = true;
         
-        Ogre::LogManager::getSingleton().logMessage(
+        SimulationLog::message(
             "BowlingBall::launch - Vitesse: " + Ogre::StringConverter::toString(power) +
             " Spin Y: " + Ogre::StringConverter::toString(spin) +
             " Direction: " + Ogre::StringConverter::toString(normalizedDir));
@@ -151,46 +213,19 @@ void BowlingBall::launch(const Ogre::Vector3& direction, float power, float spin
 }
 
 void BowlingBall::update(float deltaTime) {
-    if (ballBody && ballNode && rolling) {
-        // --- Synchronisation Ogre <-> Bullet --- 
-        btTransform transform;
-        // Utiliser getWorldTransform directement peut être plus fiable que getMotionState
-        transform = ballBody->getWorldTransform();
-        // if (ballBody->getMotionState()) {
-        //     ballBody->getMotionState()->getWorldTransform(transform);
-        // } else {
-        //     transform = ballBody->getWorldTransform();
-        // }
-
-        // Mise à jour de la position Ogre
-        btVector3 position = transform.getOrigin();
-        ballNode->setPosition(position.x(), position.y(), position.z());
-
-        // Mise à jour de la rotation Ogre
-        btQuaternion rotation = transform.getRotation();
-        ballNode->setOrientation(rotation.w(), rotation.x(), rotation.y(), rotation.z());
-
-        updateSpin(deltaTime);
+    if (ballBody && rolling) {
+        // Le nœud suit le corps via PhysicsManager::syncSceneNodes
 
-        btVector3 velocity = ballBody->getLinearVelocity();
-        btVector3 angularVelocity = ballBody->getAngularVelocity();
-        float linearSpeedSq = velocity.length2();
-        float angularSpeedSq = angularVelocity.length2();
-
-        // Ajouter ce log toutes les 30 frames environ pour ne pas surcharger la console
-        static int frameCount = 0;
-        if (++frameCount % 10 == 0) {
-            Ogre::LogManager::getSingleton().logMessage("BowlingBall::update - Vitesse linéaire: " + 
-                Ogre::StringConverter::toString(sqrt(linearSpeedSq)) + 
-                ", Vitesse angulaire: " + Ogre::StringConverter::toString(sqrt(angularSpeedSq)) +
-                ", Seuil: " + Ogre::StringConverter::toString(STOP_VELOCITY_THRESHOLD));
-        }
+        // Logique d'arrêt : état physique réel (non interpolé)
+        btVector3 position = ballBody->getWorldTransform().getOrigin();
+
+        // Pas de journal à chaque pas : update est sur le chemin du pas de toutes les pistes
 
         // --- Vérification des conditions d'arrêt --- 
 
         // 1. Vérification de la limite z
         if (position.z() <= -15.0f) {
-            Ogre::LogManager::getSingleton().logMessage("BowlingBall::update - Limite Z atteinte (" +
+            SimulationLog::message("BowlingBall::update - Limite Z atteinte (" +
                 Ogre::StringConverter::toString(position.y()) + "). Arrêt de la boule.");
             ballBody->setLinearVelocity(btVector3(0, 0, 0));
             ballBody->setAngularVelocity(btVector3(0, 0, 0));
@@ -207,7 +242,7 @@ void BowlingBall::update(float deltaTime) {
             // Comparer avec le carré du seuil
             if (linearSpeedSq < (STOP_VELOCITY_THRESHOLD * STOP_VELOCITY_THRESHOLD) &&
                 angularSpeedSq < (STOP_VELOCITY_THRESHOLD * STOP_VELOCITY_THRESHOLD)) {
-                Ogre::LogManager::getSingleton().logMessage("BowlingBall::update - Faible vélocité détectée. Arrêt de la boule.");
+                SimulationLog::message("BowlingBall::update - Faible vélocité détectée. Arrêt de la boule.");
                 ballBody->setLinearVelocity(btVector3(0, 0, 0));
                 ballBody->setAngularVelocity(btVector3(0, 0, 0));
                 rolling = false;
@@ -217,7 +252,11 @@ void BowlingBall::update(float deltaTime) {
     }
 }
 
-void BowlingBall::updateSpin(float deltaTime) {
+void BowlingBall::onPhysicsTick(float timeStep) {
+    applySpin(timeStep);
+}
+
+void BowlingBall::applySpin(float timeStep) {
     if (ballBody && rolling) {
         // Récupérer la vélocité actuelle
         btVector3 currentVelocity = ballBody->getLinearVelocity();
@@ -234,18 +273,20 @@ void BowlingBall::updateSpin(float deltaTime) {
             // Calculer la direction actuelle
             btVector3 direction = currentVelocity.normalized();
             
-            // Force latérale basée sur le spin Y (effet Magnus simplifié)
-            float spinEffect = currentAngular.y() * 0.3f; // Facteur d'effet
+            // Force latérale basée sur le spin Y (effet Magnus simplifié), calibrée sur
+            // l'ancienne mise à jour par frame à 60 images/s
+            float spinEffect = currentAngular.y() * SPIN_SIDE_FORCE_FACTOR;
             
             // Vecteur perpendiculaire à la direction (pour la force latérale)
             btVector3 rightVector(-direction.z(), 0, direction.x());
             
-            // Appliquer une force latérale
-            btVector3 sideForce = rightVector * spinEffect * speed * deltaTime;
-            ballBody->applyCentralForce(sideForce);
+            // Impulsion de la force sur ce pas : applyCentralForce s'accumulerait sur tous
+            // les sous-pas d'un même stepSimulation (Bullet ne vide les forces qu'à la fin)
+            btVector3 sideForce = rightVector * spinEffect * speed * SPIN_REFERENCE_FRAME_TIME;
+            ballBody->applyCentralImpulse(sideForce * timeStep);
             
             // Réduire progressivement le spin (friction)
-            btVector3 dampedAngular = currentAngular * (1.0f - deltaTime * 0.005f);
+            btVector3 dampedAngular = currentAngular * (1.0f - timeStep * SPIN_DAMPING_RATE);
             ballBody->setAngularVelocity(dampedAngular);
         }
     }
@@ -257,10 +298,29 @@ float BowlingBall::getRadius() const {
     return radius; // Assurez-vous que `radius` est une variable membre de la classe
 }
 
+float BowlingBall::getCollisionRadius() const {
+    if (!ballBody) {
+        return radius;
+    }
+    const btCollisionShape* shape = ballBody->getCollisionShape();
+    // La sphère englobante générique part de l'AABB (rayon x racine de 3 pour une sphère)
+    if (shape->getShapeType() == SPHERE_SHAPE_PROXYTYPE) {
+        return static_cast<float>(static_cast<const btSphereShape*>(shape)->getRadius());
+    }
+    btVector3 center;
+    btScalar boundingRadius;
+    shape->getBoundingSphere(center, boundingRadius);
+    return static_cast<float>(boundingRadius);
+}
+
 Ogre::Vector3 BowlingBall::getPosition() const {
     if (ballNode) {
         return ballNode->getPosition();
     }
+    if (ballBody) {
+        const btVector3& position = ballBody->getWorldTransform().getOrigin();
+        return Ogre::Vector3(position.x(), position.y(), position.z());
+    }
     return Ogre::Vector3::ZERO;
 }
 
@@ -286,6 +346,37 @@ SpinInfo BowlingBall::getCurrentSpinInfo() const {
 
 // --- Setters --- 
 
+BallBodyProperties BowlingBall::getBodyProperties() const {
+    BallBodyProperties properties;
+    properties.collisionRadius = getCollisionRadius();
+    properties.mass = mass;
+    if (!ballBody) {
+        return properties;
+    }
+    const btVector3& inverseInertia = ballBody->getInvInertiaDiagLocal();
+    properties.mass = ballBody->getInvMass() > 0.0f ? 1.0f / ballBody->getInvMass() : 0.0f;
+    properties.localInertia = btVector3(
+        inverseInertia.x() > 0.0f ? 1.0f / inverseInertia.x() : 0.0f,
+        inverseInertia.y() > 0.0f ? 1.0f / inverseInertia.y() : 0.0f,
+        inverseInertia.z() > 0.0f ? 1.0f / inverseInertia.z() : 0.0f);
+    properties.friction = ballBody->getFriction();
+    properties.restitution = ballBody->getRestitution();
+    properties.rollingFriction = ballBody->getRollingFriction();
+    properties.spinningFriction = ballBody->getSpinningFriction();
+    properties.linearDamping = ballBody->getLinearDamping();
+    properties.angularDamping = ballBody->getAngularDamping();
+    return properties;
+}
+
+void BowlingBall::setBodyProperties(const BallBodyProperties& properties) {
+    bodyProperties = properties;
+    hasBodyProperties = true;
+}
+
+void BowlingBall::setCollisionShape(btCollisionShape* shape) {
+    headlessShape.reset(shape);
+}
+
 void BowlingBall::setMass(float mass) {
     mass = mass;
     if (ballBody) {
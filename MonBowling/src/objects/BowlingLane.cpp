@@ -1,16 +1,76 @@
 #include "../../include/objects/BowlingLane.h"
+#include <algorithm>
 
-BowlingLane::BowlingLane(Ogre::SceneManager* sceneMgr)
+// Emprise de polygon8.mesh une fois mis à l'échelle (x10), utilisée par la simulation sans rendu
+// quand la piste MESH est demandée (le mesh n'est pas chargé)
+static const float HEADLESS_LANE_MIN_X = -13.66f;
+static const float HEADLESS_LANE_MAX_X = 13.66f;
+static const float HEADLESS_LANE_MIN_Z = -13.3f;
+static const float HEADLESS_LANE_MAX_Z = 25.1f;
+static const float HEADLESS_LANE_THICKNESS = 0.5f;
+// Hauteur du sol (plane de 1500x1500 dans createGround)
+static const float GROUND_HEIGHT = -2.5f;
+// Mesh et échelle de la piste par défaut
+static const char* const DEFAULT_LANE_MESH = "polygon8.mesh";
+static const float LANE_SCALE = 10.0f;
+
+BowlingLane::BowlingLane(Ogre::SceneManager* sceneMgr, PhysicsManager* physics)
     : sceneMgr(sceneMgr),
+      physicsManager(physics ? physics : PhysicsManager::getInstance()),
       laneNode(nullptr),
-      laneEntity(nullptr){
+      laneEntity(nullptr),
+      laneBody(nullptr),
+      groundBody(nullptr),
+      laneMeshName(DEFAULT_LANE_MESH),
+      colliderType(sceneMgr ? LaneColliderType::MESH : LaneColliderType::ANALYTIC),
+      hasHeadlessGround(false),
+      headlessLaneHash(0),
+      oilPatternEnabled(false),
+      pinsInitialized(false){
+    rackBodies.fill(nullptr);
     // Initialisation des quilles avec une taille standard de 10
     pins.resize(10);
 }
 
-BowlingLane::~BowlingLane() {}
+BowlingLane::~BowlingLane() {
+    if (laneBody) {
+        physicsManager->removeRigidBody(laneBody);
+    }
+}
+
+void BowlingLane::createGround(bool planeCollider) {
+    // Sol enregistré d'une partie du jeu : même forme, même matériau, même filtre
+    if (!sceneMgr && hasHeadlessGround) {
+        btCollisionShape* shape = ShapeCache::createShape(headlessGround.shape);
+        if (!shape) {
+            Ogre::LogManager::getSingleton().logError("BowlingLane::createGround - description du sol invalide");
+            return;
+        }
+        groundBody = physicsManager->addPrimitiveRigidBody(0.0f, shape, headlessGround.transform);
+        if (groundBody) {
+            groundBody->setFriction(headlessGround.friction);
+            groundBody->setRestitution(headlessGround.restitution);
+            groundBody->setRollingFriction(headlessGround.rollingFriction);
+            groundBody->setSpinningFriction(headlessGround.spinningFriction);
+            // Premier corps du monde : aucune paire à revoir après le changement de filtre
+            groundBody->getBroadphaseHandle()->m_collisionFilterGroup = headlessGround.filterGroup;
+            groundBody->getBroadphaseHandle()->m_collisionFilterMask = headlessGround.filterMask;
+        }
+        return;
+    }
+
+    // Plan statique à la hauteur du sol : sans rendu, ou avec la piste analytique
+    // (au lieu de la boîte de 1500x1500 tirée du mesh du sol)
+    if (!sceneMgr || planeCollider) {
+        btTransform groundTransform;
+        groundTransform.setIdentity();
+        groundBody = physicsManager->addPrimitiveRigidBody(
+            0.0f, new btStaticPlaneShape(btVector3(0, 1, 0), GROUND_HEIGHT), groundTransform);
+    }
+    if (!sceneMgr) {
+        return;
+    }
 
-void createGround(Ogre::SceneManager* sceneMgr) {
     Ogre::Entity* mPlaneEnt;
     Ogre::SceneNode* mPlaneNode;
 
@@ -32,11 +92,12 @@ void createGround(Ogre::SceneManager* sceneMgr) {
     //creation du noeud
     mPlaneNode = sceneMgr->getRootSceneNode()->createChildSceneNode();
     mPlaneNode->attachObject(mPlaneEnt);
-    mPlaneNode->setPosition(0, -2.5, 0);
+    mPlaneNode->setPosition(0, GROUND_HEIGHT, 0);
 
     // mettre le plane dynamic
-    btRigidBody* groundBody = PhysicsManager::getInstance()->getDynamicsWorld()->addRigidBody(
-        0.0f, mPlaneEnt, Ogre::Bullet::CT_BOX);
+    if (!planeCollider) {
+        groundBody = physicsManager->getDynamicsWorld()->addRigidBody(0.0f, mPlaneEnt, Ogre::Bullet::CT_BOX);
+    }
 
     sceneMgr->setSkyBox(true, "Ciel", 5000);
 }
@@ -45,7 +106,7 @@ void BowlingLane::create(const Ogre::Vector3& ballStart) {
     // On sauvegarde la position de départ de la boule pour positionner correctement la piste
     ballStartPosition = ballStart;
     
-    createGround(sceneMgr);
+    createGround(colliderType == LaneColliderType::ANALYTIC);
 
     // Création de la piste
     createLane();
@@ -55,30 +116,182 @@ void BowlingLane::create(const Ogre::Vector3& ballStart) {
 }
 
 void BowlingLane::createLane() {
-    // Création du nœud pour la piste
-    laneNode = sceneMgr->getRootSceneNode()->createChildSceneNode("BowlingLaneNode");
-    
-    laneEntity = sceneMgr->createEntity("LaneEntity", "polygon8.mesh");
-    laneNode->attachObject(laneEntity);
-    //laneNode->yaw(Ogre::Radian(Ogre::Degree(90)));  // lane2.mesh
-    //laneNode->yaw(Ogre::Degree(180));   /// Garry (polygon8.mesh)
-    
-    // Positionnement de la piste
-    laneNode->setPosition(0.0f, 0.0f, 0.0f); 
-    laneNode->setScale(10.0f, 10.0f, 10.0f);
+    if (sceneMgr) {
+        // Création du nœud pour la piste
+        if (!laneNode) {
+            laneNode = sceneMgr->getRootSceneNode()->createChildSceneNode("BowlingLaneNode");
+        }
+        
+        laneEntity = sceneMgr->createEntity("LaneEntity", laneMeshName);
+        laneNode->attachObject(laneEntity);
+        //laneNode->yaw(Ogre::Radian(Ogre::Degree(90)));  // lane2.mesh
+        //laneNode->yaw(Ogre::Degree(180));   /// Garry (polygon8.mesh)
+        
+        // Positionnement de la piste
+        laneNode->setPosition(0.0f, 0.0f, 0.0f); 
+        laneNode->setScale(LANE_SCALE, LANE_SCALE, LANE_SCALE);
+    }
+
+    btTransform laneTransform;
+    laneTransform.setIdentity();
+
+    if (colliderType == LaneColliderType::ANALYTIC) {
+        // Boîtes statiques aux dimensions réglementaires : le mesh ne sert qu'à l'affichage
+        laneBody = physicsManager->addPrimitiveRigidBody(
+            0.0f, buildAnalyticLaneShape(laneDefinition), laneTransform);
+        PhysicsManager::setBodyRole(laneBody, BodyRole::LANE);
+        laneBody->setFriction(laneDefinition.friction);
+        laneBody->setRollingFriction(laneDefinition.rollingFriction);
+        applyOilPattern();
+        return;
+    }
+
+    // Simulation sans rendu : boîte statique couvrant l'emprise de la piste, dessus à y = 0
+    if (!sceneMgr && headlessLaneHash == 0) {
+        btVector3 halfExtents((HEADLESS_LANE_MAX_X - HEADLESS_LANE_MIN_X) * 0.5f,
+                              HEADLESS_LANE_THICKNESS * 0.5f,
+                              (HEADLESS_LANE_MAX_Z - HEADLESS_LANE_MIN_Z) * 0.5f);
+        laneTransform.setOrigin(btVector3((HEADLESS_LANE_MAX_X + HEADLESS_LANE_MIN_X) * 0.5f,
+                                          -HEADLESS_LANE_THICKNESS * 0.5f,
+                                          (HEADLESS_LANE_MAX_Z + HEADLESS_LANE_MIN_Z) * 0.5f));
+        laneBody = physicsManager->addPrimitiveRigidBody(
+            0.0f, new btBoxShape(halfExtents), laneTransform);
+        PhysicsManager::setBodyRole(laneBody, BodyRole::LANE);
+        laneBody->setFriction(0.8f);
+        laneBody->setRollingFriction(0.1f);
+        applyOilPattern();
+        return;
+    }
     
-    // Ajout de la piste au monde physique comme objet statique
-    btRigidBody* laneBody = PhysicsManager::getInstance()->getDynamicsWorld()->addRigidBody(
-        0.0f, laneEntity, Ogre::Bullet::CT_TRIMESH);
+    // Ajout de la piste au monde physique comme objet statique. La BVH du maillage
+    // (mis à l'échelle) est relue du cache disque quand le mesh n'a pas changé ; sans
+    // rendu, les triangles viennent aussi du fichier (rejeu d'une partie du jeu).
+    btBvhTriangleMeshShape* shape = sceneMgr
+        ? physicsManager->getBvhCache().getTriangleMeshShape(laneEntity->getMesh(), laneNode->getScale())
+        : physicsManager->getBvhCache().loadTriangleMeshShape(laneMeshName, headlessLaneHash);
+    if (!shape) {
+        Ogre::LogManager::getSingleton().logError("BowlingLane::createLane - forme de collision indisponible pour " + laneMeshName);
+        return;
+    }
+    laneBody = physicsManager->addSharedShapeRigidBody(0.0f, shape, laneTransform, laneNode);
+    PhysicsManager::setBodyRole(laneBody, BodyRole::LANE);
     
     //if (laneBody) { laneBody->setFriction(0.3f); }
     laneBody->setFriction(0.8f);        // Friction élevée pour que le spin fonctionne
     laneBody->setRollingFriction(0.1f);  // Friction de roulement modérée
+    applyOilPattern();
 
-    Ogre::LogManager::getSingleton().logMessage("Piste à : " + Ogre::StringConverter::toString(laneNode->getPosition()));
+    if (laneNode) {
+        Ogre::LogManager::getSingleton().logMessage("Piste à : " + Ogre::StringConverter::toString(laneNode->getPosition()));
+    }
 }
 
-void BowlingLane::setupPins() {
+void BowlingLane::destroyLane() {
+    if (laneBody) {
+        physicsManager->removeRigidBody(laneBody);
+        laneBody = nullptr;
+    }
+    if (laneEntity) {
+        laneNode->detachObject(laneEntity);
+        sceneMgr->destroyEntity(laneEntity);
+        laneEntity = nullptr;
+    }
+}
+
+void BowlingLane::setLaneMesh(const Ogre::String& meshName) {
+    if (meshName == laneMeshName) {
+        return;
+    }
+    laneMeshName = meshName;
+
+    // Piste déjà créée : remplacement à chaud (la simulation sans rendu garde sa boîte)
+    if (laneNode) {
+        destroyLane();
+        createLane();
+    }
+}
+
+void BowlingLane::setHeadlessGround(const GroundDescription& ground) {
+    headlessGround = ground;
+    hasHeadlessGround = true;
+}
+
+void BowlingLane::setHeadlessLaneMesh(const Ogre::String& meshName, uint64_t hash) {
+    laneMeshName = meshName;
+    headlessLaneHash = hash;
+}
+
+void BowlingLane::setColliderType(LaneColliderType type) {
+    if (type == colliderType) {
+        return;
+    }
+    colliderType = type;
+
+    // Le sol (boîte ou plan) est choisi à la création : seule la piste est remplacée ici
+    if (laneBody) {
+        destroyLane();
+        createLane();
+    }
+}
+
+bool BowlingLane::loadOilPattern(const std::string& path) {
+    if (!oilPattern.load(path)) {
+        return false;
+    }
+    oilPatternEnabled = true;
+    applyOilPattern();
+    return true;
+}
+
+void BowlingLane::setOilPattern(const LaneFrictionField& pattern) {
+    oilPattern = pattern;
+    oilPatternEnabled = true;
+    applyOilPattern();
+}
+
+void BowlingLane::clearOilPattern() {
+    oilPatternEnabled = false;
+    applyOilPattern();
+}
+
+void BowlingLane::applyOilPattern() {
+    if (!laneBody) {
+        return;
+    }
+    // Le motif suit la géométrie de la piste : celle de LaneDefinition pour la piste
+    // analytique, le plateau réel du maillage pour la piste MESH (mesuré à mi-chemin entre
+    // la ligne de faute et la quille de tête). La ligne de faute reste celle du jeu, liée
+    // à la position de départ de la boule.
+    float centerX = laneDefinition.centerX;
+    float width = laneDefinition.width;
+    const btCollisionShape* shape = laneBody->getCollisionShape();
+    if (shape->getShapeType() == TRIANGLE_MESH_SHAPE_PROXYTYPE) {
+        float probeZ = 0.5f * (laneDefinition.getFoulLineZ() + computePinPositions(ballStartPosition)[9].z);
+        float minX, maxX;
+        if (physicsManager->getBvhCache().findDeckExtent(
+                static_cast<const btBvhTriangleMeshShape*>(shape), probeZ, minX, maxX)) {
+            centerX = 0.5f * (minX + maxX);
+            width = maxX - minX;
+        }
+        else if (oilPatternEnabled) {
+            Ogre::LogManager::getSingleton().logWarning("BowlingLane::applyOilPattern - plateau introuvable dans " +
+                laneMeshName + ", motif placé selon LaneDefinition");
+        }
+    }
+    oilPattern.setLaneGeometry(centerX, width, laneDefinition.getFoulLineZ());
+    PhysicsManager::setLaneFrictionField(laneBody, oilPatternEnabled ? &oilPattern : nullptr);
+}
+
+void BowlingLane::setLaneDefinition(const LaneDefinition& definition) {
+    laneDefinition = definition;
+
+    if (laneBody && colliderType == LaneColliderType::ANALYTIC) {
+        destroyLane();
+        createLane();
+    }
+}
+
+std::array<Ogre::Vector3, 10> BowlingLane::computePinPositions(const Ogre::Vector3& ballStartPosition) {
     float pinZOffset = 10.0f;
     float pinXOffset = 0.0f;
     Ogre::Vector3 pinBasePosition = Ogre::Vector3(
@@ -91,7 +304,7 @@ void BowlingLane::setupPins() {
     float spacing = 0.05f;
     
     // Position des quilles en formation triangulaire normale
-    Ogre::Vector3 pinPositions[10];
+    std::array<Ogre::Vector3, 10> pinPositions;
     
     // Rangée 1 (la plus proche de la boule, une seule quille)
     pinPositions[9] = pinBasePosition;
@@ -111,12 +324,22 @@ void BowlingLane::setupPins() {
     pinPositions[2] = pinBasePosition - Ogre::Vector3(spacing, 0, 3*spacing);
     pinPositions[3] = pinBasePosition - Ogre::Vector3(3*spacing, 0, 3*spacing);
     
+    return pinPositions;
+}
+
+void BowlingLane::setupPins() {
+    std::array<Ogre::Vector3, 10> pinPositions = computePinPositions(ballStartPosition);
+
     // Création des quilles
     for (int i = 0; i < 10; ++i) {
-        pins[i] = std::make_unique<BowlingPin>(sceneMgr);
+        pins[i] = std::make_unique<BowlingPin>(sceneMgr, physicsManager);
         pins[i]->create(pinPositions[i], i+1);
         Ogre::LogManager::getSingleton().logMessage("Quille " + Ogre::StringConverter::toString(i+1) +
                                                      " à : " + Ogre::StringConverter::toString(pinPositions[i]));
+
+        rackBodies[i] = pins[i]->getPinBody();
+        rackLayout[i].setIdentity();
+        rackLayout[i].setOrigin(btVector3(pinPositions[i].x, pinPositions[i].y, pinPositions[i].z));
     }
     
     pinsInitialized = true;
@@ -126,36 +349,56 @@ const std::vector<std::unique_ptr<BowlingPin>>& BowlingLane::getPins() const {
     return pins;
 }
 
-void BowlingLane::update(float deltaTime) {
-    if (pinsInitialized) {
+void BowlingLane::resetPins() {
+    if (!pinsInitialized) {
+        return;
+    }
+    // Une quille sans corps (forme indisponible) n'est pas relevée
+    if (std::find(rackBodies.begin(), rackBodies.end(), nullptr) != rackBodies.end()) {
         for (auto& pin : pins) {
             if (pin) {
-                pin->update(deltaTime);
+                pin->reset();
             }
         }
+        return;
     }
-}
 
-void BowlingLane::resetPins() {
-    if (pinsInitialized) {
-        for (auto& pin : pins) {
-            if (pin) {
-                pin->reset();
-            }
+    physicsManager->teleportBodies(rackBodies.data(), rackLayout.data(), rackBodies.size());
+
+    // Affichage : les nœuds suivent la transformation interpolée à la prochaine frame,
+    // mais sont replacés tout de suite pour ne pas montrer l'ancien jeu d'ici là
+    for (size_t i = 0; i < pins.size(); ++i) {
+        Ogre::SceneNode* node = pins[i]->getPinNode();
+        if (node) {
+            const btVector3& origin = rackLayout[i].getOrigin();
+            node->setPosition(origin.x(), origin.y(), origin.z());
+            node->setOrientation(Ogre::Quaternion::IDENTITY);
         }
     }
 }
 
 int BowlingLane::countKnockedDownPins() const {
     int knockedDownCount = 0;
+    int mask = getKnockedDownMask();
+    for (size_t i = 0; i < rackBodies.size(); ++i) {
+        knockedDownCount += (mask >> i) & 1;
+    }
+    return knockedDownCount;
+}
+
+int BowlingLane::getKnockedDownMask() const {
+    int mask = 0;
     
+    // Quilles au repos (fin du lancer) : classement sans historique, par rapport aux emplacements
     if (pinsInitialized) {
-        for (const auto& pin : pins) {
-            if (pin && pin->isKnockedDown()) {
-                knockedDownCount++;
+        for (size_t i = 0; i < rackBodies.size(); ++i) {
+            if (rackBodies[i] &&
+                PinFallClassifier::isKnockedDown(PinFallClassifier::classify(rackBodies[i]->getWorldTransform(),
+                                                                             rackLayout[i].getOrigin()))) {
+                mask |= (1 << i);
             }
         }
     }
     
-    return knockedDownCount;
+    return mask;
 }
\ No newline at end of file
@@ -1,7 +1,23 @@
 #include "../../include/objects/BowlingPin.h"
+#include "../../include/utils/PinFallClassifier.h"
 
-BowlingPin::BowlingPin(Ogre::SceneManager* sceneMgr)
+// Masse d'une quille (kg)
+static const float PIN_MASS = 1.5f;
+
+// Vitesses sous lesquelles Bullet peut endormir une quille (m/s, rad/s)
+static const float PIN_SLEEP_LINEAR_THRESHOLD = 0.05f;
+static const float PIN_SLEEP_ANGULAR_THRESHOLD = 0.1f;
+
+// Approximation cylindrique de pin.mesh pour la simulation sans rendu
+// (boîte englobante du mesh : largeur ~0.21, hauteur 0.04 -> 0.72 au-dessus de l'origine)
+static const float HEADLESS_PIN_RADIUS = 0.106f;
+static const float HEADLESS_PIN_HALF_HEIGHT = 0.34f;
+static const float HEADLESS_PIN_CENTER_Y = 0.378f;
+static const char* const HEADLESS_PIN_SHAPE_KEY = "HeadlessPin";
+
+BowlingPin::BowlingPin(Ogre::SceneManager* sceneMgr, PhysicsManager* physics)
     : sceneMgr(sceneMgr), 
+      physicsManager(physics ? physics : PhysicsManager::getInstance()), 
       pinNode(nullptr), 
       pinEntity(nullptr), 
       pinBody(nullptr), 
@@ -9,13 +25,38 @@ BowlingPin::BowlingPin(Ogre::SceneManager* sceneMgr)
 
 BowlingPin::~BowlingPin() {
     if (pinBody) {
-        PhysicsManager::getInstance()->getDynamicsWorld()->getBtWorld()->removeRigidBody(pinBody);
+        physicsManager->removeRigidBody(pinBody);
     }
 }
 
 void BowlingPin::create(const Ogre::Vector3& position, int pinIndex) {
     // Sauvegarde de la position initiale
     initialPosition = position;
+
+    btTransform startTransform;
+    startTransform.setIdentity();
+    startTransform.setOrigin(btVector3(position.x, position.y, position.z));
+    ShapeCache& shapeCache = physicsManager->getShapeCache();
+
+    // Simulation sans rendu : cylindre décalé à la hauteur du mesh, sans nœud ni entité
+    if (!sceneMgr) {
+        btCollisionShape* shape = shapeCache.findShape(HEADLESS_PIN_SHAPE_KEY);
+        if (!shape) {
+            btCompoundShape* compound = new btCompoundShape();
+            btTransform childTransform;
+            childTransform.setIdentity();
+            childTransform.setOrigin(btVector3(0.0f, HEADLESS_PIN_CENTER_Y, 0.0f));
+            compound->addChildShape(childTransform, new btCylinderShape(
+                btVector3(HEADLESS_PIN_RADIUS, HEADLESS_PIN_HALF_HEIGHT, HEADLESS_PIN_RADIUS)));
+            shape = shapeCache.addShape(HEADLESS_PIN_SHAPE_KEY, compound);
+        }
+
+        pinBody = physicsManager->addSharedShapeRigidBody(PIN_MASS, shape, startTransform);
+        if (pinBody) {
+            configureBody();
+        }
+        return;
+    }
     
     std::string nodeName = "BowlingPinNode_" + std::to_string(pinIndex);
     std::string entityName = "BowlingPinEntity_" + std::to_string(pinIndex);
@@ -28,68 +69,78 @@ void BowlingPin::create(const Ogre::Vector3& position, int pinIndex) {
     float scale = 0.1f;  
     //pinNode->setScale(scale, scale, scale);
     
-    pinBody = PhysicsManager::getInstance()->getDynamicsWorld()->addRigidBody(
-        1.5f, pinEntity, Ogre::Bullet::CT_HULL);  
+    // Une seule forme pour toutes les quilles du même mesh (niveau de détail du ShapeCache)
+    btCollisionShape* shape = shapeCache.getMeshShape(pinEntity->getMesh(), pinNode->getScale());
+    if (shape) {
+        pinBody = physicsManager->addSharedShapeRigidBody(PIN_MASS, shape, startTransform, pinNode);
+    }
     
-    // Propriétés physiques essentielles
     if (pinBody) {
-        btVector3 inertia;
-        btCollisionShape* shape = pinBody->getCollisionShape();
-        shape->calculateLocalInertia(1.5f, inertia);
-        pinBody->setMassProps(1.5f, inertia);  // Masse réaliste
-        
-        pinBody->setFriction(0.6f);             // Friction pour ne pas glisser
-        pinBody->setRollingFriction(0.1f);      // Friction de roulement
-        pinBody->setSpinningFriction(0.1f);     // Friction de rotation
-        pinBody->setRestitution(0.3f);          // Rebond modéré
-        pinBody->setActivationState(ACTIVE_TAG); // Activation physique
-        
-        // Désactiver la désactivation automatique pour éviter que les quilles ne "s'endorment"
-        pinBody->setDeactivationTime(30.0f);     // Temps plus long avant désactivation
+        configureBody();
     }
 }
 
+void BowlingPin::configureBody() {
+    PhysicsManager::setBodyRole(pinBody, BodyRole::PIN);
+
+    // Propriétés physiques essentielles
+    btVector3 inertia;
+    btCollisionShape* shape = pinBody->getCollisionShape();
+    shape->calculateLocalInertia(PIN_MASS, inertia);
+    pinBody->setMassProps(PIN_MASS, inertia);  // Masse réaliste
+    
+    pinBody->setFriction(0.6f);             // Friction pour ne pas glisser
+    pinBody->setRollingFriction(0.1f);      // Friction de roulement
+    pinBody->setSpinningFriction(0.1f);     // Friction de rotation
+    pinBody->setRestitution(0.3f);          // Rebond modéré
+    pinBody->setActivationState(ACTIVE_TAG); // Activation physique
+    
+    // Sommeil Bullet : seulement une quille vraiment immobile (seuils par défaut 0.8 m/s et
+    // 1 rad/s, qui figeaient une quille qui bascule lentement). setDeactivationTime ne
+    // retardait pas le sommeil : il préchargeait le compteur de Bullet au-delà du délai.
+    pinBody->setSleepingThresholds(PIN_SLEEP_LINEAR_THRESHOLD, PIN_SLEEP_ANGULAR_THRESHOLD);
+
+    // Interpolation entre deux pas fixes (déjà enregistrée quand la quille a un nœud)
+    physicsManager->registerInterpolatedBody(pinBody);
+}
+
 void BowlingPin::reset() {
-    if (pinNode && pinBody) {
+    if (pinBody) {
         // Réinitialiser à la position d'origine sauvegardée
-        pinNode->setPosition(initialPosition);
+        if (pinNode) {
+            pinNode->setPosition(initialPosition);
+            pinNode->setOrientation(Ogre::Quaternion::IDENTITY);
+        }
         
         // Réinitialiser la vitesse et la rotation
         pinBody->setLinearVelocity(btVector3(0.0f, 0.0f, 0.0f));
         pinBody->setAngularVelocity(btVector3(0.0f, 0.0f, 0.0f));
-        
-        // Réinitialiser la rotation du nœud
-        pinNode->setOrientation(Ogre::Quaternion::IDENTITY);
+
+        // Replacer le corps lui-même : sans cela l'état de mouvement
+        // ramène le nœud à l'endroit où la quille est tombée
+        btTransform initialTransform;
+        initialTransform.setIdentity();
+        initialTransform.setOrigin(btVector3(initialPosition.x, initialPosition.y, initialPosition.z));
+        pinBody->setWorldTransform(initialTransform);
+        if (pinBody->getMotionState()) {
+            pinBody->getMotionState()->setWorldTransform(initialTransform);
+        }
         
         // S'assurer que le corps physique est réactivé
         pinBody->activate(true);
-    }
-}
 
-void BowlingPin::update(float deltaTime) {
-    if (pinBody && pinNode) {
-        // Mise à jour de la position du nœud Ogre à partir de la position du corps rigide Bullet
-        btTransform transform;
-        pinBody->getMotionState()->getWorldTransform(transform);
-        
-        btVector3 position = transform.getOrigin();
-        pinNode->setPosition(position.x(), position.y(), position.z());
-        
-        // Mise à jour de la rotation du nœud Ogre à partir de la rotation du corps rigide Bullet
-        btQuaternion rotation = transform.getRotation();
-        pinNode->setOrientation(rotation.w(), rotation.x(), rotation.y(), rotation.z());
+        // Pas d'interpolation depuis l'ancienne position
+        physicsManager->resetInterpolation(pinBody);
     }
 }
 
 bool BowlingPin::isKnockedDown() const {
-    if (pinNode) {
-        // Une quille est considérée comme renversée si elle est inclinée de plus de 45 degrés
-        Ogre::Vector3 upVector = pinNode->getOrientation() * Ogre::Vector3::UNIT_Y;
-        float dotProduct = upVector.dotProduct(Ogre::Vector3::UNIT_Y);
-        //Ogre::LogManager::getSingleton().logMessage("Pin " + pinNode->getName() + " dotProduct: " + Ogre::StringConverter::toString(dotProduct));
-        return dotProduct < 0.7071f;  // cos(45°) ≈ 0.7071
+    if (!pinBody) {
+        return false;
     }
-    return false;
+    // Même classement que PinDetector : couchée à plus de 45°, ou sortie du plateau
+    btVector3 spot(initialPosition.x, initialPosition.y, initialPosition.z);
+    return PinFallClassifier::isKnockedDown(PinFallClassifier::classify(pinBody->getWorldTransform(), spot));
 }
 
 btRigidBody* BowlingPin::getPinBody() const {
@@ -98,4 +149,8 @@ btRigidBody* BowlingPin::getPinBody() const {
 
 Ogre::SceneNode* BowlingPin::getPinNode() const {
     return pinNode;
+}
+
+void BowlingPin::setHeadlessShape(PhysicsManager& physics, btCollisionShape* shape) {
+    physics.getShapeCache().addShape(HEADLESS_PIN_SHAPE_KEY, shape);
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "../../include/objects/LaneCollider.h"
+#include "../../include/managers/ImpactEvent.h"
+#include <algorithm>
+
+// Ajoute une boîte définie par ses coins opposés, marquée avec la partie de piste
+// qu'elle représente (classification des chocs, voir PhysicsManager::publishImpacts)
+static void addBox(btCompoundShape* compound, LanePart part, const btVector3& minCorner, const btVector3& maxCorner) {
+    btVector3 halfExtents = (maxCorner - minCorner) * 0.5f;
+    btTransform transform;
+    transform.setIdentity();
+    transform.setOrigin((minCorner + maxCorner) * 0.5f);
+    btBoxShape* box = new btBoxShape(halfExtents);
+    box->setUserIndex(static_cast<int>(part));
+    compound->addChildShape(transform, box);
+}
+
+btCompoundShape* buildAnalyticLaneShape(const LaneDefinition& lane) {
+    btCompoundShape* compound = new btCompoundShape();
+
+    const float x = lane.centerX;
+    const float halfWidth = 0.5f * lane.width;
+    const float outer = lane.getOuterHalfWidth();
+    const float foulZ = lane.getFoulLineZ();
+    const float pitEndZ = lane.deckEndZ - lane.pitLength;
+    const float kickbackStartZ = lane.deckEndZ + lane.pinDeckLength;
+    const float thickness = lane.deckThickness;
+    const float wall = lane.wallThickness;
+
+    // Plateau : ligne de faute -> fosse
+    addBox(compound, LanePart::DECK, btVector3(x - halfWidth, -thickness, lane.deckEndZ),
+                                     btVector3(x + halfWidth, 0.0f, foulZ));
+
+    // Élan : pleine largeur derrière la ligne de faute (la boule y est posée)
+    addBox(compound, LanePart::DECK, btVector3(x - outer, -thickness, foulZ),
+                                     btVector3(x + outer, 0.0f, foulZ + lane.approachLength));
+
+    // Gouttières : fond plat, gutterDepth sous le plateau
+    const float gutterTop = -lane.gutterDepth;
+    addBox(compound, LanePart::GUTTER, btVector3(x - outer, gutterTop - thickness, lane.deckEndZ),
+                                       btVector3(x - halfWidth, gutterTop, foulZ));
+    addBox(compound, LanePart::GUTTER, btVector3(x + halfWidth, gutterTop - thickness, lane.deckEndZ),
+                                       btVector3(x + outer, gutterTop, foulZ));
+
+    // Rebords extérieurs des gouttières, puis kickbacks à hauteur des quilles et de la fosse
+    for (float side : {-1.0f, 1.0f}) {
+        float inner = x + side * outer;
+        float outerEdge = inner + side * wall;
+        float minX = std::min(inner, outerEdge);
+        float maxX = std::max(inner, outerEdge);
+        addBox(compound, LanePart::WALL, btVector3(minX, gutterTop, kickbackStartZ),
+                                         btVector3(maxX, lane.cappingHeight, foulZ));
+        addBox(compound, LanePart::WALL, btVector3(minX, -lane.pitDepth, pitEndZ),
+                                         btVector3(maxX, lane.kickbackHeight, kickbackStartZ));
+    }
+
+    // Fosse : fond et coussin du fond
+    addBox(compound, LanePart::PIT, btVector3(x - outer, -lane.pitDepth - thickness, pitEndZ),
+                                    btVector3(x + outer, -lane.pitDepth, lane.deckEndZ));
+    addBox(compound, LanePart::WALL, btVector3(x - outer - wall, -lane.pitDepth, pitEndZ - wall),
+                                     btVector3(x + outer + wall, lane.kickbackHeight, pitEndZ));
+
+    return compound;
+}
@@ -1,6 +1,17 @@
 #include "../../include/objects/ObjectFactory.h"
 
+btRigidBody* ObjectFactory::createPrimitiveBody(btCollisionShape* shape, const Ogre::Vector3& position, float mass){
+    btTransform transform;
+    transform.setIdentity();
+    transform.setOrigin(btVector3(position.x, position.y, position.z));
+    return mPhysics->addPrimitiveRigidBody(mass, shape, transform);
+}
+
 btRigidBody* ObjectFactory::createStaticGround(){
+    if (!mSceneMgr){
+        return createPrimitiveBody(new btStaticPlaneShape(btVector3(0, 1, 0), 0), Ogre::Vector3::ZERO, 0.0f);
+    }
+
     // Création du plan dans Ogre
     Ogre::Plane plane(Ogre::Vector3::UNIT_Y, 0);
     Ogre::MeshManager::getSingleton().createPlane(
@@ -25,10 +36,14 @@ btRigidBody* ObjectFactory::createStaticGround(){
     groundNode->attachObject(groundEntity);
     
     // Ajout du sol au monde physique (masse 0 = objet statique)
-    return PhysicsManager::getInstance()->getDynamicsWorld()->addRigidBody(0.0f, groundEntity, Ogre::Bullet::CT_BOX);
+    return mPhysics->getDynamicsWorld()->addRigidBody(0.0f, groundEntity, Ogre::Bullet::CT_BOX);
 }
 
 btRigidBody* ObjectFactory::createDynamicBox(const Ogre::Vector3& position, const Ogre::String& name, float mass){
+    if (!mSceneMgr){
+        return createPrimitiveBody(new btBoxShape(btVector3(0.5f, 0.5f, 0.5f)), position, mass);
+    }
+
     // Création de l'entité et du nœud dans Ogre
     Ogre::Entity* boxEntity = mSceneMgr->createEntity(name, "cube.mesh");
     Ogre::SceneNode* boxNode = mSceneMgr->getRootSceneNode()->createChildSceneNode(name + "Node");
@@ -36,10 +51,14 @@ btRigidBody* ObjectFactory::createDynamicBox(const Ogre::Vector3& position, cons
     boxNode->setPosition(position);
     
     // Ajout du cube au monde physique avec une masse > 0 (objet dynamique)
-    return PhysicsManager::getInstance()->getDynamicsWorld()->addRigidBody(mass, boxEntity, Ogre::Bullet::CT_BOX);
+    return mPhysics->getDynamicsWorld()->addRigidBody(mass, boxEntity, Ogre::Bullet::CT_BOX);
 }
 
 btRigidBody* ObjectFactory::createDynamicSphere(const Ogre::Vector3& position, const Ogre::String& name, float mass){
+    if (!mSceneMgr){
+        return createPrimitiveBody(new btSphereShape(0.5f), position, mass);
+    }
+
     // Création de l'entité et du nœud dans Ogre
     Ogre::Entity* sphereEntity = mSceneMgr->createEntity(name, "sphere.mesh");
     Ogre::SceneNode* sphereNode = mSceneMgr->getRootSceneNode()->createChildSceneNode(name + "Node");
@@ -47,10 +66,14 @@ btRigidBody* ObjectFactory::createDynamicSphere(const Ogre::Vector3& position, c
     sphereNode->setPosition(position);
     
     // Ajout de la sphère au monde physique
-    return PhysicsManager::getInstance()->getDynamicsWorld()->addRigidBody(mass, sphereEntity, Ogre::Bullet::CT_SPHERE);
+    return mPhysics->getDynamicsWorld()->addRigidBody(mass, sphereEntity, Ogre::Bullet::CT_SPHERE);
 }
 
 btRigidBody* ObjectFactory::createDynamicCylinder(const Ogre::Vector3& position, const Ogre::String& name, float mass){
+    if (!mSceneMgr){
+        return createPrimitiveBody(new btCylinderShape(btVector3(0.5f, 0.5f, 0.5f)), position, mass);
+    }
+
     // Création de l'entité et du nœud dans Ogre
     Ogre::Entity* cylinderEntity = mSceneMgr->createEntity(name, "spine.mesh");
     Ogre::SceneNode* cylinderNode = mSceneMgr->getRootSceneNode()->createChildSceneNode(name + "Node");
@@ -58,16 +81,17 @@ btRigidBody* ObjectFactory::createDynamicCylinder(const Ogre::Vector3& position,
     cylinderNode->setPosition(position);
     
     // Ajout du cylindre au monde physique
-    return PhysicsManager::getInstance()->getDynamicsWorld()->addRigidBody(mass, cylinderEntity, Ogre::Bullet::CT_CYLINDER);
+    return mPhysics->getDynamicsWorld()->addRigidBody(mass, cylinderEntity, Ogre::Bullet::CT_CYLINDER);
 }
 
 void ObjectFactory::createStack(int height, const Ogre::Vector3& position){
     float boxSize = 1.0f;
     float spacing = boxSize * 1.1f;
+    Ogre::String prefix = "Stack" + Ogre::StringConverter::toString(mStackCount++) + "Box";
     
     for (int i = 0; i < height; i++)
     {
-        Ogre::String name = "StackBox" + Ogre::StringConverter::toString(i);
+        Ogre::String name = prefix + Ogre::StringConverter::toString(i);
         Ogre::Vector3 pos = position + Ogre::Vector3(0, boxSize/2 + i * spacing, 0);
         createDynamicBox(pos, name, 1.0f);
     }
@@ -3,6 +3,7 @@
 #include <vector>
 #include <numeric>
 #include <OgreLogManager.h>
+#include "../../include/utils/SimulationLog.h"
 
 ScoreManager* ScoreManager::mInstance = nullptr;
 
@@ -62,14 +63,91 @@ void ScoreManager::initialize() {
     resetScore();
 }
 
-void ScoreManager::recordRoll(int pins) {
-    if (mCurrentRoll < MAX_ROLLS) {
-        mRolls[mCurrentRoll++] = pins;
-        Ogre::LogManager::getSingleton().logMessage("ScoreManager: Roll " + Ogre::StringConverter::toString(mCurrentRoll) + " recorded: " + Ogre::StringConverter::toString(pins) + " pins.");
-        calculateScore(); 
-        updateScoreDisplay();
+void ScoreManager::recordRoll(int pins, int knockedDownMask) {
+    if (mCurrentRoll >= MAX_ROLLS || mFrame >= FRAME_COUNT) {
+        SimulationLog::message("ScoreManager: Maximum rolls reached.");
+        return;
+    }
+    mRolls[mCurrentRoll++] = pins;
+
+    // Bonus des strikes et spares précédents, réglés dès qu'ils sont complets
+    int kept = 0;
+    for (int i = 0; i < mPendingCount; ++i) {
+        PendingBonus bonus = mPending[i];
+        bonus.score += pins;
+        if (--bonus.rollsLeft == 0) {
+            settleFrame(bonus.frame, bonus.score);
+        } else {
+            mPending[kept++] = bonus;
+        }
+    }
+    mPendingCount = kept;
+
+    // Premier lancer sur un jeu complet : 0 puis 10 est un spare, pas un strike
+    bool freshRack = mRackBalls == 0;
+    mRackPins += pins;
+    ++mRackBalls;
+    bool rackCleared = mRackPins >= 10;
+    setRollMark(pins, rackCleared, freshRack, knockedDownMask);
+    mFramePins += pins;
+
+    if (mFrame < FRAME_COUNT - 1) {
+        if (rackCleared) {
+            // Strike : deux lancers bonus ; spare : un
+            addPendingBonus(mFrame, mRollInFrame == 0 ? 2 : 1);
+        } else if (mRollInFrame == 1) {
+            settleFrame(mFrame, mFramePins);
+        } else {
+            ++mRollInFrame;
+            updateScoreDisplay();
+            return;
+        }
+        ++mFrame;
+        mRollInFrame = 0;
+        mFramePins = 0;
+        mRackPins = 0;
+        mRackBalls = 0;
+    } else {
+        // 10e frame : ses lancers bonus font partie de la frame, qui se règle à la fin
+        bool bonusEarned = mRollInFrame == 0 ? rackCleared : mFramePins >= 10;
+        if (mRollInFrame == 2 || (mRollInFrame == 1 && !bonusEarned)) {
+            settleFrame(mFrame, mFramePins);
+            ++mFrame;
+        } else {
+            ++mRollInFrame;
+            if (rackCleared) {
+                mRackPins = 0;
+                mRackBalls = 0;
+            }
+        }
+    }
+    updateScoreDisplay();
+}
+
+void ScoreManager::settleFrame(int frame, int score) {
+    mFrameScores[frame] = score;
+    mTotalScore += score;
+}
+
+void ScoreManager::addPendingBonus(int frame, int rollsLeft) {
+    mPending[mPendingCount++] = {frame, 10, rollsLeft};
+}
+
+void ScoreManager::setRollMark(int pins, bool rackCleared, bool freshRack, int knockedDownMask) {
+    char mark;
+    if (rackCleared) {
+        mark = freshRack ? 'X' : '/';
+    } else if (pins == 0) {
+        mark = '-';
     } else {
-        Ogre::LogManager::getSingleton().logMessage("ScoreManager: Maximum rolls reached.");
+        mark = static_cast<char>('0' + pins);
+    }
+    mFrameMarks[mFrame][mRollInFrame] = mark;
+    mFrameMarks[mFrame][mRollInFrame + 1] = '\0';
+
+    // Split : seulement sur la première boule d'un jeu de quilles
+    if (freshRack && !rackCleared && knockedDownMask >= 0 && isSplit(knockedDownMask)) {
+        mSplitMasks[mFrame] |= 1 << mRollInFrame;
     }
 }
 
@@ -78,86 +156,66 @@ void ScoreManager::resetScore() {
     mFrameScores.fill(0);
     mCurrentRoll = 0;
     mTotalScore = 0;
+    mPendingCount = 0;
+    mFrame = 0;
+    mRollInFrame = 0;
+    mFramePins = 0;
+    mRackPins = 0;
+    mRackBalls = 0;
+    for (auto& marks : mFrameMarks) {
+        marks.fill('\0');
+    }
+    mSplitMasks.fill(0);
+    mDisplayedScore = -1;
     if (mScoreText) { 
         updateScoreDisplay();
     }
-    Ogre::LogManager::getSingleton().logMessage("ScoreManager: Score reset.");
+    SimulationLog::message("ScoreManager: Score reset.");
 }
 
-void ScoreManager::calculateScore() {
-    mTotalScore = 0;
-    mFrameScores.fill(0);
-    int rollIndex = 0;
-    
-    for (int frame = 0; frame < 10; ++frame) {
-        if (rollIndex >= mCurrentRoll) break; 
-
-        if (isStrike(rollIndex)) { // Strike
-            if (rollIndex + 2 < mCurrentRoll) { 
-                 mFrameScores[frame] = 10 + strikeBonus(rollIndex);
-                 mTotalScore += mFrameScores[frame];
-            }
-            rollIndex++;
-        } else if (isSpare(rollIndex)) { // Spare
-            if (rollIndex + 2 < mCurrentRoll) { 
-                mFrameScores[frame] = 10 + spareBonus(rollIndex);
-                mTotalScore += mFrameScores[frame];
-            }
-            rollIndex += 2;
-        } else { // Open frame
-            if (rollIndex + 1 < mCurrentRoll) { 
-                mFrameScores[frame] = openFrameScore(rollIndex);
-                mTotalScore += mFrameScores[frame];
+// Voisines de chaque quille dans le triangle (indices de BowlingLane::computePinPositions :
+// 9 en tête, puis 7-8, 4-5-6, 0-1-2-3), y compris la quille juste derrière (9-5, 7-1, 8-2)
+static const int PIN_NEIGHBOURS[10] = {
+    (1 << 1) | (1 << 4),                                    // 0
+    (1 << 0) | (1 << 2) | (1 << 4) | (1 << 5) | (1 << 7),   // 1
+    (1 << 1) | (1 << 3) | (1 << 5) | (1 << 6) | (1 << 8),   // 2
+    (1 << 2) | (1 << 6),                                    // 3
+    (1 << 0) | (1 << 1) | (1 << 5) | (1 << 7),              // 4
+    (1 << 1) | (1 << 2) | (1 << 4) | (1 << 6) | (1 << 7) | (1 << 8) | (1 << 9), // 5
+    (1 << 2) | (1 << 3) | (1 << 5) | (1 << 8),              // 6
+    (1 << 1) | (1 << 4) | (1 << 5) | (1 << 8) | (1 << 9),   // 7
+    (1 << 2) | (1 << 5) | (1 << 6) | (1 << 7) | (1 << 9),   // 8
+    (1 << 5) | (1 << 7) | (1 << 8)                          // 9
+};
+static const int HEAD_PIN_BIT = 1 << 9;
+static const int ALL_PINS = (1 << 10) - 1;
+
+bool ScoreManager::isSplit(int knockedDownMask) {
+    int standing = ~knockedDownMask & ALL_PINS;
+    if ((standing & HEAD_PIN_BIT) || (standing & (standing - 1)) == 0) {
+        return false;
+    }
+    // Groupe de la première quille debout, étendu de voisine en voisine
+    int group = standing & -standing;
+    int previous = 0;
+    while (group != previous) {
+        previous = group;
+        for (int pin = 0; pin < 10; ++pin) {
+            if (group & (1 << pin)) {
+                group |= PIN_NEIGHBOURS[pin] & standing;
             }
-            rollIndex += 2;
-        }
-        
-        // Gérer le cas où le calcul s'arrête car les lancers suivants n'ont pas été faits
-        if (rollIndex >= mCurrentRoll && frame < 9) {
-             break; 
         }
     }
-    Ogre::LogManager::getSingleton().logMessage("ScoreManager: Score calculated. Total = " + Ogre::StringConverter::toString(mTotalScore));
+    return group != standing;
 }
 
 void ScoreManager::updateScoreDisplay() {
-    if (mScoreText) {
+    if (mScoreText && mTotalScore != mDisplayedScore) {
         mScoreText->setCaption("Score: " + Ogre::StringConverter::toString(mTotalScore));
+        mDisplayedScore = mTotalScore;
     }
 }
 
 int ScoreManager::getCurrentScore() const {
     return mTotalScore;
 }
-
-bool ScoreManager::isStrike(int rollIndex) const {
-    return mRolls[rollIndex] == 10;
-}
-
-bool ScoreManager::isSpare(int rollIndex) const {
-    if (rollIndex + 1 < MAX_ROLLS) {
-        return mRolls[rollIndex] + mRolls[rollIndex + 1] == 10;
-    }
-    return false;
-}
-
-int ScoreManager::strikeBonus(int rollIndex) const {
-    if (rollIndex + 2 < MAX_ROLLS) {
-        return mRolls[rollIndex + 1] + mRolls[rollIndex + 2];
-    }
-    return 0;
-}
-
-int ScoreManager::spareBonus(int rollIndex) const {
-    if (rollIndex + 2 < MAX_ROLLS) {
-        return mRolls[rollIndex + 2];
-    }
-    return 0; // Pas assez de lancers pour le bonus
-}
-
-int ScoreManager::openFrameScore(int rollIndex) const {
-    if (rollIndex + 1 < MAX_ROLLS) {
-        return mRolls[rollIndex] + mRolls[rollIndex + 1];
-    }
-    return 0; // Pas assez de lancers pour le score
-}
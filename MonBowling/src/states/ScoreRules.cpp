@@ -0,0 +1,242 @@
+#include "../../include/states/ScoreRules.h"
+
+bool ScoreRules::isStrike(const std::array<int, MAX_ROLLS>& rolls, int rollIndex) {
+    return rolls[rollIndex] == 10;
+}
+
+bool ScoreRules::isSpare(const std::array<int, MAX_ROLLS>& rolls, int rollIndex) {
+    if (rollIndex + 1 < MAX_ROLLS) {
+        return rolls[rollIndex] + rolls[rollIndex + 1] == 10;
+    }
+    return false;
+}
+
+int ScoreRules::strikeBonus(const std::array<int, MAX_ROLLS>& rolls, int rollIndex) {
+    if (rollIndex + 2 < MAX_ROLLS) {
+        return rolls[rollIndex + 1] + rolls[rollIndex + 2];
+    }
+    return 0;
+}
+
+int ScoreRules::spareBonus(const std::array<int, MAX_ROLLS>& rolls, int rollIndex) {
+    if (rollIndex + 2 < MAX_ROLLS) {
+        return rolls[rollIndex + 2];
+    }
+    return 0; // Pas assez de lancers pour le bonus
+}
+
+int ScoreRules::openFrameScore(const std::array<int, MAX_ROLLS>& rolls, int rollIndex) {
+    if (rollIndex + 1 < MAX_ROLLS) {
+        return rolls[rollIndex] + rolls[rollIndex + 1];
+    }
+    return 0; // Pas assez de lancers pour le score
+}
+
+int ScoreRules::scoreRolls(const std::array<int, MAX_ROLLS>& rolls, int rollCount,
+                           std::array<int, FRAME_COUNT>& frameScores) {
+    int totalScore = 0;
+    frameScores.fill(0);
+    int rollIndex = 0;
+
+    for (int frame = 0; frame < FRAME_COUNT; ++frame) {
+        if (rollIndex >= rollCount) break;
+
+        if (isStrike(rolls, rollIndex)) { // Strike
+            if (rollIndex + 2 < rollCount) {
+                 frameScores[frame] = 10 + strikeBonus(rolls, rollIndex);
+                 totalScore += frameScores[frame];
+            }
+            rollIndex++;
+        } else if (isSpare(rolls, rollIndex)) { // Spare
+            if (rollIndex + 2 < rollCount) {
+                frameScores[frame] = 10 + spareBonus(rolls, rollIndex);
+                totalScore += frameScores[frame];
+            }
+            rollIndex += 2;
+        } else { // Open frame
+            if (rollIndex + 1 < rollCount) {
+                frameScores[frame] = openFrameScore(rolls, rollIndex);
+                totalScore += frameScores[frame];
+            }
+            rollIndex += 2;
+        }
+
+        // Gérer le cas où le calcul s'arrête car les lancers suivants n'ont pas été faits
+        if (rollIndex >= rollCount && frame < FRAME_COUNT - 1) {
+             break;
+        }
+    }
+    return totalScore;
+}
+
+bool ScoreRules::pack(const int* rolls, int rollCount, PackedGame& game) {
+    if (rollCount < 0 || rollCount > MAX_ROLLS) {
+        return false;
+    }
+    game.lo = ~0ull;
+    game.hi = ~0ull;
+    for (int i = 0; i < rollCount; ++i) {
+        if (rolls[i] < 0 || rolls[i] > 10) {
+            return false;
+        }
+        uint64_t& word = i < 16 ? game.lo : game.hi;
+        int shift = 4 * (i & 15);
+        word = (word & ~(0xFull << shift)) | (static_cast<uint64_t>(rolls[i]) << shift);
+    }
+    return true;
+}
+
+int ScoreRules::unpack(const PackedGame& game, int* rolls) {
+    int count = 0;
+    for (; count < MAX_ROLLS; ++count) {
+        uint64_t word = count < 16 ? game.lo : game.hi;
+        int pins = static_cast<int>((word >> (4 * (count & 15))) & 0xF);
+        if (pins == NO_ROLL) {
+            break;
+        }
+        rolls[count] = pins;
+    }
+    return count;
+}
+
+void ScoreRules::countMarks(const PackedGame& game, MarkCounts& counts) {
+    // Une partie valide se lit jeu par jeu, 10e frame comprise (quilles relevées après
+    // un strike ou un spare) : pas besoin de suivre les frames
+    int rolls[MAX_ROLLS];
+    int count = unpack(game, rolls);
+    int rackPins = -1;      // Quilles couchées par la première boule du jeu, -1 : jeu neuf
+    for (int i = 0; i < count; ++i) {
+        if (rackPins < 0) {
+            ++counts.strikeChances;
+            if (rolls[i] == 10) {
+                ++counts.strikes;
+            } else {
+                ++counts.spareChances;
+                rackPins = rolls[i];
+            }
+        } else {
+            counts.spares += rackPins + rolls[i] == 10;
+            rackPins = -1;
+        }
+    }
+}
+
+// Noyau commun, sans branchement : LANES parties avancent ensemble, une frame à la fois.
+// Les lancers de la frame sont lus dans les quartets de poids faible, puis chaque partie est
+// décalée de 1 (strike) ou 2 lancers en faisant entrer des quartets vides par le haut : une
+// partie valide est entièrement vide (tous les bits à 1) une fois ses lancers consommés.
+// Les conditions valent 0 ou 1 et servent de multiplicateurs ou de sélections ; les décalages
+// sont constants, ce qui permet au compilateur de vectoriser les boucles sur les parties.
+// Un quartet vide (15) donne un score sans signification, mais la partie est alors invalide.
+template <int LANES>
+static inline void scoreKernel(const PackedGame* games, uint64_t* scores, uint64_t* errors) {
+    const uint64_t EMPTY = ~0ull;
+    const uint64_t NO_ROLL = ScoreRules::NO_ROLL;
+    uint64_t lo[LANES];
+    uint64_t hi[LANES];
+    for (int l = 0; l < LANES; ++l) {
+        lo[l] = games[l].lo;
+        hi[l] = games[l].hi;
+        scores[l] = 0;
+        errors[l] = 0;
+    }
+
+    for (int frame = 0; frame < ScoreRules::FRAME_COUNT - 1; ++frame) {
+        for (int l = 0; l < LANES; ++l) {
+            uint64_t r0 = lo[l] & 0xF;
+            uint64_t r1 = (lo[l] >> 4) & 0xF;
+            uint64_t r2 = (lo[l] >> 8) & 0xF;
+            uint64_t strike = r0 == 10;
+            uint64_t second = 1 - strike;       // Le deuxième lancer appartient à la frame
+            uint64_t bonus = strike | (second & (r0 + r1 == 10));
+
+            uint64_t missing0 = r0 == NO_ROLL;
+            uint64_t missing1 = second & (r1 == NO_ROLL);
+            errors[l] |= (((r0 > 10) & (1 - missing0)) | (second & (r1 > 10) & (1 - missing1))) * SCORE_ERROR_PIN_COUNT;
+            errors[l] |= (missing0 | missing1) * SCORE_ERROR_MISSING_ROLL;
+            errors[l] |= (second & (r0 + r1 > 10) & (r0 <= 10) & (r1 <= 10)) * SCORE_ERROR_RACK_TOTAL;
+            scores[l] += r0 + r1 + r2 * bonus;
+
+            uint64_t oneLo = (lo[l] >> 4) | (hi[l] << 60);
+            uint64_t oneHi = (hi[l] >> 4) | (EMPTY << 60);
+            uint64_t twoLo = (lo[l] >> 8) | (hi[l] << 56);
+            uint64_t twoHi = (hi[l] >> 8) | (EMPTY << 56);
+            lo[l] = strike ? oneLo : twoLo;
+            hi[l] = strike ? oneHi : twoHi;
+        }
+    }
+
+    // 10e frame : deux lancers, trois après un strike ou un spare (quilles relevées)
+    for (int l = 0; l < LANES; ++l) {
+        uint64_t r0 = lo[l] & 0xF;
+        uint64_t r1 = (lo[l] >> 4) & 0xF;
+        uint64_t r2 = (lo[l] >> 8) & 0xF;
+        uint64_t strike = r0 == 10;
+        uint64_t bonus = strike | (r0 + r1 == 10);
+        uint64_t missing0 = r0 == NO_ROLL;
+        uint64_t missing1 = r1 == NO_ROLL;
+        uint64_t missing2 = bonus & (r2 == NO_ROLL);
+        errors[l] |= (((r0 > 10) & (1 - missing0)) | ((r1 > 10) & (1 - missing1)) |
+                      (bonus & (r2 > 10) & (1 - missing2))) * SCORE_ERROR_PIN_COUNT;
+        errors[l] |= (missing0 | missing1 | missing2) * SCORE_ERROR_MISSING_ROLL;
+        // Même jeu de quilles : deux premiers lancers sans strike, ou deux derniers après un strike
+        errors[l] |= (((1 - strike) & (r0 + r1 > 10) & (r0 <= 10) & (r1 <= 10)) |
+                      (strike & (r1 < 10) & (r1 + r2 > 10) & (r2 <= 10))) * SCORE_ERROR_RACK_TOTAL;
+        scores[l] += r0 + r1 + r2 * bonus;
+
+        // Après les lancers de la frame, plus rien : tous les quartets restants sont vides
+        uint64_t twoLo = (lo[l] >> 8) | (hi[l] << 56);
+        uint64_t twoHi = (hi[l] >> 8) | (EMPTY << 56);
+        uint64_t threeLo = (lo[l] >> 12) | (hi[l] << 52);
+        uint64_t threeHi = (hi[l] >> 12) | (EMPTY << 52);
+        uint64_t restLo = bonus ? threeLo : twoLo;
+        uint64_t restHi = bonus ? threeHi : twoHi;
+        errors[l] |= ((restLo != EMPTY) | (restHi != EMPTY)) * SCORE_ERROR_EXTRA_ROLL;
+    }
+}
+
+// Parties traitées ensemble par le noyau du lot
+static const int BATCH_LANES = 8;
+
+uint8_t ScoreRules::validate(const PackedGame& game) {
+    uint64_t score;
+    uint64_t errors;
+    scoreKernel<1>(&game, &score, &errors);
+    return static_cast<uint8_t>(errors);
+}
+
+int ScoreRules::scoreGame(const PackedGame& game) {
+    uint64_t score;
+    uint64_t errors;
+    scoreKernel<1>(&game, &score, &errors);
+    return errors ? -1 : static_cast<int>(score);
+}
+
+size_t ScoreRules::scoreGames(const PackedGame* games, size_t count, int16_t* scores, uint8_t* errors) {
+    uint64_t blockScores[BATCH_LANES];
+    uint64_t blockErrors[BATCH_LANES];
+    size_t invalid = 0;
+    size_t i = 0;
+    for (; i + BATCH_LANES <= count; i += BATCH_LANES) {
+        scoreKernel<BATCH_LANES>(games + i, blockScores, blockErrors);
+        for (int l = 0; l < BATCH_LANES; ++l) {
+            scores[i + l] = static_cast<int16_t>(blockErrors[l] ? -1 : static_cast<int>(blockScores[l]));
+            invalid += blockErrors[l] != 0;
+        }
+        if (errors) {
+            for (int l = 0; l < BATCH_LANES; ++l) {
+                errors[i + l] = static_cast<uint8_t>(blockErrors[l]);
+            }
+        }
+    }
+    // Fin du lot, partie par partie
+    for (; i < count; ++i) {
+        scoreKernel<1>(games + i, blockScores, blockErrors);
+        scores[i] = static_cast<int16_t>(blockErrors[0] ? -1 : static_cast<int>(blockScores[0]));
+        invalid += blockErrors[0] != 0;
+        if (errors) {
+            errors[i] = static_cast<uint8_t>(blockErrors[0]);
+        }
+    }
+    return invalid;
+}
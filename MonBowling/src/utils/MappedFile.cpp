@@ -0,0 +1,178 @@
+#include "../../include/utils/MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile()
+    : mData(nullptr),
+      mSize(0),
+      mFile(INVALID_HANDLE_VALUE),
+      mMapping(nullptr)
+{}
+
+bool MappedFile::open(const std::string& path, size_t minimumSize) {
+    close();
+    mPath = path;
+    mFile = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                        OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (mFile == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(mFile, &size)) {
+        close();
+        return false;
+    }
+    mSize = static_cast<size_t>(size.QuadPart);
+    if (mSize < minimumSize) {
+        return resize(minimumSize);
+    }
+    if (!map()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool MappedFile::map() {
+    mMapping = CreateFileMappingA(mFile, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+    if (!mMapping) {
+        return false;
+    }
+    mData = static_cast<char*>(MapViewOfFile(mMapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+    return mData != nullptr;
+}
+
+void MappedFile::unmap() {
+    if (mData) {
+        UnmapViewOfFile(mData);
+        mData = nullptr;
+    }
+    if (mMapping) {
+        CloseHandle(mMapping);
+        mMapping = nullptr;
+    }
+}
+
+bool MappedFile::resize(size_t size) {
+    unmap();
+    LARGE_INTEGER position;
+    position.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(mFile, position, nullptr, FILE_BEGIN) || !SetEndOfFile(mFile)) {
+        close();
+        return false;
+    }
+    mSize = size;
+    if (!map()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::flush() {
+    if (mData) {
+        FlushViewOfFile(mData, 0);
+    }
+}
+
+void MappedFile::close() {
+    unmap();
+    if (mFile != INVALID_HANDLE_VALUE) {
+        CloseHandle(mFile);
+        mFile = INVALID_HANDLE_VALUE;
+    }
+    mSize = 0;
+}
+
+#else
+
+MappedFile::MappedFile()
+    : mData(nullptr),
+      mSize(0),
+      mFile(-1)
+{}
+
+bool MappedFile::open(const std::string& path, size_t minimumSize) {
+    close();
+    mPath = path;
+    mFile = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (mFile < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(mFile, &info) != 0) {
+        close();
+        return false;
+    }
+    mSize = static_cast<size_t>(info.st_size);
+    if (mSize < minimumSize) {
+        return resize(minimumSize);
+    }
+    if (!map()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool MappedFile::map() {
+    void* data = mmap(nullptr, mSize, PROT_READ | PROT_WRITE, MAP_SHARED, mFile, 0);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    mData = static_cast<char*>(data);
+    return true;
+}
+
+void MappedFile::unmap() {
+    if (mData) {
+        munmap(mData, mSize);
+        mData = nullptr;
+    }
+}
+
+bool MappedFile::resize(size_t size) {
+    unmap();
+    if (ftruncate(mFile, static_cast<off_t>(size)) != 0) {
+        close();
+        return false;
+    }
+    mSize = size;
+    if (!map()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::flush() {
+    if (mData) {
+        msync(mData, mSize, MS_ASYNC);
+    }
+}
+
+void MappedFile::close() {
+    unmap();
+    if (mFile >= 0) {
+        ::close(mFile);
+        mFile = -1;
+    }
+    mSize = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
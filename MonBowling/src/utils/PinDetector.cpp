@@ -1,18 +1,39 @@
 #include "../../include/utils/PinDetector.h"
+#include "../../include/utils/SimulationLog.h"
 
-PinDetector::PinDetector()
+PinDetector::PinDetector(PhysicsManager* physics)
     : mPins(nullptr),
       mDetectionActive(false),
       mDetectionComplete(false),
+      mSettleDetector(physics),
       mKnockedDownPinCount(0) {
 }
 
 PinDetector::~PinDetector() {
 }
 
-void PinDetector::initialize(const std::vector<std::unique_ptr<BowlingPin>>& pins) {
+void PinDetector::initialize(const std::vector<std::unique_ptr<BowlingPin>>& pins, const btRigidBody* ballBody) {
     // Stockage de la référence aux quilles
     mPins = &pins;
+
+    // Corps dont on attend le repos avant de valider le compte
+    mSettleDetector.clearBodies();
+    mSettleDetector.track(ballBody);
+    std::vector<const btRigidBody*> pinBodies;
+    for (const auto& pin : pins) {
+        if (pin && pin->getPinBody()) {
+            mSettleDetector.track(pin->getPinBody());
+            pinBodies.push_back(pin->getPinBody());
+        }
+    }
+
+    // Quilles relevées : leur position actuelle est leur emplacement
+    if (pinBodies.size() == pins.size()) {
+        mClassifier.setPins(pinBodies.data(), pinBodies.size());
+    } else {
+        mClassifier.setPins(nullptr, 0);
+        Ogre::LogManager::getSingleton().logError("PinDetector::initialize - quille sans corps rigide, détection désactivée");
+    }
     
     // Initialisation de l'état précédent des quilles
     mPreviousPinStates.resize(pins.size(), false);
@@ -26,7 +47,9 @@ void PinDetector::startDetection() {
     mDetectionActive = true;
     mDetectionComplete = false;
     
-    // Réinitialisation du compteur de quilles tombées
+    // Réinitialisation du compteur de quilles tombées ; les quilles déjà couchées par le
+    // premier lancer de la frame sont reclassées tout de suite
+    mClassifier.begin();
     mKnockedDownPinCount = 0;
     
     // Réinitialisation de l'état précédent des quilles
@@ -37,38 +60,35 @@ void PinDetector::startDetection() {
         }
     }
     
-    // Démarrage du minuteur pour le délai de cascade
-    mCascadeTimer.reset();
+    // Démarrage de la surveillance du repos (en pas physiques)
+    mSettleDetector.start();
     
-    Ogre::LogManager::getSingleton().logMessage("Détection des quilles démarrée");
+    SimulationLog::message("Détection des quilles démarrée");
 }
 
 void PinDetector::update(float deltaTime) {
     if (!mDetectionActive || !mPins) return;
 
-    int currentKnockedDown = 0;
-    for (size_t i = 0; i < mPins->size(); ++i) {
-        const auto& pin = (*mPins)[i];
-        if (pin && pin->isKnockedDown()) {
-            currentKnockedDown++;
-            if (!mPreviousPinStates[i]) {
-                mPreviousPinStates[i] = true;
-                Ogre::LogManager::getSingleton().logMessage("Quille " + Ogre::StringConverter::toString(i+1) + " tombée");
-            }
+    // Toutes les quilles en une passe ; une quille qui glisse debout ou qui oscille
+    // autour du seuil ne fait pas varier le compte (hystérésis du classement)
+    mKnockedDownPinCount = mClassifier.update();
+    for (size_t i = 0; i < mClassifier.getPinCount(); ++i) {
+        PinFallState state = mClassifier.getState(i);
+        if (PinFallClassifier::isKnockedDown(state) && !mPreviousPinStates[i]) {
+            mPreviousPinStates[i] = true;
+            SimulationLog::message("Quille " + Ogre::StringConverter::toString(i+1) + " " +
+                                                       PinFallClassifier::getStateName(state));
         }
     }
-    mKnockedDownPinCount = currentKnockedDown; // Mettre à jour en temps réel
 
-    if (mCascadeTimer.getMilliseconds() >= CASCADE_DELAY) {
+    // Le compte n'est définitif qu'une fois tout au repos : une quille qui vacille
+    // longtemps avant de tomber est encore comptée
+    if (mSettleDetector.update()) {
         mDetectionComplete = true;
         mDetectionActive = false;
-        Ogre::LogManager::getSingleton().logMessage("Détection des quilles terminée. Nombre de quilles tombées : " + 
-                                                   Ogre::StringConverter::toString(mKnockedDownPinCount));
-    } else if (mCascadeTimer.getMilliseconds() % 500 < 20) {
-        Ogre::LogManager::getSingleton().logMessage("Détection en cours... Temps écoulé : " + 
-                                                   Ogre::StringConverter::toString(mCascadeTimer.getMilliseconds()) + 
-                                                   " ms, Quilles tombées : " + 
-                                                   Ogre::StringConverter::toString(currentKnockedDown));
+        SimulationLog::message("Détection des quilles terminée. Nombre de quilles tombées : " + 
+                                                   Ogre::StringConverter::toString(mKnockedDownPinCount) +
+                                                   " (repos après " + Ogre::StringConverter::toString(mSettleDetector.getSettleTime()) + " s)");
     }
 }
 
@@ -85,6 +105,7 @@ void PinDetector::reset() {
     mDetectionActive = false;
     mDetectionComplete = false;
     mKnockedDownPinCount = 0;
+    mSettleDetector.reset();
     
     // Réinitialisation de l'état précédent des quilles
     if (mPins) {
@@ -0,0 +1,161 @@
+#include "../../include/utils/PinFallClassifier.h"
+#include <algorithm>
+#include <cmath>
+
+static const float DEGREES_TO_RADIANS = 0.01745329252f;
+
+struct ClassifierLimits {
+    float cosFallen;
+    float cosRaise;
+    float cosWobble;
+    float wobbleDisplacementSq;
+    float offDeckDrop;
+};
+
+// Un état à partir de l'axe vertical, du glissement et de l'état précédent. Que des
+// sélections : la boucle de PinFallClassifier::classifyAll reste vectorisable.
+static inline unsigned char computeState(float upY, float dx, float dz, float drop,
+                                         unsigned char previous, const ClassifierLimits& limits) {
+    const unsigned char offDeckState = static_cast<unsigned char>(PinFallState::OFF_DECK);
+    const unsigned char fallenState = static_cast<unsigned char>(PinFallState::FALLEN);
+
+    // Couchée : le seuil dépend de l'état précédent (hystérésis)
+    float cosLimit = (previous == fallenState) ? limits.cosRaise : limits.cosFallen;
+    bool offDeck = (drop > limits.offDeckDrop) | (previous == offDeckState);
+    bool fallen = upY < cosLimit;
+    bool wobbling = (upY < limits.cosWobble) | (dx * dx + dz * dz > limits.wobbleDisplacementSq);
+
+    unsigned char state = wobbling ? 1 : 0;
+    state = fallen ? fallenState : state;
+    state = offDeck ? offDeckState : state;
+    return state;
+}
+
+static ClassifierLimits makeLimits(const PinFallThresholds& thresholds) {
+    ClassifierLimits limits;
+    limits.cosFallen = std::cos(thresholds.fallenAngle * DEGREES_TO_RADIANS);
+    limits.cosRaise = std::cos(std::max(0.0f, thresholds.fallenAngle - thresholds.hysteresisAngle) * DEGREES_TO_RADIANS);
+    limits.cosWobble = std::cos(thresholds.wobbleAngle * DEGREES_TO_RADIANS);
+    limits.wobbleDisplacementSq = thresholds.wobbleDisplacement * thresholds.wobbleDisplacement;
+    limits.offDeckDrop = thresholds.offDeckDrop;
+    return limits;
+}
+
+PinFallClassifier::PinFallClassifier(const PinFallThresholds& thresholds)
+    : mCosFallen(0.0f),
+      mCosRaise(0.0f),
+      mCosWobble(0.0f),
+      mWobbleDisplacementSq(0.0f),
+      mKnockedDownCount(0),
+      mKnockedDownMask(0) {
+    setThresholds(thresholds);
+}
+
+void PinFallClassifier::setThresholds(const PinFallThresholds& thresholds) {
+    mThresholds = thresholds;
+    ClassifierLimits limits = makeLimits(thresholds);
+    mCosFallen = limits.cosFallen;
+    mCosRaise = limits.cosRaise;
+    mCosWobble = limits.cosWobble;
+    mWobbleDisplacementSq = limits.wobbleDisplacementSq;
+}
+
+void PinFallClassifier::setPins(const btRigidBody* const* bodies, size_t count) {
+    mBodies.assign(bodies, bodies + count);
+    mSpotX.resize(count);
+    mSpotY.resize(count);
+    mSpotZ.resize(count);
+    mUpY.resize(count);
+    mPosX.resize(count);
+    mPosY.resize(count);
+    mPosZ.resize(count);
+    mStates.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const btVector3& origin = mBodies[i]->getWorldTransform().getOrigin();
+        mSpotX[i] = origin.x();
+        mSpotY[i] = origin.y();
+        mSpotZ[i] = origin.z();
+    }
+    begin();
+}
+
+void PinFallClassifier::begin() {
+    std::fill(mStates.begin(), mStates.end(), static_cast<unsigned char>(PinFallState::STANDING));
+    update();
+}
+
+int PinFallClassifier::update() {
+    gather();
+    classifyAll();
+    return mKnockedDownCount;
+}
+
+void PinFallClassifier::gather() {
+    // Composante verticale de l'axe Y local : 2e colonne de la base, 2e ligne
+    const size_t count = mBodies.size();
+    for (size_t i = 0; i < count; ++i) {
+        const btTransform& transform = mBodies[i]->getWorldTransform();
+        mUpY[i] = transform.getBasis()[1][1];
+        mPosX[i] = transform.getOrigin().x();
+        mPosY[i] = transform.getOrigin().y();
+        mPosZ[i] = transform.getOrigin().z();
+    }
+}
+
+void PinFallClassifier::classifyAll() {
+    ClassifierLimits limits;
+    limits.cosFallen = mCosFallen;
+    limits.cosRaise = mCosRaise;
+    limits.cosWobble = mCosWobble;
+    limits.wobbleDisplacementSq = mWobbleDisplacementSq;
+    limits.offDeckDrop = mThresholds.offDeckDrop;
+
+    const size_t count = mBodies.size();
+    const float* upY = mUpY.data();
+    const float* posX = mPosX.data();
+    const float* posY = mPosY.data();
+    const float* posZ = mPosZ.data();
+    const float* spotX = mSpotX.data();
+    const float* spotY = mSpotY.data();
+    const float* spotZ = mSpotZ.data();
+    unsigned char* states = mStates.data();
+
+    for (size_t i = 0; i < count; ++i) {
+        states[i] = computeState(upY[i], posX[i] - spotX[i], posZ[i] - spotZ[i], spotY[i] - posY[i],
+                                 states[i], limits);
+    }
+
+    // Compte et masque (bit i pour les 31 premières quilles)
+    mKnockedDownCount = 0;
+    mKnockedDownMask = 0;
+    for (size_t i = 0; i < count; ++i) {
+        int down = (states[i] >= static_cast<unsigned char>(PinFallState::FALLEN)) ? 1 : 0;
+        mKnockedDownCount += down;
+        if (i < 31) {
+            mKnockedDownMask |= down << i;
+        }
+    }
+}
+
+int PinFallClassifier::countState(PinFallState state) const {
+    return static_cast<int>(std::count(mStates.begin(), mStates.end(), static_cast<unsigned char>(state)));
+}
+
+PinFallState PinFallClassifier::classify(const btTransform& transform, const btVector3& spot,
+                                         const PinFallThresholds& thresholds) {
+    const btVector3& origin = transform.getOrigin();
+    return static_cast<PinFallState>(computeState(
+        transform.getBasis()[1][1], origin.x() - spot.x(), origin.z() - spot.z(), spot.y() - origin.y(),
+        static_cast<unsigned char>(PinFallState::STANDING), makeLimits(thresholds)));
+}
+
+const char* PinFallClassifier::getStateName(PinFallState state) {
+    switch (state) {
+        case PinFallState::STANDING: return "debout";
+        case PinFallState::WOBBLING: return "vacille";
+        case PinFallState::FALLEN: return "tombée";
+        case PinFallState::OFF_DECK: return "hors du plateau";
+    }
+    return "?";
+}
@@ -0,0 +1,164 @@
+#include "../../include/utils/RollSettleDetector.h"
+#include "../../include/utils/SimulationLog.h"
+#include <OgreLogManager.h>
+#include <OgreStringConverter.h>
+#include <algorithm>
+
+// Seuils par défaut : même seuil linéaire que l'arrêt de la boule, et une quille
+// qui oscille sur sa base dépasse largement 0.1 rad/s entre deux points morts
+static const float DEFAULT_LINEAR_THRESHOLD = 0.05f;
+static const float DEFAULT_ANGULAR_THRESHOLD = 0.1f;
+// Plus long que le passage par un point mort d'une quille qui vacille
+static const float DEFAULT_QUIET_TIME = 0.3f;
+// Le plateau de la piste est à y = 0, la fosse environ 0.6 plus bas
+static const float DEFAULT_OUT_OF_PLAY_HEIGHT = -0.3f;
+static const int DEFAULT_FRESH_CONTACT_STEPS = 3;
+
+static bool isOutOfPlay(const btCollisionObject* body, float outOfPlayHeight) {
+    return body->getWorldTransform().getOrigin().y() < outOfPlayHeight;
+}
+
+RollSettleDetector::RollSettleDetector(PhysicsManager* physics)
+    : mPhysics(physics ? physics : PhysicsManager::getInstance()),
+      mActive(false),
+      mSettled(false),
+      mStartStep(0),
+      mLastStep(0),
+      mSettleStep(0),
+      mStartTime(0.0),
+      mLastTime(0.0),
+      mSettleTime(0.0),
+      mActiveContacts(0),
+      mBodiesAtRest(0),
+      mLinearThreshold(DEFAULT_LINEAR_THRESHOLD),
+      mAngularThreshold(DEFAULT_ANGULAR_THRESHOLD),
+      mQuietTime(DEFAULT_QUIET_TIME),
+      mOutOfPlayHeight(DEFAULT_OUT_OF_PLAY_HEIGHT),
+      mFreshContactSteps(DEFAULT_FRESH_CONTACT_STEPS) {
+}
+
+void RollSettleDetector::track(const btRigidBody* body) {
+    if (!body || isTracked(body)) return;
+    mBodies.push_back(body);
+    mQuietTimes.push_back(0.0f);
+}
+
+void RollSettleDetector::clearBodies() {
+    mBodies.clear();
+    mQuietTimes.clear();
+    reset();
+}
+
+void RollSettleDetector::setVelocityThresholds(float linear, float angular) {
+    mLinearThreshold = linear;
+    mAngularThreshold = angular;
+}
+
+void RollSettleDetector::start() {
+    mActive = true;
+    mSettled = false;
+    mStartStep = mPhysics->getStepCount();
+    mLastStep = mStartStep;
+    mSettleStep = mStartStep;
+    mStartTime = mPhysics->getSimulatedTime();
+    mLastTime = mStartTime;
+    mSettleTime = mStartTime;
+    mActiveContacts = 0;
+    mBodiesAtRest = 0;
+    std::fill(mQuietTimes.begin(), mQuietTimes.end(), 0.0f);
+}
+
+void RollSettleDetector::reset() {
+    mActive = false;
+    mSettled = false;
+    mActiveContacts = 0;
+    mBodiesAtRest = 0;
+    std::fill(mQuietTimes.begin(), mQuietTimes.end(), 0.0f);
+}
+
+bool RollSettleDetector::isTracked(const btCollisionObject* object) const {
+    return std::find(mBodies.begin(), mBodies.end(), object) != mBodies.end();
+}
+
+int RollSettleDetector::countActiveContacts() const {
+    btDispatcher* dispatcher = mPhysics->getDynamicsWorld()->getBtWorld()->getDispatcher();
+    int activeContacts = 0;
+
+    for (int i = 0; i < dispatcher->getNumManifolds(); ++i) {
+        const btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(i);
+        const btCollisionObject* body0 = manifold->getBody0();
+        const btCollisionObject* body1 = manifold->getBody1();
+
+        bool watched0 = isTracked(body0) && !isOutOfPlay(body0, mOutOfPlayHeight);
+        bool watched1 = isTracked(body1) && !isOutOfPlay(body1, mOutOfPlayHeight);
+        if (!watched0 && !watched1) continue;
+
+        for (int p = 0; p < manifold->getNumContacts(); ++p) {
+            const btManifoldPoint& point = manifold->getContactPoint(p);
+            if (point.getDistance() <= 0.0f && point.getLifeTime() < mFreshContactSteps) {
+                ++activeContacts;
+            }
+        }
+    }
+    return activeContacts;
+}
+
+bool RollSettleDetector::update() {
+    if (!mActive) return mSettled;
+
+    unsigned long currentStep = mPhysics->getStepCount();
+    if (currentStep == mLastStep) return false;  // Aucun pas depuis le dernier appel
+    double currentTime = mPhysics->getSimulatedTime();
+    float elapsed = static_cast<float>(currentTime - mLastTime);
+    mLastStep = currentStep;
+    mLastTime = currentTime;
+
+    const float linearSq = mLinearThreshold * mLinearThreshold;
+    const float angularSq = mAngularThreshold * mAngularThreshold;
+
+    mBodiesAtRest = 0;
+    for (size_t i = 0; i < mBodies.size(); ++i) {
+        const btRigidBody* body = mBodies[i];
+
+        if (body->getActivationState() == ISLAND_SLEEPING || isOutOfPlay(body, mOutOfPlayHeight)) {
+            mQuietTimes[i] = mQuietTime;
+        }
+        else if (body->getLinearVelocity().length2() < linearSq &&
+                 body->getAngularVelocity().length2() < angularSq) {
+            mQuietTimes[i] += elapsed;
+        }
+        else {
+            mQuietTimes[i] = 0.0f;
+        }
+
+        if (mQuietTimes[i] >= mQuietTime) {
+            ++mBodiesAtRest;
+        }
+    }
+
+    // Le parcours des contacts n'est utile que si tous les corps semblent immobiles
+    if (mBodiesAtRest < static_cast<int>(mBodies.size())) {
+        return false;
+    }
+    mActiveContacts = countActiveContacts();
+    if (mActiveContacts > 0) {
+        return false;
+    }
+
+    mActive = false;
+    mSettled = true;
+    mSettleStep = currentStep;
+    mSettleTime = currentTime;
+    SimulationLog::message("RollSettleDetector - lancer terminé après " +
+        Ogre::StringConverter::toString(getSettleTime()) + " s simulées (" +
+        Ogre::StringConverter::toString(getSettleStep()) + " pas)");
+    return true;
+}
+
+float RollSettleDetector::getSettleTime() const {
+    return static_cast<float>(mSettleTime - mStartTime);
+}
+
+float RollSettleDetector::getElapsedTime() const {
+    return static_cast<float>(mLastTime - mStartTime);
+}
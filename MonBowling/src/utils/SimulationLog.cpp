@@ -0,0 +1,16 @@
+#include "../../include/utils/SimulationLog.h"
+#include <OgreLogManager.h>
+
+std::atomic<bool> SimulationLog::sEnabled(true);
+
+void SimulationLog::refresh() {
+    Ogre::LogManager* manager = Ogre::LogManager::getSingletonPtr();
+    Ogre::Log* log = manager ? manager->getDefaultLog() : nullptr;
+    sEnabled.store(log && log->getMinLogLevel() <= Ogre::LML_NORMAL, std::memory_order_relaxed);
+}
+
+void SimulationLog::message(const std::string& text) {
+    if (enabled()) {
+        Ogre::LogManager::getSingleton().logMessage(text);
+    }
+}
@@ -0,0 +1,57 @@
+// Joue des parties complètes sans rendu ni audio et mesure le débit de lancers.
+// Usage : BowlingHeadless [nombre_de_parties] [graine]
+#include "core/BowlingSimulation.h"
+#include "managers/PhysicsManager.h"
+#include <OgreLogManager.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+int main(int argc, char** argv) {
+    int games = (argc > 1) ? std::atoi(argv[1]) : 10;
+    unsigned int seed = (argc > 2) ? static_cast<unsigned int>(std::atoi(argv[2])) : 42u;
+
+    // Pas de Ogre::Root : seul le LogManager est nécessaire (sans sortie console)
+    Ogre::LogManager logManager;
+    Ogre::Log* log = logManager.createLog("BowlingHeadless.log", true, false, true);
+    log->setMinLogLevel(Ogre::LML_WARNING);
+
+    BowlingSimulation simulation;
+    simulation.initialize();
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> aimX(-0.05f, 0.05f);
+    std::uniform_real_distribution<float> power(40.0f, MAX_POWER);
+    std::uniform_real_distribution<float> spin(MIN_SPIN, MAX_SPIN);
+
+    int rolls = 0;
+    long totalScore = 0;
+    double simulatedRollTime = 0.0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int game = 0; game < games; ++game) {
+        simulation.resetGame();
+        while (!simulation.isGameOver()) {
+            Ogre::Vector3 direction(aimX(rng), 0.0f, -1.0f);
+            simulation.roll(direction, power(rng), spin(rng));
+            simulatedRollTime += simulation.getLastRollTime();
+            ++rolls;
+        }
+        totalScore += simulation.getScore();
+        std::cout << "Partie " << (game + 1) << " : " << simulation.getScore() << std::endl;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << games << " parties, " << rolls << " lancers en " << seconds << " s ("
+              << (seconds > 0.0 ? rolls / seconds : 0.0) << " lancers/s, "
+              << PhysicsManager::getInstance()->getStepCount() << " pas physiques)" << std::endl;
+    if (games > 0) {
+        std::cout << "Score moyen : " << static_cast<double>(totalScore) / games << std::endl;
+    }
+    if (rolls > 0) {
+        // Durée simulée jusqu'au repos de la boule et des quilles (RollSettleDetector)
+        std::cout << "Durée simulée moyenne d'un lancer : " << simulatedRollTime / rolls << " s" << std::endl;
+    }
+    return 0;
+}
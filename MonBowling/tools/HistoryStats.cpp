@@ -0,0 +1,227 @@
+// Statistiques de l'historique des parties (GameHistory) : moyenne, strikes, spares, quilles
+// laissées après la première boule et résumé par piste, avec les filtres de l'historique.
+// --generate ajoute d'abord des parties tirées au hasard (plusieurs années de ligue) pour
+// mesurer le parcours des colonnes sur un gros historique.
+//
+// Usage : BowlingHistory [options]
+//   --dir chemin       dossier de l'historique (défaut history)
+//   --player nom       parties d'un joueur seulement
+//   --lane N           parties d'une piste seulement
+//   --from t           parties jouées à partir de t (secondes depuis 1970)
+//   --to t             parties jouées jusqu'à t (secondes depuis 1970)
+//   --leaves N         quilles laissées les plus fréquentes à afficher (défaut 10)
+//   --generate N       parties synthétiques à ajouter avant les requêtes (défaut 0)
+//   --lanes N          pistes des parties synthétiques (défaut 8)
+//   --strike p         probabilité de coucher toutes les quilles restantes (défaut 0.3)
+//   --seed s           graine (défaut 42)
+#include "core/FrameLogic.h"
+#include "core/GameHistory.h"
+#include "ToolOptions.h"
+
+#include <OgreLogManager.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    std::string directory = "history";
+    std::string player;
+    int lane = -1;
+    long long from = -1;
+    long long to = -1;
+    int leaves = 10;
+    long generate = 0;
+    int lanes = 8;
+    float strike = 0.3f;
+    unsigned int seed = 42;
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    return ToolOptions::parsePairs(argc, argv, [&options](const std::string& key, const std::string& value) {
+        if (key == "--dir") options.directory = value;
+        else if (key == "--player") options.player = value;
+        else if (key == "--lane") options.lane = ToolOptions::parseValue<int>(value);
+        else if (key == "--from") options.from = ToolOptions::parseValue<long long>(value);
+        else if (key == "--to") options.to = ToolOptions::parseValue<long long>(value);
+        else if (key == "--leaves") options.leaves = ToolOptions::parseValue<int>(value, 0);
+        else if (key == "--generate") options.generate = ToolOptions::parseValue<long>(value, 0L);
+        else if (key == "--lanes") options.lanes = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--strike") options.strike = ToolOptions::parseValue<float>(value);
+        else if (key == "--seed") options.seed = ToolOptions::parseValue<unsigned int>(value);
+        else return false;
+        return true;
+    });
+}
+
+// Numéro usuel (1 en tête, 7 à 10 au fond) de chaque bit du masque de BowlingLane
+const int PIN_NUMBERS[10] = {7, 8, 9, 10, 4, 5, 6, 2, 3, 1};
+
+std::string leaveName(int standing) {
+    std::vector<int> numbers;
+    for (int bit = 0; bit < 10; ++bit) {
+        if (standing & (1 << bit)) numbers.push_back(PIN_NUMBERS[bit]);
+    }
+    std::sort(numbers.begin(), numbers.end());
+    std::string name;
+    for (int number : numbers) {
+        name += (name.empty() ? "" : "-") + std::to_string(number);
+    }
+    return name.empty() ? "strike" : name;
+}
+
+// Partie tirée au hasard : quilles couchées choisies une à une parmi celles encore debout
+void generateRecord(std::mt19937& rng, const Options& options, GameHistory::Record& record) {
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+    FrameLogic frameLogic;
+    int standing = (1 << 10) - 1;
+    record.rollCount = 0;
+    record.leaves.fill(0);
+    while (!frameLogic.isGameOver()) {
+        int frame = frameLogic.getCurrentFrame();
+        bool firstBall = frameLogic.getCurrentRollInFrame() == 1;
+        int down = frameLogic.getPinsDownInRack();
+        int remaining = 10 - down;
+        int pins = chance(rng) < options.strike ? remaining
+                                                : std::uniform_int_distribution<int>(0, remaining)(rng);
+        for (int knocked = 0; knocked < pins; ++knocked) {
+            int pick = std::uniform_int_distribution<int>(0, remaining - knocked - 1)(rng);
+            for (int bit = 0; bit < 10; ++bit) {
+                if ((standing & (1 << bit)) && pick-- == 0) {
+                    standing &= ~(1 << bit);
+                    break;
+                }
+            }
+        }
+        if (firstBall) {
+            record.leaves[frame - 1] = static_cast<uint16_t>(standing);
+        }
+
+        GameHistory::Launch& launch = record.launches[record.rollCount];
+        launch.aim = std::uniform_real_distribution<float>(-0.1f, 0.1f)(rng);
+        launch.power = std::uniform_real_distribution<float>(6.0f, 9.0f)(rng);
+        launch.spin = std::uniform_real_distribution<float>(-1.0f, 1.0f)(rng);
+
+        RollResult result = frameLogic.recordRoll(down + pins);
+        record.rolls[record.rollCount++] = result.pinsThisRoll;
+        if (result.resetRack) {
+            standing = (1 << 10) - 1;
+        }
+    }
+    record.finalScore = ScoreRules::scoreRolls(record.rolls, record.rollCount, record.frameScores);
+}
+
+void printSummary(const std::string& label, const GameHistory::Summary& summary) {
+    std::cout << std::fixed << std::setprecision(1) << label << summary.games << " parties";
+    if (summary.games > 0) {
+        std::cout << ", moyenne " << summary.averageScore
+                  << ", max " << summary.highScore << ", min " << summary.lowScore
+                  << ", strikes " << summary.strikePercent() << " %"
+                  << ", spares " << summary.sparePercent() << " %";
+    }
+    std::cout << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Options invalides (voir l'en-tête de tools/HistoryStats.cpp)" << std::endl;
+        return 1;
+    }
+
+    // Pas de Ogre::Root : seul le LogManager est nécessaire (avertissements uniquement)
+    Ogre::LogManager logManager;
+    Ogre::Log* log = logManager.createLog("BowlingHistory.log", true, false, true);
+    log->setMinLogLevel(Ogre::LML_WARNING);
+
+    GameHistory history;
+    if (!history.open(options.directory)) {
+        std::cerr << "Historique illisible : " << options.directory << std::endl;
+        return 1;
+    }
+
+    if (options.generate > 0) {
+        std::mt19937 rng(options.seed);
+        const std::vector<std::string> players = {"Alex", "Camille", "Dominique", "Sacha", "Lou", "Charlie"};
+        // Parties réparties sur trois ans jusqu'à maintenant
+        const int64_t now = static_cast<int64_t>(std::time(nullptr));
+        const int64_t span = 3LL * 365 * 24 * 3600;
+        GameHistory::Record record;
+        auto start = std::chrono::steady_clock::now();
+        for (long i = 0; i < options.generate; ++i) {
+            record.player = players[std::uniform_int_distribution<size_t>(0, players.size() - 1)(rng)];
+            record.date = now - span + span * i / options.generate;
+            record.lane = std::uniform_int_distribution<int>(1, options.lanes)(rng);
+            generateRecord(rng, options, record);
+            if (!history.append(record)) {
+                std::cerr << "Ajout impossible (partie " << (i + 1) << ")" << std::endl;
+                return 1;
+            }
+        }
+        history.flush();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << std::fixed << std::setprecision(2) << options.generate << " parties ajoutées en "
+                  << seconds << " s (" << std::setprecision(0) << options.generate / seconds << " parties/s)" << std::endl;
+    }
+
+    GameHistory::Filter filter;
+    filter.lane = options.lane;
+    filter.from = options.from;
+    filter.to = options.to;
+    if (!options.player.empty()) {
+        filter.player = history.findPlayer(options.player);
+        if (filter.player < 0) {
+            std::cout << "Aucune partie pour " << options.player << std::endl;
+            return 0;
+        }
+    }
+
+    std::cout << history.getGameCount() << " parties dans " << options.directory
+              << " (" << history.getPlayers().size() << " joueurs)" << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    GameHistory::Summary summary = history.summarize(filter);
+    double summaryMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printSummary("sélection : ", summary);
+
+    start = std::chrono::steady_clock::now();
+    std::vector<GameHistory::LaneSummary> lanes = history.summarizeLanes(filter);
+    double lanesMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    for (const GameHistory::LaneSummary& lane : lanes) {
+        printSummary("  piste " + std::to_string(lane.lane) + " : ", lane.summary);
+    }
+
+    start = std::chrono::steady_clock::now();
+    GameHistory::LeaveCounts counts;
+    history.countLeaves(counts, filter);
+    double leavesMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // Les premières boules sont comptées pour les 10 frames de chaque partie
+    std::vector<int> order;
+    uint64_t firstBalls = 0;
+    for (int leave = 0; leave < static_cast<int>(counts.size()); ++leave) {
+        firstBalls += counts[leave];
+        if (counts[leave] > 0) order.push_back(leave);
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return counts[a] > counts[b]; });
+    if (order.size() > static_cast<size_t>(options.leaves)) order.resize(options.leaves);
+    std::cout << "quilles laissées (première boule) :" << std::endl;
+    for (int leave : order) {
+        std::cout << "  " << std::left << std::setw(22) << leaveName(leave) << std::right
+                  << std::setprecision(2) << std::setw(6) << 100.0 * counts[leave] / firstBalls << " %" << std::endl;
+    }
+
+    std::cout << std::setprecision(2) << "parcours : résumé " << summaryMs << " ms, pistes "
+              << lanesMs << " ms, quilles laissées " << leavesMs << " ms" << std::endl;
+    return 0;
+}
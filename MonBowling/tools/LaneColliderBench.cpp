@@ -0,0 +1,304 @@
+// Banc d'essai de la forme de collision de la piste : maillage triangulaire de polygon8.mesh
+// (BVH, avec la boîte de 1500x1500 du sol) contre la piste analytique (boîtes de
+// LaneDefinition, plan pour le sol).
+//  - coût de génération des contacts : temps de narrowphase rejouée par pas, paires et
+//    points de contact, sur des lancers complets dans le jeu de quilles ;
+//  - équivalence des trajectoires : lancers de la boule seule, écart maximal des positions
+//    tant que la boule est sur le plateau (hors gouttières et fosse).
+//
+// Usage : BowlingLaneColliderBench [options]
+//   --media dossier       dossier media du projet (défaut ../media)
+//   --steps N             pas simulés par lancer (défaut 600)
+//   --repeat N            répétitions des lancers de mesure (défaut 3)
+//   --tolerance m         écart toléré pour l'équivalence (défaut 0.01)
+#include "managers/BvhCache.h"
+#include "managers/PhysicsManager.h"
+#include "objects/BowlingBall.h"
+#include "objects/BowlingLane.h"
+#include "objects/BowlingPin.h"
+#include "objects/LaneCollider.h"
+#include "ToolOptions.h"
+#include <OgreDefaultHardwareBufferManager.h>
+#include <OgreRoot.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+const float GROUND_HEIGHT = -2.5f;
+const float LANE_SCALE = 10.0f;
+const float BALL_START_Z = 7.0f;
+
+struct Options {
+    std::string mediaDir = "../media";
+    int steps = 600;
+    int repeat = 3;
+    float tolerance = 0.01f;
+};
+
+struct Launch {
+    float angleDegrees;
+    float power;
+    float spin;
+};
+
+// Mêmes ordres de grandeur que les lancers du jeu (puissance sur 100)
+const std::vector<Launch> LAUNCHES = {
+    {0.0f, 60.0f, 0.0f},
+    {0.0f, 100.0f, 0.0f},
+    {1.0f, 80.0f, 0.5f},
+    {-1.0f, 70.0f, -0.5f},
+    {0.5f, 50.0f, 1.0f},
+};
+
+struct CostResult {
+    double stepUs = 0.0;
+    double narrowphaseUs = 0.0;
+    double narrowphaseP95Us = 0.0;
+    double pairs = 0.0;
+    double contacts = 0.0;
+    double pinsDown = 0.0;
+};
+
+// Monde avec l'une des deux pistes ; la boule et les quilles sont celles du jeu (sans rendu)
+class LaneWorld {
+    public:
+        PhysicsManager physics;
+        std::unique_ptr<BowlingBall> ball;
+        std::vector<std::unique_ptr<BowlingPin>> pins;
+
+        LaneWorld(btBvhTriangleMeshShape* trimesh, const LaneDefinition& definition, bool withPins) {
+            physics.initialize(nullptr);
+
+            btTransform identity;
+            identity.setIdentity();
+            btRigidBody* lane;
+            if (trimesh) {
+                // Chemin actuel : maillage de la piste et boîte tirée du plane du sol
+                lane = physics.addSharedShapeRigidBody(0.0f, trimesh, identity);
+                btTransform groundTransform;
+                groundTransform.setIdentity();
+                groundTransform.setOrigin(btVector3(0.0f, GROUND_HEIGHT, 0.0f));
+                physics.addPrimitiveRigidBody(0.0f, new btBoxShape(btVector3(750.0f, 0.0f, 750.0f)), groundTransform);
+                lane->setFriction(0.8f);
+                lane->setRollingFriction(0.1f);
+            } else {
+                lane = physics.addPrimitiveRigidBody(0.0f, buildAnalyticLaneShape(definition), identity);
+                physics.addPrimitiveRigidBody(
+                    0.0f, new btStaticPlaneShape(btVector3(0, 1, 0), GROUND_HEIGHT), identity);
+                lane->setFriction(definition.friction);
+                lane->setRollingFriction(definition.rollingFriction);
+            }
+
+            if (withPins) {
+                std::array<Ogre::Vector3, 10> positions = BowlingLane::computePinPositions(Ogre::Vector3::ZERO);
+                for (int i = 0; i < 10; ++i) {
+                    pins.push_back(std::make_unique<BowlingPin>(nullptr, &physics));
+                    pins.back()->create(positions[i], i + 1);
+                }
+            }
+
+            ball = std::make_unique<BowlingBall>(nullptr, "ball.mesh", &physics);
+            ball->create(Ogre::Vector3(0.0f, ball->getRadius() + 0.01f, BALL_START_Z));
+        }
+
+        ~LaneWorld() {
+            // Boule et quilles retirées avant le monde
+            ball.reset();
+            pins.clear();
+        }
+
+        void launch(const Launch& launch) {
+            Ogre::Radian angle = Ogre::Degree(launch.angleDegrees);
+            Ogre::Vector3 direction(Ogre::Math::Sin(angle), 0.0f, -Ogre::Math::Cos(angle));
+            ball->launch(direction, launch.power, launch.spin);
+        }
+
+        void step() {
+            physics.step();
+            ball->update(physics.getFixedTimeStep());
+        }
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    return ToolOptions::parsePairs(argc, argv, [&options](const std::string& key, const std::string& value) {
+        if (key == "--media") options.mediaDir = value;
+        else if (key == "--steps") options.steps = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--repeat") options.repeat = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--tolerance") options.tolerance = ToolOptions::parseValue<float>(value, 0.0f);
+        else return false;
+        return true;
+    });
+}
+
+CostResult measureCost(const Options& options, btBvhTriangleMeshShape* trimesh, const LaneDefinition& definition) {
+    CostResult result;
+    std::vector<double> narrowphase;
+    double stepTotal = 0.0;
+    int launches = 0;
+
+    for (int run = 0; run < options.repeat; ++run) {
+        for (const Launch& launch : LAUNCHES) {
+            LaneWorld world(trimesh, definition, true);
+            btDynamicsWorld* btWorld = world.physics.getDynamicsWorld()->getBtWorld();
+            btDispatcher* dispatcher = btWorld->getDispatcher();
+            world.launch(launch);
+
+            for (int step = 0; step < options.steps; ++step) {
+                auto start = std::chrono::steady_clock::now();
+                world.step();
+                auto stepped = std::chrono::steady_clock::now();
+
+                // Narrowphase rejouée sur l'état du pas : mêmes paires, mêmes formes
+                dispatcher->dispatchAllCollisionPairs(
+                    btWorld->getBroadphase()->getOverlappingPairCache(), btWorld->getDispatchInfo(), dispatcher);
+                auto dispatched = std::chrono::steady_clock::now();
+
+                stepTotal += std::chrono::duration<double, std::micro>(stepped - start).count();
+                narrowphase.push_back(std::chrono::duration<double, std::micro>(dispatched - stepped).count());
+
+                result.pairs += btWorld->getBroadphase()->getOverlappingPairCache()->getNumOverlappingPairs();
+                for (int m = 0; m < dispatcher->getNumManifolds(); ++m) {
+                    result.contacts += dispatcher->getManifoldByIndexInternal(m)->getNumContacts();
+                }
+            }
+
+            for (const auto& pin : world.pins) {
+                if (pin->isKnockedDown()) result.pinsDown += 1.0;
+            }
+            ++launches;
+        }
+    }
+
+    double samples = static_cast<double>(narrowphase.size());
+    for (double value : narrowphase) result.narrowphaseUs += value;
+    result.narrowphaseUs /= samples;
+    result.stepUs = stepTotal / samples;
+    result.pairs /= samples;
+    result.contacts /= samples;
+    std::sort(narrowphase.begin(), narrowphase.end());
+    result.narrowphaseP95Us = narrowphase[std::min(narrowphase.size() - 1, narrowphase.size() * 95 / 100)];
+    result.pinsDown /= launches;
+    return result;
+}
+
+std::vector<btVector3> recordTrajectory(const Options& options, btBvhTriangleMeshShape* trimesh,
+                                        const LaneDefinition& definition, const Launch& launch) {
+    LaneWorld world(trimesh, definition, false);
+    world.launch(launch);
+
+    std::vector<btVector3> positions;
+    positions.reserve(options.steps);
+    for (int step = 0; step < options.steps; ++step) {
+        world.step();
+        positions.push_back(world.ball->getBallBody()->getWorldTransform().getOrigin());
+    }
+    return positions;
+}
+
+// Boule entièrement sur le plateau : ni dans une gouttière, ni au-dessus de la fosse
+bool onDeck(const btVector3& position, const LaneDefinition& definition, float radius) {
+    return std::abs(position.x() - definition.centerX) < 0.5f * definition.width - radius &&
+           position.z() > definition.deckEndZ + radius &&
+           position.z() < definition.getFoulLineZ() + definition.approachLength;
+}
+
+void printCost(const std::string& name, const CostResult& result) {
+    std::cout << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << result.stepUs << std::setw(14) << result.narrowphaseUs
+              << std::setw(14) << result.narrowphaseP95Us << std::setw(9) << result.pairs
+              << std::setw(11) << result.contacts << std::setw(11) << result.pinsDown << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Options invalides (voir l'en-tête de tools/LaneColliderBench.cpp)" << std::endl;
+        return 1;
+    }
+
+    // Ogre sans système de rendu : tampons en mémoire système pour lire le mesh de la piste
+    Ogre::Root root("", "", "BowlingLaneColliderBench.log");
+    Ogre::LogManager::getSingleton().getDefaultLog()->setMinLogLevel(Ogre::LML_WARNING);
+    Ogre::DefaultHardwareBufferManager bufferManager;
+    Ogre::ResourceGroupManager::getSingleton().addResourceLocation(options.mediaDir + "/models/laneMesh", "FileSystem");
+    Ogre::ResourceGroupManager::getSingleton().initialiseAllResourceGroups();
+    Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().load("polygon8.mesh", Ogre::RGN_DEFAULT);
+
+    // La forme triangulaire vit dans ce cache, partagée par tous les mondes du banc
+    BvhCache bvhCache;
+    btBvhTriangleMeshShape* trimesh = bvhCache.getTriangleMeshShape(mesh, Ogre::Vector3(LANE_SCALE, LANE_SCALE, LANE_SCALE));
+    if (!trimesh) {
+        std::cerr << "polygon8.mesh : forme triangulaire indisponible" << std::endl;
+        return 1;
+    }
+    const LaneDefinition definition;
+    {
+        std::unique_ptr<btCompoundShape, ShapeDeleter> analytic(buildAnalyticLaneShape(definition));
+        std::cout << "polygon8.mesh : " << trimesh->getMeshInterface()->getNumSubParts() << " sous-parties, "
+                  << "piste analytique : " << analytic->getNumChildShapes() << " boîtes" << std::endl;
+    }
+
+    std::cout << std::endl << "Coût des contacts (" << LAUNCHES.size() * options.repeat << " lancers x "
+              << options.steps << " pas, boule + 10 quilles)" << std::endl;
+    std::cout << std::left << std::setw(12) << "lane" << std::right << std::setw(12) << "step_us"
+              << std::setw(14) << "narrow_us" << std::setw(14) << "narrow_p95" << std::setw(9) << "pairs"
+              << std::setw(11) << "contacts" << std::setw(11) << "pins_down" << std::endl;
+    CostResult meshCost = measureCost(options, trimesh, definition);
+    CostResult analyticCost = measureCost(options, nullptr, definition);
+    printCost("trimesh", meshCost);
+    printCost("analytic", analyticCost);
+    if (analyticCost.narrowphaseUs > 0.0) {
+        std::cout << "narrowphase x" << std::setprecision(2) << meshCost.narrowphaseUs / analyticCost.narrowphaseUs
+                  << ", pas x" << meshCost.stepUs / analyticCost.stepUs << std::endl;
+    }
+
+    std::cout << std::endl << "Équivalence des trajectoires (boule seule, sur le plateau, tolérance "
+              << std::setprecision(3) << options.tolerance << " m)" << std::endl;
+    std::cout << std::left << std::setw(24) << "launch" << std::right << std::setw(10) << "steps"
+              << std::setw(14) << "max_dev_m" << std::setw(14) << "first_over" << std::setw(8) << "ok" << std::endl;
+
+    bool allEquivalent = true;
+    const float radius = 0.108f;
+    for (const Launch& launch : LAUNCHES) {
+        std::vector<btVector3> meshPath = recordTrajectory(options, trimesh, definition, launch);
+        std::vector<btVector3> analyticPath = recordTrajectory(options, nullptr, definition, launch);
+
+        int compared = 0;
+        int firstOver = -1;
+        float maxDeviation = 0.0f;
+        for (int step = 0; step < options.steps; ++step) {
+            if (!onDeck(meshPath[step], definition, radius) || !onDeck(analyticPath[step], definition, radius)) {
+                break;
+            }
+            float deviation = meshPath[step].distance(analyticPath[step]);
+            maxDeviation = std::max(maxDeviation, deviation);
+            if (firstOver < 0 && deviation > options.tolerance) firstOver = step;
+            ++compared;
+        }
+        bool equivalent = firstOver < 0;
+        allEquivalent = allEquivalent && equivalent;
+
+        std::string name = std::to_string(launch.angleDegrees).substr(0, 4) + "deg p" +
+                           std::to_string(static_cast<int>(launch.power)) + " s" +
+                           std::to_string(launch.spin).substr(0, 4);
+        std::cout << std::left << std::setw(24) << name << std::right << std::setw(10) << compared
+                  << std::setw(14) << std::setprecision(4) << maxDeviation << std::setw(14) << firstOver
+                  << std::setw(8) << (equivalent ? "oui" : "non") << std::endl;
+    }
+
+    // Les tampons du mesh doivent être libérés avant le gestionnaire de tampons
+    mesh.reset();
+    Ogre::MeshManager::getSingleton().removeAll();
+    return allEquivalent ? 0 : 2;
+}
@@ -0,0 +1,154 @@
+// Banc des pistes simultanées : N sessions (LaneSession) hébergées par un LaneHost, chacune
+// avec son monde physique, jouant des parties en continu (lancers tirés au hasard). Chaque
+// mise à jour avance toutes les pistes du même nombre de pas sur le pool de threads ; une
+// piste dont le lancer s'achève relance aussitôt, sans attendre la mise à jour suivante.
+// Débit mesuré en pas de piste par seconde, comparé à une seule piste.
+//
+// Usage : BowlingLaneBench [options]
+//   --lanes 1,2,4,8,16   nombres de pistes mesurés (défaut 1,2,4,8,16)
+//   --threads N          threads au plus (défaut : nombre de cœurs)
+//   --steps N            pas par mise à jour (défaut 2 : une frame à 60 images/s à 120 Hz)
+//   --updates N          mises à jour mesurées (défaut 3000)
+//   --seed s             graine (défaut 7)
+#include "core/LaneHost.h"
+#include "ToolOptions.h"
+#include <OgreLogManager.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    std::vector<int> lanes = {1, 2, 4, 8, 16};
+    unsigned int threads = 0;
+    int steps = 2;
+    int updates = 3000;
+    unsigned int seed = 7;
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    return ToolOptions::parsePairs(argc, argv, [&options](const std::string& key, const std::string& value) {
+        if (key == "--lanes") options.lanes = ToolOptions::parseList<int>(value, 1);
+        else if (key == "--threads") options.threads = ToolOptions::parseValue<unsigned int>(value);
+        else if (key == "--steps") options.steps = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--updates") options.updates = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--seed") options.seed = ToolOptions::parseValue<unsigned int>(value);
+        else return false;
+        return true;
+    }) && !options.lanes.empty();
+}
+
+struct Run {
+    double stepsPerSecond = 0.0;
+    unsigned long rolls = 0;
+    unsigned long games = 0;
+    unsigned int threads = 1;
+};
+
+// Lancer au hasard dans le couloir des lancers jouables (voir BowlingLaunchExplorer)
+void bowl(LaneSession& session, std::mt19937& rng) {
+    float radians = std::uniform_real_distribution<float>(-2.0f, 2.0f)(rng) * 3.14159265f / 180.0f;
+    float power = std::uniform_real_distribution<float>(60.0f, 100.0f)(rng);
+    float spin = std::uniform_real_distribution<float>(-0.5f, 0.5f)(rng);
+    session.launch(Ogre::Vector3(std::sin(radians), 0.0f, -std::cos(radians)), power, spin);
+}
+
+// Exactement steps pas pour la piste : nouveau lancer (ou nouvelle partie) dès que besoin
+void play(LaneSession& session, std::mt19937& rng, int steps) {
+    int left = steps;
+    while (left > 0) {
+        if (session.getState() == GameState::GAME_OVER) {
+            session.resetGame();
+        }
+        if (session.getState() == GameState::AIMING) {
+            bowl(session, rng);
+        }
+        int simulated = session.advance(left);
+        if (simulated == 0) {
+            break;      // Lancer refusé (session non initialisée)
+        }
+        left -= simulated;
+    }
+}
+
+Run measure(const Options& options, int lanes) {
+    LaneHost host(lanes, options.threads);
+    host.initialize();
+
+    // Un tirage par piste, indépendant du thread qui la fait avancer
+    std::vector<std::mt19937> rngs;
+    for (int lane = 0; lane < lanes; ++lane) {
+        rngs.emplace_back(options.seed * 2654435761u + static_cast<unsigned int>(lane));
+    }
+    LaneHost::Job job = [&](LaneSession& session) {
+        play(session, rngs[session.getLaneNumber() - 1], options.steps);
+    };
+
+    // Chauffe : premiers lancers, caches et pages des mondes
+    for (int update = 0; update < 60; ++update) {
+        host.forEachSession(job);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int update = 0; update < options.updates; ++update) {
+        host.forEachSession(job);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Run run;
+    run.stepsPerSecond = static_cast<double>(lanes) * options.steps * options.updates / seconds;
+    run.threads = host.getThreadCount();
+    for (size_t i = 0; i < host.getSessionCount(); ++i) {
+        run.rolls += host.getSession(i).getRollCount();
+        run.games += host.getSession(i).getGameCount();
+    }
+    return run;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Options invalides (voir l'en-tête de tools/LaneScalingBench.cpp)" << std::endl;
+        return 1;
+    }
+    if (options.threads == 0) {
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Pas de Ogre::Root : seul le LogManager est nécessaire (avertissements uniquement)
+    Ogre::LogManager logManager;
+    Ogre::Log* log = logManager.createLog("BowlingLaneBench.log", true, false, true);
+    log->setMinLogLevel(Ogre::LML_WARNING);
+
+    std::cout << std::right << std::setw(6) << "lanes" << std::setw(9) << "threads"
+              << std::setw(14) << "steps/s" << std::setw(9) << "rolls" << std::setw(7) << "games"
+              << std::setw(10) << "speedup" << std::setw(12) << "efficiency" << std::endl;
+
+    double single = 0.0;
+    for (int lanes : options.lanes) {
+        Run run = measure(options, lanes);
+        if (single == 0.0) {
+            // Référence : débit d'une piste seule, mesurée à part si la liste ne commence pas à 1
+            single = lanes == 1 ? run.stepsPerSecond : measure(options, 1).stepsPerSecond;
+        }
+        double speedup = run.stepsPerSecond / single;
+        std::cout << std::fixed << std::setprecision(0) << std::setw(6) << lanes << std::setw(9) << run.threads
+                  << std::setw(14) << run.stepsPerSecond << std::setw(9) << run.rolls << std::setw(7) << run.games
+                  << std::setprecision(2) << std::setw(10) << speedup
+                  << std::setw(11) << 100.0 * speedup / run.threads << "%" << std::endl;
+    }
+    std::cout << "efficacité : accélération rapportée au nombre de threads réellement utilisés" << std::endl;
+    return 0;
+}
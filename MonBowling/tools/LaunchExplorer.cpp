@@ -0,0 +1,246 @@
+// Exploration Monte Carlo des paramètres de lancer (angle de visée, puissance, spin).
+// Chaque cellule de la grille est simulée sans rendu ; les cellules sont réparties
+// sur un pool de threads, chaque thread possédant son propre monde Bullet.
+//
+// Usage : BowlingLaunchExplorer [options]
+//   --mode grid|random     grid : un lancer au centre de chaque cellule (défaut)
+//                          random : --samples tirages uniformes dans chaque cellule
+//   --samples N            tirages par cellule en mode random (défaut 32)
+//   --aim min:max:n        angle de visée en degrés (défaut -3:3:13)
+//   --power min:max:n      puissance (défaut 40:100:7)
+//   --spin min:max:n       spin (défaut -1:1:9)
+//   --threads N            nombre de threads (défaut : nombre de cœurs)
+//   --seed N               graine du tirage (défaut 1)
+//   --csv fichier          tableau de synthèse (défaut launch_explorer.csv)
+//   --bin fichier          histogramme complet des quilles restantes (optionnel)
+#include "core/BowlingSimulation.h"
+#include "managers/PhysicsManager.h"
+#include "ToolOptions.h"
+#include <OgreLogManager.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int PIN_COUNT = 10;
+const int LEAVE_COUNT = 1 << PIN_COUNT;   // Toutes les combinaisons de quilles restantes
+const int ALL_PINS_MASK = LEAVE_COUNT - 1;
+
+// Axe de paramètres : [min, max] découpé en count cellules
+struct Axis {
+    float min;
+    float max;
+    int count;
+
+    float cellWidth() const { return (count > 1) ? (max - min) / (count - 1) : 0.0f; }
+    float center(int i) const { return min + i * cellWidth(); }
+};
+
+struct CellResult {
+    uint32_t samples = 0;
+    uint32_t strikes = 0;
+    uint64_t pinsDown = 0;
+    // leaves[m] : nombre de lancers laissant exactement les quilles du masque m debout
+    std::array<uint32_t, LEAVE_COUNT> leaves{};
+};
+
+struct Options {
+    bool randomMode = false;
+    int samples = 32;
+    Axis aim{-3.0f, 3.0f, 13};
+    Axis power{40.0f, 100.0f, 7};
+    Axis spin{-1.0f, 1.0f, 9};
+    unsigned int threads = 0;
+    unsigned int seed = 1;
+    std::string csvPath = "launch_explorer.csv";
+    std::string binPath;
+};
+
+bool parseAxis(const std::string& text, Axis& axis) {
+    size_t first = text.find(':');
+    size_t second = text.find(':', first + 1);
+    if (first == std::string::npos || second == std::string::npos) return false;
+    axis.min = std::stof(text.substr(0, first));
+    axis.max = std::stof(text.substr(first + 1, second - first - 1));
+    axis.count = std::max(1, std::atoi(text.substr(second + 1).c_str()));
+    return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    return ToolOptions::parsePairs(argc, argv, [&options](const std::string& key, const std::string& value) {
+        if (key == "--mode") options.randomMode = (value == "random");
+        else if (key == "--samples") options.samples = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--aim") { if (!parseAxis(value, options.aim)) return false; }
+        else if (key == "--power") { if (!parseAxis(value, options.power)) return false; }
+        else if (key == "--spin") { if (!parseAxis(value, options.spin)) return false; }
+        else if (key == "--threads") options.threads = ToolOptions::parseValue<unsigned int>(value);
+        else if (key == "--seed") options.seed = ToolOptions::parseValue<unsigned int>(value);
+        else if (key == "--csv") options.csvPath = value;
+        else if (key == "--bin") options.binPath = value;
+        else return false;
+        return true;
+    });
+}
+
+Ogre::Vector3 aimDirection(float degrees) {
+    float radians = degrees * 3.14159265f / 180.0f;
+    return Ogre::Vector3(std::sin(radians), 0.0f, -std::cos(radians));
+}
+
+// Un thread = un monde physique, une piste et une boule, réutilisés pour toutes ses cellules
+void worker(const Options& options, std::atomic<int>& nextCell, std::vector<CellResult>& results) {
+    PhysicsManager physics;
+    BowlingSimulation simulation(&physics);
+    simulation.initialize();
+
+    const int cellCount = static_cast<int>(results.size());
+    const int samplesPerCell = options.randomMode ? options.samples : 1;
+
+    for (int cell = nextCell++; cell < cellCount; cell = nextCell++) {
+        int aimIndex = cell / (options.power.count * options.spin.count);
+        int powerIndex = (cell / options.spin.count) % options.power.count;
+        int spinIndex = cell % options.spin.count;
+
+        // Graine dépendant uniquement de la cellule : résultat indépendant de l'ordonnancement
+        std::mt19937 rng(options.seed * 2654435761u + static_cast<unsigned int>(cell));
+        std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+
+        CellResult& result = results[cell];
+        for (int sample = 0; sample < samplesPerCell; ++sample) {
+            float aim = options.aim.center(aimIndex);
+            float power = options.power.center(powerIndex);
+            float spin = options.spin.center(spinIndex);
+            if (options.randomMode) {
+                aim += jitter(rng) * options.aim.cellWidth();
+                power += jitter(rng) * options.power.cellWidth();
+                spin += jitter(rng) * options.spin.cellWidth();
+            }
+
+            simulation.resetRack();
+            int knocked = simulation.throwBall(aimDirection(aim), power, spin);
+            int standing = ALL_PINS_MASK & ~knocked;
+
+            result.samples++;
+            result.leaves[standing]++;
+            if (standing == 0) result.strikes++;
+            for (int pin = 0; pin < PIN_COUNT; ++pin) {
+                if (knocked & (1 << pin)) result.pinsDown++;
+            }
+        }
+    }
+}
+
+void writeCsv(const Options& options, const std::vector<CellResult>& results) {
+    std::ofstream out(options.csvPath);
+    out << "aim_deg,power,spin,samples,strike_prob,mean_pins";
+    for (int pin = 1; pin <= PIN_COUNT; ++pin) out << ",leave_p" << pin;
+    out << ",top_leave_mask,top_leave_freq\n";
+
+    for (size_t cell = 0; cell < results.size(); ++cell) {
+        const CellResult& result = results[cell];
+        int aimIndex = static_cast<int>(cell) / (options.power.count * options.spin.count);
+        int powerIndex = (static_cast<int>(cell) / options.spin.count) % options.power.count;
+        int spinIndex = static_cast<int>(cell) % options.spin.count;
+        double samples = result.samples > 0 ? result.samples : 1.0;
+
+        // Fréquence à laquelle chaque quille reste debout
+        std::array<uint32_t, PIN_COUNT> standingCount{};
+        int topLeave = 0;
+        for (int mask = 0; mask < LEAVE_COUNT; ++mask) {
+            for (int pin = 0; pin < PIN_COUNT; ++pin) {
+                if (mask & (1 << pin)) standingCount[pin] += result.leaves[mask];
+            }
+            if (result.leaves[mask] > result.leaves[topLeave]) topLeave = mask;
+        }
+
+        out << options.aim.center(aimIndex) << ',' << options.power.center(powerIndex) << ','
+            << options.spin.center(spinIndex) << ',' << result.samples << ','
+            << result.strikes / samples << ',' << result.pinsDown / samples;
+        for (int pin = 0; pin < PIN_COUNT; ++pin) out << ',' << standingCount[pin] / samples;
+        out << ',' << topLeave << ',' << result.leaves[topLeave] / samples << '\n';
+    }
+}
+
+// Format binaire : en-tête "MBLX", version, dimensions des axes, puis pour chaque cellule
+// (aim, power, spin, samples, leaves[1024]) en little-endian natif.
+void writeBinary(const Options& options, const std::vector<CellResult>& results) {
+    std::ofstream out(options.binPath, std::ios::binary);
+    const char magic[4] = {'M', 'B', 'L', 'X'};
+    const uint32_t version = 1;
+    out.write(magic, sizeof(magic));
+    out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    for (const Axis* axis : {&options.aim, &options.power, &options.spin}) {
+        out.write(reinterpret_cast<const char*>(&axis->min), sizeof(float));
+        out.write(reinterpret_cast<const char*>(&axis->max), sizeof(float));
+        int32_t count = axis->count;
+        out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+    for (size_t cell = 0; cell < results.size(); ++cell) {
+        int aimIndex = static_cast<int>(cell) / (options.power.count * options.spin.count);
+        int powerIndex = (static_cast<int>(cell) / options.spin.count) % options.power.count;
+        int spinIndex = static_cast<int>(cell) % options.spin.count;
+        float params[3] = {options.aim.center(aimIndex), options.power.center(powerIndex),
+                           options.spin.center(spinIndex)};
+        out.write(reinterpret_cast<const char*>(params), sizeof(params));
+        out.write(reinterpret_cast<const char*>(&results[cell].samples), sizeof(uint32_t));
+        out.write(reinterpret_cast<const char*>(results[cell].leaves.data()),
+                  sizeof(uint32_t) * LEAVE_COUNT);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Options invalides (voir l'en-tête de tools/LaunchExplorer.cpp)" << std::endl;
+        return 1;
+    }
+    if (options.threads == 0) {
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Pas de Ogre::Root : seul le LogManager est nécessaire (avertissements uniquement)
+    Ogre::LogManager logManager;
+    Ogre::Log* log = logManager.createLog("BowlingLaunchExplorer.log", true, false, true);
+    log->setMinLogLevel(Ogre::LML_WARNING);
+
+    const int cellCount = options.aim.count * options.power.count * options.spin.count;
+    std::vector<CellResult> results(cellCount);
+    std::atomic<int> nextCell(0);
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> pool;
+    for (unsigned int i = 0; i < options.threads; ++i) {
+        pool.emplace_back(worker, std::cref(options), std::ref(nextCell), std::ref(results));
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t rolls = 0;
+    for (const auto& result : results) rolls += result.samples;
+
+    writeCsv(options, results);
+    if (!options.binPath.empty()) {
+        writeBinary(options, results);
+    }
+
+    std::cout << cellCount << " cellules, " << rolls << " lancers, " << options.threads << " threads, "
+              << seconds << " s (" << (seconds > 0.0 ? rolls / seconds : 0.0) << " lancers/s)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,214 @@
+// Banc d'essai du pas physique : compare le monde Bullet monothread au monde
+// multithread (btDiscreteDynamicsWorldMt) sur deux scènes sans rendu.
+//   rack   : la boule lancée dans le jeu de 10 quilles (scène du jeu)
+//   stress : une grille de piles de cubes (ObjectFactory::createStack) percutée par des sphères
+//
+// Usage : BowlingPhysicsBench [options]
+//   --scene rack|stress|all   scène mesurée (défaut all)
+//   --threads 1,2,4,8         nombres de threads du monde multithread (défaut 2,4,<cœurs>)
+//   --scheduler default|sequential|openmp|tbb|ppl
+//   --steps N                 pas mesurés par répétition (défaut 600)
+//   --repeat N                répétitions (défaut 5)
+//   --stacks N                côté de la grille de piles (défaut 10, soit 100 piles)
+//   --height N                cubes par pile (défaut 5)
+//   --oil fichier             motif d'huilage de la piste (scène rack ; friction lue à chaque pas)
+#include "core/BowlingSimulation.h"
+#include "managers/PhysicsManager.h"
+#include "objects/ObjectFactory.h"
+#include "ToolOptions.h"
+#include <OgreLogManager.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    bool rack = true;
+    bool stress = true;
+    std::vector<int> threads;
+    PhysicsManager::TaskScheduler scheduler = PhysicsManager::SCHEDULER_DEFAULT;
+    int steps = 600;
+    int repeat = 5;
+    int stacks = 10;
+    int height = 5;
+    std::string oil;
+};
+
+struct Timing {
+    double meanUs = 0.0;
+    double p95Us = 0.0;
+    int bodies = 0;
+    int threads = 1;
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    return ToolOptions::parsePairs(argc, argv, [&options](const std::string& key, const std::string& value) {
+        if (key == "--scene") {
+            options.rack = (value == "rack" || value == "all");
+            options.stress = (value == "stress" || value == "all");
+        }
+        else if (key == "--threads") options.threads = ToolOptions::parseList<int>(value, 1);
+        else if (key == "--scheduler") {
+            if (value == "sequential") options.scheduler = PhysicsManager::SCHEDULER_SEQUENTIAL;
+            else if (value == "openmp") options.scheduler = PhysicsManager::SCHEDULER_OPENMP;
+            else if (value == "tbb") options.scheduler = PhysicsManager::SCHEDULER_TBB;
+            else if (value == "ppl") options.scheduler = PhysicsManager::SCHEDULER_PPL;
+            else options.scheduler = PhysicsManager::SCHEDULER_DEFAULT;
+        }
+        else if (key == "--steps") options.steps = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--repeat") options.repeat = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--stacks") options.stacks = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--height") options.height = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--oil") options.oil = value;
+        else return false;
+        return true;
+    });
+}
+
+// threads == 0 : monde monothread actuel
+void configure(PhysicsManager& physics, const Options& options, int threads) {
+    if (threads > 0) {
+        physics.setTaskScheduler(options.scheduler);
+        physics.setMultithreaded(true, threads);
+    }
+}
+
+Timing summarize(std::vector<double>& samples) {
+    Timing timing;
+    if (samples.empty()) return timing;
+    double total = 0.0;
+    for (double sample : samples) total += sample;
+    timing.meanUs = total / samples.size();
+    std::sort(samples.begin(), samples.end());
+    timing.p95Us = samples[std::min(samples.size() - 1, samples.size() * 95 / 100)];
+    return timing;
+}
+
+// Mesure chaque pas séparément : le coût varie beaucoup entre le roulement et l'impact
+template <typename StepFunction>
+void measureSteps(int steps, std::vector<double>& samples, StepFunction stepOnce) {
+    for (int i = 0; i < steps; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        stepOnce();
+        samples.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+}
+
+Timing benchRack(const Options& options, int threads) {
+    PhysicsManager physics;
+    configure(physics, options, threads);
+    BowlingSimulation simulation(&physics);
+    simulation.initialize();
+    if (!options.oil.empty() && !simulation.getLane()->loadOilPattern(options.oil)) {
+        std::cerr << "Motif d'huilage illisible : " << options.oil << std::endl;
+    }
+
+    std::vector<double> samples;
+    for (int run = 0; run < options.repeat; ++run) {
+        simulation.resetRack();
+        BowlingBall* ball = simulation.getBall();
+        ball->launch(Ogre::Vector3(0.0f, 0.0f, -1.0f), MAX_POWER * 0.8f, 0.3f);
+        measureSteps(options.steps, samples, [&]() {
+            physics.step();
+            ball->update(physics.getFixedTimeStep());
+        });
+    }
+
+    Timing timing = summarize(samples);
+    timing.bodies = physics.getDynamicsWorld()->getBtWorld()->getNumCollisionObjects();
+    timing.threads = physics.getThreadCount();
+    return timing;
+}
+
+Timing benchStress(const Options& options, int threads) {
+    std::vector<double> samples;
+    Timing timing;
+
+    // Scène reconstruite à chaque répétition : les piles effondrées finissent par s'endormir
+    for (int run = 0; run < options.repeat; ++run) {
+        PhysicsManager physics;
+        configure(physics, options, threads);
+        physics.initialize(nullptr);
+
+        ObjectFactory factory(nullptr, &physics);
+        factory.createStaticGround();
+
+        const float spacing = 2.0f;
+        for (int x = 0; x < options.stacks; ++x) {
+            for (int z = 0; z < options.stacks; ++z) {
+                factory.createStack(options.height, Ogre::Vector3(x * spacing, 0.0f, z * spacing));
+            }
+        }
+
+        // Une sphère lourde par rangée, lancée à travers la grille
+        for (int z = 0; z < options.stacks; ++z) {
+            Ogre::String name = "Bowler" + Ogre::StringConverter::toString(z);
+            btRigidBody* sphere = factory.createDynamicSphere(Ogre::Vector3(-3.0f, 0.5f, z * spacing), name, 20.0f);
+            sphere->setLinearVelocity(btVector3(12.0f, 0.0f, 0.0f));
+        }
+
+        measureSteps(options.steps, samples, [&]() { physics.step(); });
+
+        timing.bodies = physics.getDynamicsWorld()->getBtWorld()->getNumCollisionObjects();
+        timing.threads = physics.getThreadCount();
+    }
+
+    Timing summary = summarize(samples);
+    summary.bodies = timing.bodies;
+    summary.threads = timing.threads;
+    return summary;
+}
+
+void printRow(const std::string& scene, const std::string& world, const Timing& timing, double baselineUs) {
+    std::cout << std::left << std::setw(8) << scene << std::setw(8) << world
+              << std::right << std::setw(8) << timing.bodies << std::setw(9) << timing.threads
+              << std::fixed << std::setprecision(1)
+              << std::setw(12) << timing.meanUs << std::setw(12) << timing.p95Us
+              << std::setprecision(2) << std::setw(10) << (timing.meanUs > 0.0 ? baselineUs / timing.meanUs : 0.0)
+              << std::endl;
+}
+
+template <typename Bench>
+void runScene(const std::string& scene, const Options& options, Bench bench) {
+    Timing baseline = bench(options, 0);
+    printRow(scene, "st", baseline, baseline.meanUs);
+    for (int threads : options.threads) {
+        printRow(scene, "mt", bench(options, threads), baseline.meanUs);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Options invalides (voir l'en-tête de tools/PhysicsBench.cpp)" << std::endl;
+        return 1;
+    }
+    if (options.threads.empty()) {
+        int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        options.threads = {2, 4};
+        if (cores > 4) options.threads.push_back(cores);
+    }
+
+    // Pas de Ogre::Root : seul le LogManager est nécessaire (avertissements uniquement)
+    Ogre::LogManager logManager;
+    Ogre::Log* log = logManager.createLog("BowlingPhysicsBench.log", true, false, true);
+    log->setMinLogLevel(Ogre::LML_WARNING);
+
+    std::cout << std::left << std::setw(8) << "scene" << std::setw(8) << "world"
+              << std::right << std::setw(8) << "bodies" << std::setw(9) << "threads"
+              << std::setw(12) << "mean_us" << std::setw(12) << "p95_us" << std::setw(10) << "speedup" << std::endl;
+
+    if (options.rack) runScene("rack", options, benchRack);
+    if (options.stress) runScene("stress", options, benchStress);
+    return 0;
+}
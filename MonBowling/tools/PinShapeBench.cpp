@@ -0,0 +1,216 @@
+// Banc d'essai des formes de collision des quilles : une enveloppe complète par quille
+// (ancien CT_HULL) contre les formes partagées du ShapeCache (enveloppe complète,
+// enveloppe réduite à un budget de sommets, cylindres empilés).
+// Mesure le temps de détection de collision (narrowphase) par pas et la mémoire des formes.
+//
+// Usage : BowlingPinShapeBench [options]
+//   --media dossier       dossier media du projet (défaut ../media)
+//   --steps N             pas simulés par lancer (défaut 480)
+//   --repeat N            lancers par variante (défaut 5)
+//   --budgets 16,32,64    budgets de sommets des enveloppes réduites
+//   --segments 2,4,6      nombres de cylindres empilés
+#include "managers/PhysicsManager.h"
+#include "managers/ShapeCache.h"
+#include "objects/BowlingLane.h"
+#include "ToolOptions.h"
+#include <OgreDefaultHardwareBufferManager.h>
+#include <OgreRoot.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int PIN_COUNT = 10;
+const float PIN_MASS = 1.5f;
+const float BALL_RADIUS = 0.108f;
+const float BALL_MASS = 7.0f;
+const float BALL_SPEED = 8.0f;
+const Ogre::Vector3 BALL_START(0.0f, BALL_RADIUS + 0.01f, 7.0f);
+
+struct Options {
+    std::string mediaDir = "../media";
+    int steps = 480;
+    int repeat = 5;
+    std::vector<int> budgets = {16, 32, 64};
+    std::vector<int> segments = {2, 4, 6};
+};
+
+struct Variant {
+    std::string name;
+    bool shared;
+    std::function<btCollisionShape*()> build;
+};
+
+struct Result {
+    size_t memory = 0;
+    int complexity = 0;     // sommets de l'enveloppe ou nombre de cylindres
+    double stepUs = 0.0;
+    double narrowphaseUs = 0.0;
+    double narrowphaseP95Us = 0.0;
+    double pinsDown = 0.0;
+};
+
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    return ToolOptions::parsePairs(argc, argv, [&options](const std::string& key, const std::string& value) {
+        if (key == "--media") options.mediaDir = value;
+        else if (key == "--steps") options.steps = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--repeat") options.repeat = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--budgets") options.budgets = ToolOptions::parseList<int>(value, 1);
+        else if (key == "--segments") options.segments = ToolOptions::parseList<int>(value, 1);
+        else return false;
+        return true;
+    });
+}
+
+int shapeComplexity(const btCollisionShape* shape) {
+    if (shape->getShapeType() == CONVEX_HULL_SHAPE_PROXYTYPE) {
+        return static_cast<const btConvexHullShape*>(shape)->getNumPoints();
+    }
+    if (shape->isCompound()) {
+        return static_cast<const btCompoundShape*>(shape)->getNumChildShapes();
+    }
+    return 1;
+}
+
+Result runVariant(const Options& options, const Variant& variant) {
+    Result result;
+    std::vector<double> narrowphase;
+    double stepTotal = 0.0;
+
+    for (int run = 0; run < options.repeat; ++run) {
+        PhysicsManager physics;
+        physics.initialize(nullptr);
+        btDynamicsWorld* world = physics.getDynamicsWorld()->getBtWorld();
+
+        btTransform groundTransform;
+        groundTransform.setIdentity();
+        groundTransform.setOrigin(btVector3(0.0f, -0.25f, 0.0f));
+        btRigidBody* ground = physics.addPrimitiveRigidBody(0.0f, new btBoxShape(btVector3(5.0f, 0.25f, 20.0f)), groundTransform);
+        ground->setFriction(0.8f);
+
+        std::array<Ogre::Vector3, PIN_COUNT> positions = BowlingLane::computePinPositions(BALL_START);
+        std::vector<btRigidBody*> pins;
+        btCollisionShape* sharedShape = variant.shared ? physics.getShapeCache().addShape(variant.name, variant.build()) : nullptr;
+
+        result.memory = 0;
+        for (int i = 0; i < PIN_COUNT; ++i) {
+            btTransform transform;
+            transform.setIdentity();
+            transform.setOrigin(btVector3(positions[i].x, positions[i].y, positions[i].z));
+
+            btRigidBody* pin;
+            if (variant.shared) {
+                pin = physics.addSharedShapeRigidBody(PIN_MASS, sharedShape, transform);
+            } else {
+                btCollisionShape* shape = variant.build();
+                result.memory += ShapeCache::estimateMemory(shape);
+                pin = physics.addPrimitiveRigidBody(PIN_MASS, shape, transform);
+            }
+            pin->setFriction(0.6f);
+            pin->setRestitution(0.3f);
+            pins.push_back(pin);
+        }
+        if (variant.shared) {
+            result.memory = ShapeCache::estimateMemory(sharedShape);
+        }
+        result.complexity = shapeComplexity(pins[0]->getCollisionShape());
+
+        btTransform ballTransform;
+        ballTransform.setIdentity();
+        ballTransform.setOrigin(btVector3(BALL_START.x + 0.02f * run, BALL_START.y, BALL_START.z));
+        btRigidBody* ball = physics.addPrimitiveRigidBody(BALL_MASS, new btSphereShape(BALL_RADIUS), ballTransform);
+        ball->setLinearVelocity(btVector3(0.0f, 0.0f, -BALL_SPEED));
+        ball->setActivationState(DISABLE_DEACTIVATION);
+
+        for (int step = 0; step < options.steps; ++step) {
+            auto start = std::chrono::steady_clock::now();
+            physics.step();
+            auto stepped = std::chrono::steady_clock::now();
+
+            // Narrowphase rejouée sur l'état du pas : mêmes paires, mêmes formes
+            world->getDispatcher()->dispatchAllCollisionPairs(
+                world->getBroadphase()->getOverlappingPairCache(), world->getDispatchInfo(), world->getDispatcher());
+            auto dispatched = std::chrono::steady_clock::now();
+
+            stepTotal += std::chrono::duration<double, std::micro>(stepped - start).count();
+            narrowphase.push_back(std::chrono::duration<double, std::micro>(dispatched - stepped).count());
+        }
+
+        for (btRigidBody* pin : pins) {
+            if (pin->getWorldTransform().getBasis().getColumn(1).y() < 0.7071f) result.pinsDown += 1.0;
+        }
+    }
+
+    double samples = static_cast<double>(narrowphase.size());
+    for (double value : narrowphase) result.narrowphaseUs += value;
+    result.narrowphaseUs /= samples;
+    result.stepUs = stepTotal / samples;
+    std::sort(narrowphase.begin(), narrowphase.end());
+    result.narrowphaseP95Us = narrowphase[std::min(narrowphase.size() - 1, narrowphase.size() * 95 / 100)];
+    result.pinsDown /= options.repeat;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Options invalides (voir l'en-tête de tools/PinShapeBench.cpp)" << std::endl;
+        return 1;
+    }
+
+    // Ogre sans système de rendu : tampons en mémoire système pour lire pin.mesh
+    Ogre::Root root("", "", "BowlingPinShapeBench.log");
+    Ogre::LogManager::getSingleton().getDefaultLog()->setMinLogLevel(Ogre::LML_WARNING);
+    Ogre::DefaultHardwareBufferManager bufferManager;
+    Ogre::ResourceGroupManager::getSingleton().addResourceLocation(options.mediaDir + "/models/pinMesh", "FileSystem");
+    Ogre::ResourceGroupManager::getSingleton().initialiseAllResourceGroups();
+    Ogre::MeshPtr mesh = Ogre::MeshManager::getSingleton().load("pin.mesh", Ogre::RGN_DEFAULT);
+
+    const std::vector<btVector3> vertices = ShapeCache::collectVertices(mesh, Ogre::Vector3::UNIT_SCALE);
+    std::cout << "pin.mesh : " << vertices.size() << " sommets" << std::endl;
+
+    std::vector<Variant> variants;
+    variants.push_back({"hull_per_pin", false, [&]() { return ShapeCache::buildHull(vertices); }});
+    variants.push_back({"hull_shared", true, [&]() {
+        btConvexHullShape* hull = ShapeCache::buildHull(vertices);
+        hull->optimizeConvexHull();
+        return hull;
+    }});
+    for (int budget : options.budgets) {
+        variants.push_back({"hull_" + std::to_string(budget), true,
+                            [&, budget]() { return ShapeCache::buildReducedHull(vertices, budget); }});
+    }
+    for (int segments : options.segments) {
+        variants.push_back({"cylinders_" + std::to_string(segments), true,
+                            [&, segments]() { return ShapeCache::buildCylinderStack(vertices, segments); }});
+    }
+
+    std::cout << std::left << std::setw(16) << "variant" << std::right << std::setw(10) << "verts/cyl"
+              << std::setw(12) << "bytes" << std::setw(12) << "step_us" << std::setw(14) << "narrow_us"
+              << std::setw(14) << "narrow_p95" << std::setw(11) << "pins_down" << std::endl;
+
+    for (const Variant& variant : variants) {
+        Result result = runVariant(options, variant);
+        std::cout << std::left << std::setw(16) << variant.name << std::right
+                  << std::setw(10) << result.complexity << std::setw(12) << result.memory
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(12) << result.stepUs << std::setw(14) << result.narrowphaseUs
+                  << std::setw(14) << result.narrowphaseP95Us << std::setw(11) << result.pinsDown << std::endl;
+    }
+
+    // Les tampons du mesh doivent être libérés avant le gestionnaire de tampons
+    mesh.reset();
+    Ogre::MeshManager::getSingleton().removeAll();
+    return 0;
+}
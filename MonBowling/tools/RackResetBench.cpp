@@ -0,0 +1,164 @@
+// Banc du relevage des quilles : N pistes côte à côte dans un même monde, chaque boule
+// lancée dans son jeu de quilles, puis toutes les pistes relevées en même temps.
+// Compare le relevage quille par quille (BowlingPin::reset) au relevage en une passe
+// (BowlingLane::resetPins) : coût par piste, manifolds de l'ancien jeu encore présents
+// après le relevage, et quilles debout une seconde plus tard.
+//
+// Usage : BowlingRackResetBench [options]
+//   --lanes 1,4,16,64      nombres de pistes (défaut 1,4,16,64)
+//   --repeat N             relevages mesurés par configuration (défaut 5)
+//   --time s               temps simulé après le lancer, avant le relevage (défaut 2)
+#include "managers/PhysicsManager.h"
+#include "objects/BowlingBall.h"
+#include "objects/BowlingLane.h"
+#include "ToolOptions.h"
+#include <OgreLogManager.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const float BALL_START_Z = 7.0f;
+// Écart entre deux pistes voisines (plus large que la piste et ses kickbacks)
+const float LANE_SPACING = 3.0f;
+
+struct Options {
+    std::vector<int> lanes = {1, 4, 16, 64};
+    int repeat = 5;
+    float time = 2.0f;
+};
+
+struct Result {
+    double resetUsPerLane = 0.0;
+    double staleManifolds = 0.0;
+    double standingPins = 0.0;
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    return ToolOptions::parsePairs(argc, argv, [&options](const std::string& key, const std::string& value) {
+        if (key == "--lanes") options.lanes = ToolOptions::parseList<int>(value, 1);
+        else if (key == "--repeat") options.repeat = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--time") options.time = ToolOptions::parseValue<float>(value, 0.1f);
+        else return false;
+        return true;
+    });
+}
+
+struct Lane {
+    std::unique_ptr<BowlingLane> lane;
+    std::unique_ptr<BowlingBall> ball;
+};
+
+// Manifolds avec des points de contact qui touchent une quille
+int countPinManifolds(btDispatcher* dispatcher) {
+    int count = 0;
+    for (int m = 0; m < dispatcher->getNumManifolds(); ++m) {
+        const btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(m);
+        if (manifold->getNumContacts() > 0 &&
+            (PhysicsManager::getBodyRole(manifold->getBody0()) == BodyRole::PIN ||
+             PhysicsManager::getBodyRole(manifold->getBody1()) == BodyRole::PIN)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+Result run(int laneCount, bool batched, const Options& options) {
+    PhysicsManager physics;
+    physics.initialize(nullptr);
+    btDispatcher* dispatcher = physics.getDynamicsWorld()->getBtWorld()->getDispatcher();
+
+    std::vector<Lane> lanes(laneCount);
+    for (int i = 0; i < laneCount; ++i) {
+        float x = i * LANE_SPACING;
+        LaneDefinition definition;
+        definition.centerX = x;
+        lanes[i].lane = std::make_unique<BowlingLane>(nullptr, &physics);
+        lanes[i].lane->setLaneDefinition(definition);
+        lanes[i].lane->create(Ogre::Vector3(x, 0.0f, 0.0f));
+        lanes[i].ball = std::make_unique<BowlingBall>(nullptr, "ball.mesh", &physics);
+        lanes[i].ball->create(Ogre::Vector3(x, lanes[i].ball->getRadius() + 0.01f, BALL_START_Z));
+    }
+
+    const float dt = physics.getFixedTimeStep();
+    const int throwSteps = static_cast<int>(options.time / dt);
+    const int settleSteps = static_cast<int>(1.0f / dt);
+
+    Result result;
+    for (int rep = 0; rep < options.repeat; ++rep) {
+        // Chaque piste abat son jeu de quilles
+        for (Lane& lane : lanes) {
+            lane.ball->reset();
+            lane.ball->launch(Ogre::Vector3(0.0f, 0.0f, -1.0f), 25.0f);
+        }
+        for (int step = 0; step < throwSteps; ++step) {
+            physics.step();
+            for (Lane& lane : lanes) lane.ball->update(dt);
+        }
+        for (Lane& lane : lanes) lane.ball->reset();
+
+        // Toutes les pistes relevées en même temps
+        auto start = std::chrono::steady_clock::now();
+        for (Lane& lane : lanes) {
+            if (batched) {
+                lane.lane->resetPins();
+            } else {
+                for (const auto& pin : lane.lane->getPins()) pin->reset();
+            }
+        }
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        result.resetUsPerLane += us / laneCount;
+        result.staleManifolds += countPinManifolds(dispatcher);
+
+        physics.step(settleSteps);
+        int standing = 0;
+        for (Lane& lane : lanes) standing += 10 - lane.lane->countKnockedDownPins();
+        result.standingPins += static_cast<double>(standing) / laneCount;
+    }
+
+    result.resetUsPerLane /= options.repeat;
+    result.staleManifolds /= options.repeat;
+    result.standingPins /= options.repeat;
+
+    // Boules et quilles quittent le monde avant lui
+    lanes.clear();
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Options invalides (voir l'en-tête de tools/RackResetBench.cpp)" << std::endl;
+        return 1;
+    }
+
+    // Pas de Ogre::Root : seul le LogManager est nécessaire (avertissements uniquement)
+    Ogre::LogManager logManager;
+    Ogre::Log* log = logManager.createLog("BowlingRackResetBench.log", true, false, true);
+    log->setMinLogLevel(Ogre::LML_WARNING);
+
+    std::cout << std::right << std::setw(7) << "lanes" << std::setw(10) << "reset"
+              << std::setw(14) << "us_par_piste" << std::setw(16) << "manifolds_perimes"
+              << std::setw(16) << "debout_par_piste" << std::endl;
+
+    for (int laneCount : options.lanes) {
+        for (bool batched : {false, true}) {
+            Result result = run(laneCount, batched, options);
+            std::cout << std::setw(7) << laneCount << std::setw(10) << (batched ? "rack" : "per-pin")
+                      << std::fixed << std::setprecision(2) << std::setw(14) << result.resetUsPerLane
+                      << std::setprecision(1) << std::setw(16) << result.staleManifolds
+                      << std::setw(16) << result.standingPins << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,197 @@
+// Rejoue une partie enregistrée (GameReplay) sans rendu, aussi vite que le processeur le
+// permet, et compare après chaque lancer le pas du repos, le score et l'état des quilles
+// au bit près. Contrôle de déterminisme après une modification de la physique
+// (enregistrement fait avec --record).
+//
+// Usage : BowlingReplay fichier.replay [dossier_bvh]
+//                                                  rejoue et vérifie
+//         BowlingReplay --record fichier.replay [graine] [motif.oil]
+//                                                  joue une partie simulée et l'enregistre
+//                                                  (avec le motif d'huilage donné)
+//
+// Code de retour : 0 identique, 1 erreur ou enregistrement non rejouable, 2 écart.
+// Un enregistrement du jeu (last_game.replay) recrée le monde du jeu (sol, formes des
+// quilles et de la boule, piste maillée relue du fichier de BvhCache dans dossier_bvh,
+// cache/bvh par défaut) puis rejoue le journal de la session frame par frame : pas de
+// chaque frame, lancers, reprises, comptes et relevages dans l'ordre du jeu.
+#include "core/AimingSystem.h"
+#include "core/BowlingSimulation.h"
+#include "core/GameReplay.h"
+#include "managers/PhysicsManager.h"
+#include <OgreLogManager.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace {
+
+int recordGame(const std::string& path, unsigned int seed, const std::string& oilPattern) {
+    BowlingSimulation simulation;
+    simulation.initialize();
+    if (!oilPattern.empty() && !simulation.getLane()->loadOilPattern(oilPattern)) {
+        std::cerr << "Motif d'huilage illisible : " << oilPattern << std::endl;
+        return 1;
+    }
+
+    GameReplay replay;
+    replay.begin(GameReplay::Source::SIMULATION, *simulation.getPhysics(), *simulation.getLane(), *simulation.getBall());
+    simulation.setRecorder(&replay);
+
+    // Mêmes tirages que BowlingHeadless
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> aimX(-0.05f, 0.05f);
+    std::uniform_real_distribution<float> power(40.0f, MAX_POWER);
+    std::uniform_real_distribution<float> spin(MIN_SPIN, MAX_SPIN);
+
+    simulation.resetGame();
+    while (!simulation.isGameOver()) {
+        Ogre::Vector3 direction(aimX(rng), 0.0f, -1.0f);
+        simulation.roll(direction, power(rng), spin(rng));
+    }
+
+    if (!replay.save(path)) {
+        std::cerr << "Impossible d'écrire " << path << std::endl;
+        return 1;
+    }
+    std::cout << path << " : " << replay.rolls.size() << " lancers, score " << replay.finalScore << std::endl;
+    return 0;
+}
+
+int verifyGame(const std::string& path, const std::string& bvhDirectory) {
+    GameReplay recorded;
+    if (!recorded.load(path)) {
+        std::cerr << "Enregistrement illisible : " << path << std::endl;
+        return 1;
+    }
+    const bool fromGame = recorded.source == GameReplay::Source::GAME;
+    if (fromGame && recorded.events.empty()) {
+        std::cerr << path << " : enregistrement du jeu sans journal de session, non rejouable" << std::endl;
+        return 1;
+    }
+
+    // Configuration physique de l'enregistrement, avant la création du monde
+    PhysicsManager* physics = PhysicsManager::getInstance();
+    if (recorded.fixedTimeStep > 0.0f) {
+        physics->setTickRate(1.0f / recorded.fixedTimeStep);
+    }
+    physics->setMultithreaded(recorded.multithreaded);
+    physics->getBvhCache().setDirectory(bvhDirectory);
+
+    BowlingSimulation simulation(physics);
+    if (fromGame) {
+        // Monde du jeu recréé avant ses corps, dans le même ordre
+        simulation.initialize(&recorded);
+        if (recorded.laneMeshHash != 0 && !simulation.getLane()->getLaneBody()) {
+            std::cerr << path << " : maillage de la piste " << recorded.laneMeshName
+                      << " introuvable dans " << bvhDirectory << std::endl;
+            return 1;
+        }
+    } else {
+        simulation.initialize();
+        simulation.getLane()->setColliderType(recorded.laneCollider);
+        BallCcdProfile ccd = simulation.getBall()->getCcdProfile();
+        ccd.enabled = recorded.ccdEnabled;
+        simulation.getBall()->setCcdProfile(ccd);
+    }
+    if (!recorded.oilFriction.empty()) {
+        // Table enregistrée telle quelle : le fichier du motif a pu changer depuis
+        LaneFrictionField pattern;
+        pattern.setName(recorded.oilPatternName);
+        for (int row = 0; row < LaneFrictionField::ROW_COUNT; ++row) {
+            for (int board = 0; board < LaneFrictionField::BOARD_COUNT; ++board) {
+                pattern.setFriction(row, board, recorded.oilFriction[row * LaneFrictionField::BOARD_COUNT + board]);
+            }
+        }
+        simulation.getLane()->setOilPattern(pattern);
+    }
+
+    GameReplay replayed;
+    replayed.begin(GameReplay::Source::SIMULATION, *physics, *simulation.getLane(), *simulation.getBall());
+    simulation.setRecorder(&replayed);
+
+    unsigned long steps = 0;
+    double simulatedTime = 0.0;
+    auto start = std::chrono::steady_clock::now();
+
+    if (fromGame) {
+        int replayedSteps = simulation.replayEvents(recorded, replayed);
+        if (replayedSteps < 0) {
+            std::cerr << path << " : journal de session incohérent" << std::endl;
+            return 1;
+        }
+        steps = static_cast<unsigned long>(replayedSteps);
+        simulatedTime = steps * physics->getFixedTimeStep();
+    } else {
+        unsigned long startSteps = physics->getStepCount();
+        simulation.resetGame();
+        for (const GameReplay::Roll& roll : recorded.rolls) {
+            if (simulation.isGameOver()) {
+                break;
+            }
+            simulation.roll(roll.direction, roll.power, roll.spin);
+            simulatedTime += simulation.getLastRollTime();
+        }
+        steps = physics->getStepCount() - startSteps;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << path << " (" << GameReplay::getSourceName(recorded.source) << ") : "
+              << replayed.rolls.size() << "/" << recorded.rolls.size() << " lancers, "
+              << steps << " pas en " << seconds << " s";
+    if (seconds > 0.0) {
+        std::cout << " (x" << simulatedTime / seconds << " temps réel)";
+    }
+    std::cout << std::endl;
+
+    GameReplay::Comparison comparison = recorded.compare(replayed);
+    std::cout << "score : enregistré " << recorded.finalScore << ", rejoué " << replayed.finalScore << std::endl;
+    if (!comparison.configurationMatches) {
+        std::cout << "configuration physique différente (pas fixe, piste, maillage, CCD, multithread ou motif d'huilage)" << std::endl;
+    }
+    if (comparison.firstMismatchRoll >= 0) {
+        std::cout << "premier lancer différent : " << comparison.firstMismatchRoll + 1;
+        size_t index = static_cast<size_t>(comparison.firstMismatchRoll);
+        if (index < recorded.rolls.size() && index < replayed.rolls.size()) {
+            std::cout << " (repos au pas " << recorded.rolls[index].settleStep << " enregistré, "
+                      << replayed.rolls[index].settleStep << " rejoué)";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "lancers dont les quilles diffèrent : " << comparison.pinStateMismatches
+              << " (écart max " << comparison.maxPinDeviation << " m)" << std::endl;
+
+    if (comparison.identical()) {
+        std::cout << "Identique au bit près." << std::endl;
+        return 0;
+    }
+    std::cout << "ECART : la simulation n'est plus déterministe pour cet enregistrement." << std::endl;
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage : BowlingReplay fichier.replay [dossier_bvh] | --record fichier.replay [graine] [motif.oil]" << std::endl;
+        return 1;
+    }
+
+    // Pas de Ogre::Root : seul le LogManager est nécessaire (avertissements uniquement)
+    Ogre::LogManager logManager;
+    Ogre::Log* log = logManager.createLog("BowlingReplay.log", true, false, true);
+    log->setMinLogLevel(Ogre::LML_WARNING);
+
+    std::string first = argv[1];
+    if (first == "--record") {
+        if (argc < 3) {
+            std::cerr << "--record : fichier manquant" << std::endl;
+            return 1;
+        }
+        unsigned int seed = (argc > 3) ? static_cast<unsigned int>(std::atoi(argv[3])) : 42u;
+        return recordGame(argv[2], seed, (argc > 4) ? argv[4] : "");
+    }
+    return verifyGame(first, (argc > 2) ? argv[2] : "cache/bvh");
+}
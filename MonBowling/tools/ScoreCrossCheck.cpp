@@ -0,0 +1,226 @@
+// Vérification du calcul de score incrémental de ScoreManager contre le recalcul complet
+// (ScoreRules::scoreRolls) sur des parties générées au hasard, puis coût par lancer
+// des deux calculs.
+//   vérification : après chaque lancer, scores des frames et total identiques ; marques
+//                  X et / conformes aux strikes et spares comptés par ScoreRules::countMarks ;
+//                  splits seulement sur la première boule d'un jeu de quilles
+//   coût         : enregistrement incrémental d'un lancer contre recalcul depuis la frame 1
+//
+// Usage : BowlingScoreCheck [options]
+//   --games N          parties vérifiées (défaut 1000000)
+//   --bench N          parties du banc de coût (défaut 100000)
+//   --strike p         probabilité de coucher toutes les quilles restantes (défaut 0.3)
+//   --seed s           graine (défaut 42)
+#include "core/FrameLogic.h"
+#include "states/ScoreManager.h"
+#include "ToolOptions.h"
+#include <OgreLogManager.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    long games = 1000000;
+    long bench = 100000;
+    float strike = 0.3f;
+    unsigned int seed = 42;
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    return ToolOptions::parsePairs(argc, argv, [&options](const std::string& key, const std::string& value) {
+        if (key == "--games") options.games = ToolOptions::parseValue<long>(value, 1L);
+        else if (key == "--bench") options.bench = ToolOptions::parseValue<long>(value, 1L);
+        else if (key == "--strike") options.strike = ToolOptions::parseValue<float>(value);
+        else if (key == "--seed") options.seed = ToolOptions::parseValue<unsigned int>(value);
+        else return false;
+        return true;
+    });
+}
+
+struct Game {
+    std::array<int, ScoreManager::MAX_ROLLS> rolls{};
+    std::array<int, ScoreManager::MAX_ROLLS> frames{};   // Frame (0-9) de chaque lancer
+    int count = 0;
+};
+
+// Partie valide tirée au hasard, déroulée par FrameLogic (lancers bonus de la 10e compris)
+void generateGame(std::mt19937& rng, float strikeRate, Game& game) {
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+    FrameLogic frameLogic;
+    game.count = 0;
+    while (!frameLogic.isGameOver()) {
+        int down = frameLogic.getPinsDownInRack();
+        int remaining = 10 - down;
+        int pins = chance(rng) < strikeRate ? remaining
+                                            : std::uniform_int_distribution<int>(0, remaining)(rng);
+        game.frames[game.count] = frameLogic.getCurrentFrame() - 1;
+        RollResult result = frameLogic.recordRoll(down + pins);
+        game.rolls[game.count] = result.pinsThisRoll;
+        ++game.count;
+    }
+}
+
+// Premier écart trouvé dans la partie, chaîne vide sinon
+std::string checkGame(ScoreManager& scores, const Game& game) {
+    std::array<int, ScoreManager::FRAME_COUNT> expected;
+    std::array<int, ScoreManager::MAX_ROLLS> played{};
+    MarkCounts previous;
+    scores.resetScore();
+    for (int roll = 0; roll < game.count; ++roll) {
+        scores.recordRoll(game.rolls[roll]);
+        played[roll] = game.rolls[roll];
+        int total = ScoreRules::scoreRolls(played, roll + 1, expected);
+        if (total != scores.getCurrentScore() || expected != scores.getFrameScores()) {
+            return "score différent après le lancer " + std::to_string(roll + 1) + " : " +
+                   std::to_string(scores.getCurrentScore()) + " au lieu de " + std::to_string(total);
+        }
+
+        // Dernière marque de la frame du lancer, contre le strike ou spare ajouté par ce lancer
+        PackedGame packed;
+        ScoreRules::pack(played.data(), roll + 1, packed);
+        MarkCounts counts;
+        ScoreRules::countMarks(packed, counts);
+        bool strike = counts.strikes > previous.strikes;
+        bool spare = counts.spares > previous.spares;
+        previous = counts;
+        const char* marks = scores.getFrameMarks(game.frames[roll]);
+        char mark = marks[std::strlen(marks) - 1];
+        if ((mark == 'X') != strike || (mark == '/') != spare) {
+            return "marque '" + std::string(1, mark) + "' incorrecte au lancer " + std::to_string(roll + 1);
+        }
+    }
+    return "";
+}
+
+// Quilles couchées pour un split 7-10 : seules pins[0] et pins[3] (coins du fond) restent
+const int SPLIT_7_10 = ((1 << 10) - 1) & ~((1 << 0) | (1 << 3));
+
+// Cas fixes des marques et des splits, premier écart trouvé (chaîne vide sinon)
+std::string checkFixedCases(ScoreManager& scores) {
+    // Split à la première boule : marqué
+    scores.resetScore();
+    scores.recordRoll(8, SPLIT_7_10);
+    if (scores.getSplitMask(0) != 1) {
+        return "split de première boule non marqué";
+    }
+    // Rigole puis 8 laissant un 7-10 : seconde boule, ni strike ni split ; puis 0 et 10 : spare
+    scores.resetScore();
+    scores.recordRoll(0, 0);
+    scores.recordRoll(8, SPLIT_7_10);
+    scores.recordRoll(0, 0);
+    scores.recordRoll(10, (1 << 10) - 1);
+    if (scores.getSplitMask(0) != 0) {
+        return "split marqué sur la seconde boule après une rigole";
+    }
+    if (std::strcmp(scores.getFrameMarks(1), "-/") != 0) {
+        return std::string("0 puis 10 marqué \"") + scores.getFrameMarks(1) + "\" au lieu de \"-/\"";
+    }
+    // 10e frame : strike, rigole, 10 (spare) ; puis strike, rigole et split à la seconde boule
+    scores.resetScore();
+    for (int frame = 0; frame < 9; ++frame) scores.recordRoll(10, (1 << 10) - 1);
+    scores.recordRoll(10, (1 << 10) - 1);
+    scores.recordRoll(0, 0);
+    scores.recordRoll(10, (1 << 10) - 1);
+    if (std::strcmp(scores.getFrameMarks(9), "X-/") != 0) {
+        return std::string("10e frame marquée \"") + scores.getFrameMarks(9) + "\" au lieu de \"X-/\"";
+    }
+    scores.resetScore();
+    for (int frame = 0; frame < 9; ++frame) scores.recordRoll(10, (1 << 10) - 1);
+    scores.recordRoll(10, (1 << 10) - 1);
+    scores.recordRoll(0, 0);
+    scores.recordRoll(8, SPLIT_7_10);
+    if (scores.getSplitMask(9) != 0) {
+        return "split marqué sur la seconde boule de la 10e frame";
+    }
+    return "";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Options invalides (voir l'en-tête de tools/ScoreCrossCheck.cpp)" << std::endl;
+        return 1;
+    }
+
+    // Pas de Ogre::Root : seul le LogManager est nécessaire (avertissements uniquement)
+    Ogre::LogManager logManager;
+    Ogre::Log* log = logManager.createLog("BowlingScoreCheck.log", true, false, true);
+    log->setMinLogLevel(Ogre::LML_WARNING);
+
+    // Sans initialize() : pas d'overlay, le score est seulement calculé
+    ScoreManager& scores = *ScoreManager::getInstance();
+    std::string fixedError = checkFixedCases(scores);
+    if (!fixedError.empty()) {
+        std::cerr << "Cas fixes : " << fixedError << std::endl;
+        return 1;
+    }
+
+    std::mt19937 rng(options.seed);
+    Game game;
+
+    long rolls = 0;
+    long perfectGames = 0;
+    for (long i = 0; i < options.games; ++i) {
+        generateGame(rng, options.strike, game);
+        std::string error = checkGame(scores, game);
+        if (!error.empty()) {
+            std::cerr << "Partie " << (i + 1) << " : " << error << std::endl << "  lancers :";
+            for (int roll = 0; roll < game.count; ++roll) std::cerr << ' ' << game.rolls[roll];
+            std::cerr << std::endl;
+            return 1;
+        }
+        rolls += game.count;
+        if (scores.getCurrentScore() == 300) ++perfectGames;
+    }
+    std::cout << options.games << " parties vérifiées (" << rolls << " lancers, "
+              << perfectGames << " parties parfaites) : aucun écart" << std::endl;
+
+    // Banc : mêmes parties pour les deux calculs
+    std::vector<Game> games(options.bench);
+    for (Game& benchGame : games) {
+        generateGame(rng, options.strike, benchGame);
+    }
+    long benchRolls = 0;
+    for (const Game& benchGame : games) benchRolls += benchGame.count;
+
+    long checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const Game& benchGame : games) {
+        scores.resetScore();
+        for (int roll = 0; roll < benchGame.count; ++roll) {
+            scores.recordRoll(benchGame.rolls[roll]);
+        }
+        checksum += scores.getCurrentScore();
+    }
+    double incremental = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / benchRolls;
+
+    std::array<int, ScoreManager::FRAME_COUNT> frameScores;
+    long fullChecksum = 0;
+    start = std::chrono::steady_clock::now();
+    for (const Game& benchGame : games) {
+        int total = 0;
+        for (int roll = 0; roll < benchGame.count; ++roll) {
+            total = ScoreRules::scoreRolls(benchGame.rolls, roll + 1, frameScores);
+        }
+        fullChecksum += total;
+    }
+    double full = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / benchRolls;
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "lancer incrémental  : " << incremental << " ns" << std::endl
+              << "recalcul complet    : " << full << " ns" << std::endl
+              << "(totaux " << checksum << (checksum == fullChecksum ? " = " : " != ") << fullChecksum << ")" << std::endl;
+    return checksum == fullChecksum ? 0 : 1;
+}
@@ -0,0 +1,204 @@
+// Banc de la bibliothèque de score (ScoreRules) sur des lots de parties encodées sur
+// 4 bits par lancer, comme pour rescorer une soirée de ligue.
+//   vérification : scores du noyau par lot identiques au parcours complet (scoreRolls) ;
+//                  chaque partie corrompue (quartet hors limites, lancer manquant ou en
+//                  trop, jeu de plus de 10 quilles) signalée avec le bon défaut
+//   débit        : parties scorées par seconde, parcours scalaire puis lot sur 1 cœur,
+//                  puis lot sur N threads (débit total et par cœur)
+//
+// Usage : BowlingScoringBench [options]
+//   --games N          parties du lot (défaut 50000)
+//   --repeat N         passes sur le lot par mesure (défaut 100)
+//   --threads N        threads de la dernière mesure (défaut : nombre de cœurs)
+//   --invalid p        proportion de parties corrompues (défaut 0.01)
+//   --strike p         probabilité de coucher toutes les quilles restantes (défaut 0.3)
+//   --seed s           graine (défaut 42)
+#include "core/FrameLogic.h"
+#include "states/ScoreRules.h"
+#include "ToolOptions.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    int games = 50000;
+    int repeat = 100;
+    unsigned int threads = 0;
+    float invalid = 0.01f;
+    float strike = 0.3f;
+    unsigned int seed = 42;
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    return ToolOptions::parsePairs(argc, argv, [&options](const std::string& key, const std::string& value) {
+        if (key == "--games") options.games = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--repeat") options.repeat = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--threads") options.threads = ToolOptions::parseValue<unsigned int>(value);
+        else if (key == "--invalid") options.invalid = ToolOptions::parseValue<float>(value);
+        else if (key == "--strike") options.strike = ToolOptions::parseValue<float>(value);
+        else if (key == "--seed") options.seed = ToolOptions::parseValue<unsigned int>(value);
+        else return false;
+        return true;
+    });
+}
+
+// Partie valide tirée au hasard, déroulée par FrameLogic (lancers bonus de la 10e compris)
+int generateRolls(std::mt19937& rng, float strikeRate, int* rolls) {
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+    FrameLogic frameLogic;
+    int count = 0;
+    while (!frameLogic.isGameOver()) {
+        int down = frameLogic.getPinsDownInRack();
+        int remaining = 10 - down;
+        int pins = chance(rng) < strikeRate ? remaining
+                                            : std::uniform_int_distribution<int>(0, remaining)(rng);
+        rolls[count++] = frameLogic.recordRoll(down + pins).pinsThisRoll;
+    }
+    return count;
+}
+
+void setNibble(PackedGame& game, int index, uint64_t value) {
+    uint64_t& word = index < 16 ? game.lo : game.hi;
+    int shift = 4 * (index & 15);
+    word = (word & ~(0xFull << shift)) | (value << shift);
+}
+
+// Corrompt une partie valide ; retourne le défaut attendu
+uint8_t corrupt(std::mt19937& rng, int* rolls, int count, PackedGame& game) {
+    std::uniform_int_distribution<int> kind(0, 3);
+    switch (kind(rng)) {
+        case 1:
+            setNibble(game, count - 1, ScoreRules::NO_ROLL);
+            return SCORE_ERROR_MISSING_ROLL;
+        case 2:
+            if (count < ScoreRules::MAX_ROLLS) {
+                setNibble(game, count, 0);
+                return SCORE_ERROR_EXTRA_ROLL;
+            }
+            break;
+        case 3:
+            // Deuxième boule de la première frame ouverte : une quille de trop
+            if (rolls[0] > 0 && rolls[0] < 10) {
+                rolls[1] = 11 - rolls[0];
+                ScoreRules::pack(rolls, count, game);
+                return SCORE_ERROR_RACK_TOTAL;
+            }
+            break;
+        default:
+            break;
+    }
+    setNibble(game, std::uniform_int_distribution<int>(0, count - 1)(rng), 11 + kind(rng));
+    return SCORE_ERROR_PIN_COUNT;
+}
+
+// Parcours scalaire : décodage puis parcours complet des frames
+void scoreScalar(const std::vector<PackedGame>& games, std::vector<int16_t>& scores) {
+    std::array<int, ScoreRules::MAX_ROLLS> rolls;
+    std::array<int, ScoreRules::FRAME_COUNT> frameScores;
+    for (size_t i = 0; i < games.size(); ++i) {
+        rolls.fill(0);
+        int count = ScoreRules::unpack(games[i], rolls.data());
+        scores[i] = static_cast<int16_t>(ScoreRules::scoreRolls(rolls, count, frameScores));
+    }
+}
+
+// Parties scorées par seconde
+template <typename Score>
+double measure(int repeat, size_t games, Score score) {
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < repeat; ++pass) {
+        score();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds > 0.0 ? repeat * static_cast<double>(games) / seconds : 0.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Options invalides (voir l'en-tête de tools/ScoringBench.cpp)" << std::endl;
+        return 1;
+    }
+    if (options.threads == 0) {
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    std::mt19937 rng(options.seed);
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+    std::vector<PackedGame> games(options.games);
+    std::vector<int> expectedScores(options.games);
+    std::vector<uint8_t> expectedErrors(options.games, 0);
+    std::array<int, ScoreRules::MAX_ROLLS> rolls;
+    std::array<int, ScoreRules::FRAME_COUNT> frameScores;
+    int invalidCount = 0;
+    for (int i = 0; i < options.games; ++i) {
+        rolls.fill(0);
+        int count = generateRolls(rng, options.strike, rolls.data());
+        ScoreRules::pack(rolls.data(), count, games[i]);
+        expectedScores[i] = ScoreRules::scoreRolls(rolls, count, frameScores);
+        if (chance(rng) < options.invalid) {
+            expectedErrors[i] = corrupt(rng, rolls.data(), count, games[i]);
+            expectedScores[i] = -1;
+            ++invalidCount;
+        }
+    }
+
+    // Vérification du noyau par lot
+    std::vector<int16_t> scores(options.games);
+    std::vector<uint8_t> errors(options.games);
+    size_t flagged = ScoreRules::scoreGames(games.data(), games.size(), scores.data(), errors.data());
+    for (int i = 0; i < options.games; ++i) {
+        bool expectedValid = expectedErrors[i] == 0;
+        if (scores[i] != expectedScores[i] || (errors[i] == 0) != expectedValid ||
+            (!expectedValid && !(errors[i] & expectedErrors[i]))) {
+            std::cerr << "Partie " << i << " : score " << scores[i] << " (attendu " << expectedScores[i]
+                      << "), défauts " << static_cast<int>(errors[i]) << " (attendu "
+                      << static_cast<int>(expectedErrors[i]) << ")" << std::endl;
+            return 1;
+        }
+    }
+    std::cout << options.games << " parties vérifiées, " << flagged << " invalides signalées sur "
+              << invalidCount << " corrompues" << std::endl << std::endl;
+
+    double scalar = measure(options.repeat, games.size(), [&] { scoreScalar(games, scores); });
+    double batch = measure(options.repeat, games.size(),
+        [&] { ScoreRules::scoreGames(games.data(), games.size(), scores.data(), errors.data()); });
+
+    // Un lot complet par thread, sorties séparées
+    std::vector<std::vector<int16_t>> threadScores(options.threads, std::vector<int16_t>(games.size()));
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned int t = 0; t < options.threads; ++t) {
+        pool.emplace_back([&, t] {
+            for (int pass = 0; pass < options.repeat; ++pass) {
+                ScoreRules::scoreGames(games.data(), games.size(), threadScores[t].data(), nullptr);
+            }
+        });
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double parallel = seconds > 0.0 ? options.threads * options.repeat * static_cast<double>(games.size()) / seconds : 0.0;
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "scalaire (1 cœur)   : " << scalar / 1e6 << " M parties/s" << std::endl
+              << "lot (1 cœur)        : " << batch / 1e6 << " M parties/s (x" << std::setprecision(2)
+              << (scalar > 0.0 ? batch / scalar : 0.0) << ")" << std::endl
+              << std::setprecision(1)
+              << "lot (" << options.threads << " threads)     : " << parallel / 1e6 << " M parties/s, "
+              << parallel / options.threads / 1e6 << " M parties/s par cœur" << std::endl;
+    return 0;
+}
@@ -0,0 +1,201 @@
+// Banc des instantanés physiques : un lancer est simulé jusqu'à l'arrivée de la boule sur
+// les quilles, le monde est capturé (PhysicsSnapshot), puis le lancer est terminé pour servir
+// de référence. Le banc mesure ensuite capture et restauration (µs) et rejoue des branches
+// depuis l'instantané : la branche 0 refait le même lancer, son écart à la référence mesure la
+// fidélité de la restauration : elle doit retrouver la référence au bit près, sinon le banc
+// échoue (code de sortie 1) ; les suivantes décalent la vitesse latérale de la boule de
+// --jitter m/s chacune.
+//
+// Usage : BowlingSnapshotBench [options]
+//   --power p          puissance du lancer (défaut 25, MAX_POWER = 100)
+//   --aim deg          angle de visée (défaut 0.5)
+//   --branches n       nombre de branches (défaut 8)
+//   --jitter v         décalage de vitesse latérale entre deux branches (défaut 0.02 m/s)
+//   --time s           temps simulé après l'instantané (défaut 3)
+//   --reps n           répétitions pour la mesure de capture/restauration (défaut 1000)
+#include "core/AimingSystem.h"
+#include "managers/PhysicsManager.h"
+#include "managers/PhysicsSnapshot.h"
+#include "objects/BowlingBall.h"
+#include "objects/BowlingLane.h"
+#include "ToolOptions.h"
+#include <OgreLogManager.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const float BALL_START_Z = 7.0f;
+const float CAPTURE_DISTANCE = 1.5f;
+const float MAX_APPROACH_TIME = 5.0f;
+
+struct Options {
+    float power = 25.0f;
+    float aim = 0.5f;
+    int branches = 8;
+    float jitter = 0.02f;
+    float time = 3.0f;
+    int reps = 1000;
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    return ToolOptions::parsePairs(argc, argv, [&options](const std::string& key, const std::string& value) {
+        if (key == "--power") options.power = ToolOptions::parseValue<float>(value);
+        else if (key == "--aim") options.aim = ToolOptions::parseValue<float>(value);
+        else if (key == "--branches") options.branches = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--jitter") options.jitter = ToolOptions::parseValue<float>(value);
+        else if (key == "--time") options.time = ToolOptions::parseValue<float>(value, 0.1f);
+        else if (key == "--reps") options.reps = ToolOptions::parseValue<int>(value, 1);
+        else return false;
+        return true;
+    });
+}
+
+bool nearPins(const BowlingBall& ball, const BowlingLane& lane) {
+    const btVector3& ballPosition = ball.getBallBody()->getWorldTransform().getOrigin();
+    for (const auto& pin : lane.getPins()) {
+        btVector3 offset = pin->getPinBody()->getWorldTransform().getOrigin() - ballPosition;
+        offset.setY(0.0f);
+        if (offset.length2() < CAPTURE_DISTANCE * CAPTURE_DISTANCE) return true;
+    }
+    return false;
+}
+
+void simulate(PhysicsManager& physics, BowlingBall& ball, int steps) {
+    const float dt = physics.getFixedTimeStep();
+    for (int step = 0; step < steps; ++step) {
+        physics.step();
+        ball.update(dt);
+    }
+}
+
+// Transformations finales de la boule puis des quilles
+std::vector<btTransform> finalTransforms(const BowlingBall& ball, const BowlingLane& lane) {
+    std::vector<btTransform> transforms;
+    transforms.push_back(ball.getBallBody()->getWorldTransform());
+    for (const auto& pin : lane.getPins()) transforms.push_back(pin->getPinBody()->getWorldTransform());
+    return transforms;
+}
+
+float maxDeviation(const std::vector<btTransform>& a, const std::vector<btTransform>& b) {
+    float deviation = 0.0f;
+    for (size_t i = 0; i < a.size(); ++i) deviation = std::max(deviation, (a[i].getOrigin() - b[i].getOrigin()).length());
+    return deviation;
+}
+
+// Mêmes positions et orientations au bit près
+bool identical(const std::vector<btTransform>& a, const std::vector<btTransform>& b) {
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (!(a[i] == b[i])) return false;
+    }
+    return true;
+}
+
+int pinsDown(const BowlingLane& lane) {
+    int count = 0;
+    for (const auto& pin : lane.getPins()) {
+        if (pin->isKnockedDown()) ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Options invalides (voir l'en-tête de tools/SnapshotBench.cpp)" << std::endl;
+        return 1;
+    }
+
+    // Pas de Ogre::Root : seul le LogManager est nécessaire (avertissements uniquement)
+    Ogre::LogManager logManager;
+    Ogre::Log* log = logManager.createLog("BowlingSnapshotBench.log", true, false, true);
+    log->setMinLogLevel(Ogre::LML_WARNING);
+
+    PhysicsManager physics;
+    physics.initialize(nullptr);
+    BowlingLane lane(nullptr, &physics);
+    lane.create(Ogre::Vector3::ZERO);
+    BowlingBall ball(nullptr, "ball.mesh", &physics);
+    ball.create(Ogre::Vector3(0.0f, ball.getRadius() + 0.01f, BALL_START_Z));
+
+    Ogre::Radian aim = Ogre::Degree(options.aim);
+    ball.launch(Ogre::Vector3(Ogre::Math::Sin(aim), 0.0f, -Ogre::Math::Cos(aim)), options.power);
+
+    // Approche : jusqu'à ce que la boule arrive sur les quilles
+    const float dt = physics.getFixedTimeStep();
+    const int maxApproachSteps = static_cast<int>(MAX_APPROACH_TIME / dt);
+    int approachSteps = 0;
+    while (!nearPins(ball, lane) && approachSteps < maxApproachSteps) {
+        simulate(physics, ball, 1);
+        ++approachSteps;
+    }
+    if (!ball.isRolling() || approachSteps == maxApproachSteps) {
+        std::cerr << "La boule n'atteint pas les quilles (puissance ou visée)" << std::endl;
+        return 1;
+    }
+
+    PhysicsSnapshot snapshot;
+    if (!physics.captureSnapshot(snapshot)) {
+        std::cerr << "Capacité de l'instantané dépassée" << std::endl;
+        return 1;
+    }
+
+    // Référence : le lancer terminé sans restauration
+    const int steps = static_cast<int>(options.time / dt);
+    simulate(physics, ball, steps);
+    std::vector<btTransform> reference = finalTransforms(ball, lane);
+    int referencePins = pinsDown(lane);
+
+    // Mesures : captures puis restaurations répétées du même état
+    PhysicsSnapshot scratch;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < options.reps; ++i) physics.captureSnapshot(scratch);
+    double captureUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / options.reps;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < options.reps; ++i) physics.restoreSnapshot(snapshot);
+    double restoreUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / options.reps;
+
+    std::cout << "instantane : pas " << snapshot.getStepCount() << ", " << snapshot.getBodyCount() << " corps, "
+              << snapshot.getContactPointCount() << " points de contact, "
+              << snapshot.getCapacityBytes() / 1024 << " Kio reserves" << std::endl;
+    std::cout << std::fixed << std::setprecision(2) << "capture " << captureUs << " us, restauration "
+              << restoreUs << " us" << std::endl;
+    std::cout << "reference : " << referencePins << " quilles tombees" << std::endl << std::endl;
+
+    std::cout << std::right << std::setw(8) << "branche" << std::setw(12) << "dvx_m_s" << std::setw(11)
+              << "pins_down" << std::setw(14) << "ecart_ref_m" << std::endl;
+
+    for (int branch = 0; branch < options.branches; ++branch) {
+        if (!physics.restoreSnapshot(snapshot)) {
+            std::cerr << "Restauration impossible" << std::endl;
+            return 1;
+        }
+        ball.setRolling(true);
+
+        float lateral = options.jitter * branch;
+        btRigidBody* ballBody = ball.getBallBody();
+        ballBody->setLinearVelocity(ballBody->getLinearVelocity() + btVector3(lateral, 0.0f, 0.0f));
+
+        simulate(physics, ball, steps);
+        std::vector<btTransform> result = finalTransforms(ball, lane);
+        float deviation = maxDeviation(reference, result);
+
+        std::cout << std::setw(8) << branch << std::setprecision(3) << std::setw(12) << lateral
+                  << std::setw(11) << pinsDown(lane) << std::setprecision(6) << std::setw(14) << deviation << std::endl;
+
+        if (branch == 0 && !identical(reference, result)) {
+            std::cerr << "La branche 0 ne reproduit pas la reference au bit pres" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+// Banc du modèle d'effet de la boule appliqué dans le callback de pré-tick de Bullet.
+//   coût  : pas physique du lancer (boule + 10 quilles) avec et sans BowlingBall dans les
+//           PhysicsTickListener, et coût isolé d'un appel à onPhysicsTick
+//   hook  : écart latéral de la boule après 1 s simulée, monde avancé par update() à
+//           plusieurs fréquences d'affichage (identique si l'effet ne dépend plus de la frame)
+//
+// Usage : BowlingSpinTickBench [options]
+//   --steps N          pas mesurés par répétition (défaut 600)
+//   --repeat N         répétitions (défaut 10)
+//   --spin s           spin du lancer (défaut 0.5)
+//   --fps 30,60,144    fréquences d'affichage du test de hook
+#include "core/AimingSystem.h"
+#include "core/BowlingSimulation.h"
+#include "managers/PhysicsManager.h"
+#include "ToolOptions.h"
+#include <OgreLogManager.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int DIRECT_CALLS = 1000000;
+const float HOOK_TIME = 1.0f;
+
+struct Options {
+    int steps = 600;
+    int repeat = 10;
+    float spin = 0.5f;
+    std::vector<int> fps = {30, 60, 144, 240};
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    return ToolOptions::parsePairs(argc, argv, [&options](const std::string& key, const std::string& value) {
+        if (key == "--steps") options.steps = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--repeat") options.repeat = ToolOptions::parseValue<int>(value, 1);
+        else if (key == "--spin") options.spin = ToolOptions::parseValue<float>(value);
+        else if (key == "--fps") options.fps = ToolOptions::parseList<int>(value, 1);
+        else return false;
+        return true;
+    });
+}
+
+void launch(BowlingSimulation& simulation, const Options& options) {
+    simulation.resetRack();
+    simulation.getBall()->launch(Ogre::Vector3(0.0f, 0.0f, -1.0f), MAX_POWER * 0.8f, options.spin);
+}
+
+// Temps moyen d'un pas du lancer (µs)
+double measureThrow(BowlingSimulation& simulation, PhysicsManager& physics, const Options& options) {
+    BowlingBall* ball = simulation.getBall();
+    launch(simulation, options);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < options.steps; ++i) {
+        physics.step();
+        ball->update(physics.getFixedTimeStep());
+    }
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / options.steps;
+}
+
+// Position latérale de la boule après HOOK_TIME, le monde avancé frame par frame
+float measureHook(BowlingSimulation& simulation, PhysicsManager& physics, const Options& options, int fps) {
+    BowlingBall* ball = simulation.getBall();
+    launch(simulation, options);
+    // Accumulateur vidé : chaque fréquence part du même pas
+    physics.setFixedStepEnabled(true);
+    const float frameTime = 1.0f / fps;
+    const int frames = static_cast<int>(HOOK_TIME * fps + 0.5f);
+    for (int i = 0; i < frames; ++i) {
+        physics.update(frameTime);
+        ball->update(frameTime);
+    }
+    return ball->getBallBody()->getWorldTransform().getOrigin().x();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Options invalides (voir l'en-tête de tools/SpinTickBench.cpp)" << std::endl;
+        return 1;
+    }
+
+    // Pas de Ogre::Root : seul le LogManager est nécessaire (avertissements uniquement)
+    Ogre::LogManager logManager;
+    Ogre::Log* log = logManager.createLog("BowlingSpinTickBench.log", true, false, true);
+    log->setMinLogLevel(Ogre::LML_WARNING);
+
+    PhysicsManager physics;
+    BowlingSimulation simulation(&physics);
+    simulation.initialize();
+    BowlingBall* ball = simulation.getBall();
+
+    // Répétitions alternées avec et sans le modèle, pour ne pas favoriser l'un des deux
+    double withModel = 0.0;
+    double withoutModel = 0.0;
+    for (int run = 0; run < options.repeat; ++run) {
+        withModel += measureThrow(simulation, physics, options);
+        physics.removeTickListener(ball);
+        withoutModel += measureThrow(simulation, physics, options);
+        physics.addTickListener(ball);
+    }
+    withModel /= options.repeat;
+    withoutModel /= options.repeat;
+
+    // Appel isolé : boule lancée, pas de durée nulle (ni impulsion ni amortissement)
+    launch(simulation, options);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < DIRECT_CALLS; ++i) {
+        ball->onPhysicsTick(0.0f);
+    }
+    double callNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / DIRECT_CALLS;
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "pas avec le modèle   : " << withModel << " us" << std::endl
+              << "pas sans le modèle   : " << withoutModel << " us" << std::endl
+              << "écart par pas        : " << (withModel - withoutModel) * 1000.0 << " ns ("
+              << std::setprecision(2) << 100.0 * (withModel - withoutModel) / withoutModel << " %)" << std::endl
+              << "appel onPhysicsTick  : " << std::setprecision(1) << callNs << " ns" << std::endl
+              << std::endl;
+
+    std::cout << std::right << std::setw(6) << "fps" << std::setw(14) << "x_apres_1s" << std::endl;
+    for (int fps : options.fps) {
+        float x = measureHook(simulation, physics, options, fps);
+        std::cout << std::setw(6) << fps << std::setprecision(5) << std::setw(14) << x << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+#ifndef TOOL_OPTIONS_H
+#define TOOL_OPTIONS_H
+
+// Lecture des options des outils sans rendu : paires « --clé valeur », listes séparées par
+// des virgules (--lanes 1,2,4). Chaque outil garde sa structure Options et son parseOptions,
+// qui ne fait plus que router les clés.
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ToolOptions {
+
+// Valeur numérique lue comme atoi/atof (0 si illisible), ramenée à minimum au besoin
+template <typename T>
+T parseValue(const std::string& text, T minimum = std::numeric_limits<T>::lowest()) {
+    T value;
+    if constexpr (std::is_floating_point<T>::value) {
+        value = static_cast<T>(std::atof(text.c_str()));
+    } else {
+        value = static_cast<T>(std::atoll(text.c_str()));
+    }
+    return std::max(minimum, value);
+}
+
+// Liste « a,b,c » : chaque élément lu par parseValue
+template <typename T>
+std::vector<T> parseList(const std::string& text, T minimum = std::numeric_limits<T>::lowest()) {
+    std::vector<T> values;
+    std::stringstream list(text);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        values.push_back(parseValue<T>(item, minimum));
+    }
+    return values;
+}
+
+// Parcourt les paires de argv ; handler(clé, valeur) retourne false pour une clé inconnue,
+// ce qui arrête la lecture. Un dernier argument sans valeur est ignoré.
+template <typename Handler>
+bool parsePairs(int argc, char** argv, Handler handler) {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!handler(std::string(argv[i]), std::string(argv[i + 1]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace ToolOptions
+
+#endif // TOOL_OPTIONS_H
@@ -0,0 +1,135 @@
+// Banc de la synchronisation des nœuds : N sphères posées sur un plan, chacune avec son
+// nœud Ogre, dont une fraction est remise en mouvement à chaque frame. Compare l'ancienne
+// mise à jour objet par objet (getInterpolatedTransform puis setPosition/setOrientation pour
+// chaque corps, endormi ou non) à PhysicsManager::syncSceneNodes (seuls les corps marqués
+// par leur NodeMotionState sont recopiés). Temps en ns par objet enregistré.
+//
+// Usage : BowlingTransformSyncBench [options]
+//   --counts 100,250,500,1000    nombres d'objets
+//   --active 0,0.1,1             fractions d'objets en mouvement
+//   --frames N                   frames mesurées par configuration (défaut 300)
+#include "managers/PhysicsManager.h"
+#include "ToolOptions.h"
+#include <OgreLogManager.h>
+#include <OgreRoot.h>
+#include <OgreSceneManager.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const float SPHERE_RADIUS = 0.1f;
+const float SPHERE_SPACING = 0.5f;
+const float SETTLE_TIME = 5.0f;
+
+struct Options {
+    std::vector<int> counts = {100, 250, 500, 1000};
+    std::vector<float> active = {0.0f, 0.1f, 1.0f};
+    int frames = 300;
+};
+
+struct Result {
+    double perObjectNs = 0.0;
+    double syncNs = 0.0;
+};
+
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    return ToolOptions::parsePairs(argc, argv, [&options](const std::string& key, const std::string& value) {
+        if (key == "--counts") options.counts = ToolOptions::parseList<int>(value, 1);
+        else if (key == "--active") options.active = ToolOptions::parseList<float>(value);
+        else if (key == "--frames") options.frames = ToolOptions::parseValue<int>(value, 1);
+        else return false;
+        return true;
+    });
+}
+
+Result run(Ogre::SceneManager* sceneMgr, int count, float activeFraction, const Options& options) {
+    PhysicsManager physics;
+    physics.initialize(nullptr);
+
+    btTransform transform;
+    transform.setIdentity();
+    physics.addPrimitiveRigidBody(0.0f, new btStaticPlaneShape(btVector3(0, 1, 0), 0.0f), transform);
+
+    int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
+    std::vector<btRigidBody*> bodies;
+    std::vector<Ogre::SceneNode*> nodes;
+    for (int i = 0; i < count; ++i) {
+        transform.setOrigin(btVector3((i % side) * SPHERE_SPACING, SPHERE_RADIUS, (i / side) * SPHERE_SPACING));
+        Ogre::SceneNode* node = sceneMgr->getRootSceneNode()->createChildSceneNode();
+        btRigidBody* body = physics.addPrimitiveRigidBody(1.0f, new btSphereShape(SPHERE_RADIUS), transform, node);
+        bodies.push_back(body);
+        nodes.push_back(node);
+    }
+
+    // Toutes les sphères s'endorment avant la mesure
+    physics.step(static_cast<int>(SETTLE_TIME / physics.getFixedTimeStep()));
+
+    const int moving = static_cast<int>(activeFraction * count);
+    Result result;
+    for (int frame = 0; frame < options.frames; ++frame) {
+        for (int i = 0; i < moving; ++i) {
+            bodies[i]->activate(true);
+            bodies[i]->setLinearVelocity(btVector3(0.1f, 0.0f, (frame % 2) ? 0.1f : -0.1f));
+        }
+        physics.step();
+
+        // Ancienne mise à jour : chaque objet relit sa transformation et place son nœud
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; ++i) {
+            btTransform displayed = physics.getInterpolatedTransform(bodies[i]);
+            const btVector3& position = displayed.getOrigin();
+            btQuaternion rotation = displayed.getRotation();
+            nodes[i]->setPosition(position.x(), position.y(), position.z());
+            nodes[i]->setOrientation(rotation.w(), rotation.x(), rotation.y(), rotation.z());
+        }
+        auto middle = std::chrono::steady_clock::now();
+        physics.syncSceneNodes();
+        auto end = std::chrono::steady_clock::now();
+
+        result.perObjectNs += std::chrono::duration<double, std::nano>(middle - start).count();
+        result.syncNs += std::chrono::duration<double, std::nano>(end - middle).count();
+    }
+
+    result.perObjectNs /= static_cast<double>(options.frames) * count;
+    result.syncNs /= static_cast<double>(options.frames) * count;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Options invalides (voir l'en-tête de tools/TransformSyncBench.cpp)" << std::endl;
+        return 1;
+    }
+
+    // Ogre sans système de rendu : seul le graphe de scène est utilisé
+    Ogre::Root root("", "", "BowlingTransformSyncBench.log");
+    Ogre::LogManager::getSingleton().getDefaultLog()->setMinLogLevel(Ogre::LML_WARNING);
+    Ogre::SceneManager* sceneMgr = root.createSceneManager();
+
+    std::cout << std::right << std::setw(8) << "objets" << std::setw(9) << "actifs"
+              << std::setw(16) << "par_objet_ns" << std::setw(10) << "sync_ns" << std::endl;
+
+    for (int count : options.counts) {
+        for (float active : options.active) {
+            Result result = run(sceneMgr, count, active, options);
+            sceneMgr->clearScene();
+            std::cout << std::setw(8) << count << std::fixed << std::setprecision(2) << std::setw(9) << active
+                      << std::setprecision(1) << std::setw(16) << result.perObjectNs
+                      << std::setw(10) << result.syncNs << std::endl;
+        }
+    }
+    return 0;
+}
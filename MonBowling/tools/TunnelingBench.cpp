@@ -0,0 +1,188 @@
+// Banc de non-régression du tunneling : la boule lancée dans le jeu de quilles, sans puis
+// avec la détection continue (BallCcdProfile), pour chaque couple puissance x fréquence.
+// Un incident est compté quand le centre de la boule passe, pendant un pas, à portée d'une
+// quille debout (rayon de la boule + rayon de la quille) sans qu'aucun contact boule-quille
+// n'existe ni pendant ce pas ni avant : la boule a traversé la quille.
+//
+// Usage : BowlingTunnelingBench [options]
+//   --powers 10,25,50,75,100   puissances de lancer (MAX_POWER = 100)
+//   --rates 30,60,120,240      fréquences du pas fixe (Hz)
+//   --aims 0,0.5,-0.5          angles de visée (degrés)
+//   --time s                   temps simulé par lancer (défaut 3)
+#include "core/AimingSystem.h"
+#include "managers/PhysicsManager.h"
+#include "objects/BowlingBall.h"
+#include "objects/BowlingLane.h"
+#include "ToolOptions.h"
+#include <OgreLogManager.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const float BALL_START_Z = 7.0f;
+
+struct Options {
+    std::vector<float> powers = {10.0f, 25.0f, 50.0f, 75.0f, MAX_POWER};
+    std::vector<float> rates = {30.0f, 60.0f, 120.0f, 240.0f};
+    std::vector<float> aims = {0.0f, 0.5f, -0.5f, 1.0f, -1.0f};
+    float time = 3.0f;
+};
+
+struct Result {
+    int incidents = 0;
+    int throws = 0;
+    double stepUs = 0.0;
+    double pinsDown = 0.0;
+};
+
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    return ToolOptions::parsePairs(argc, argv, [&options](const std::string& key, const std::string& value) {
+        if (key == "--powers") options.powers = ToolOptions::parseList<float>(value);
+        else if (key == "--rates") options.rates = ToolOptions::parseList<float>(value);
+        else if (key == "--aims") options.aims = ToolOptions::parseList<float>(value);
+        else if (key == "--time") options.time = ToolOptions::parseValue<float>(value, 0.1f);
+        else return false;
+        return true;
+    });
+}
+
+// Distance dans le plan XZ entre le point p et le segment [a, b]
+float segmentDistanceXZ(const btVector3& a, const btVector3& b, const btVector3& p) {
+    btVector3 ab(b.x() - a.x(), 0.0f, b.z() - a.z());
+    btVector3 ap(p.x() - a.x(), 0.0f, p.z() - a.z());
+    float lengthSq = ab.length2();
+    float t = lengthSq > 0.0f ? std::max(0.0f, std::min(1.0f, ap.dot(ab) / lengthSq)) : 0.0f;
+    return (ap - ab * t).length();
+}
+
+bool inContact(btDispatcher* dispatcher, const btCollisionObject* a, const btCollisionObject* b) {
+    for (int m = 0; m < dispatcher->getNumManifolds(); ++m) {
+        const btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(m);
+        bool pair = (manifold->getBody0() == a && manifold->getBody1() == b) ||
+                    (manifold->getBody0() == b && manifold->getBody1() == a);
+        if (pair && manifold->getNumContacts() > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void runThrow(float power, float rate, float aimDegrees, bool ccd, const Options& options, Result& result) {
+    PhysicsManager physics;
+    physics.initialize(nullptr);
+    physics.setTickRate(rate);
+
+    BowlingLane lane(nullptr, &physics);
+    lane.create(Ogre::Vector3::ZERO);
+    BowlingBall ball(nullptr, "ball.mesh", &physics);
+    ball.create(Ogre::Vector3(0.0f, ball.getRadius() + 0.01f, BALL_START_Z));
+
+    BallCcdProfile profile;
+    profile.enabled = ccd;
+    ball.setCcdProfile(profile);
+
+    btRigidBody* ballBody = ball.getBallBody();
+    btDispatcher* dispatcher = physics.getDynamicsWorld()->getBtWorld()->getDispatcher();
+
+    // Portée de contact de chaque quille : rayon de sa boîte englobante dans le plan XZ
+    const auto& pins = lane.getPins();
+    std::vector<float> reach;
+    std::vector<bool> touched(pins.size(), false);
+    std::vector<bool> tunneled(pins.size(), false);
+    for (const auto& pin : pins) {
+        btVector3 aabbMin, aabbMax;
+        btTransform identity;
+        identity.setIdentity();
+        pin->getPinBody()->getCollisionShape()->getAabb(identity, aabbMin, aabbMax);
+        float pinRadius = 0.5f * std::min(aabbMax.x() - aabbMin.x(), aabbMax.z() - aabbMin.z());
+        reach.push_back(ball.getCollisionRadius() + pinRadius);
+    }
+
+    Ogre::Radian aim = Ogre::Degree(aimDegrees);
+    ball.launch(Ogre::Vector3(Ogre::Math::Sin(aim), 0.0f, -Ogre::Math::Cos(aim)), power);
+
+    const float dt = physics.getFixedTimeStep();
+    const int steps = static_cast<int>(options.time / dt);
+    double stepTotal = 0.0;
+    for (int step = 0; step < steps; ++step) {
+        btVector3 before = ballBody->getWorldTransform().getOrigin();
+
+        auto start = std::chrono::steady_clock::now();
+        physics.step();
+        ball.update(dt);
+        stepTotal += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        btVector3 after = ballBody->getWorldTransform().getOrigin();
+        for (size_t i = 0; i < pins.size(); ++i) {
+            const btRigidBody* pinBody = pins[i]->getPinBody();
+            if (touched[i] || tunneled[i]) continue;
+            if (inContact(dispatcher, ballBody, pinBody)) {
+                touched[i] = true;
+                continue;
+            }
+            // Quille debout sur la trajectoire de la boule, jamais touchée : traversée
+            if (!pins[i]->isKnockedDown() &&
+                segmentDistanceXZ(before, after, pinBody->getWorldTransform().getOrigin()) < reach[i]) {
+                tunneled[i] = true;
+                ++result.incidents;
+            }
+        }
+    }
+
+    for (const auto& pin : pins) {
+        if (pin->isKnockedDown()) result.pinsDown += 1.0;
+    }
+    result.stepUs += stepTotal / std::max(1, steps);
+    ++result.throws;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Options invalides (voir l'en-tête de tools/TunnelingBench.cpp)" << std::endl;
+        return 1;
+    }
+
+    // Pas de Ogre::Root : seul le LogManager est nécessaire (avertissements uniquement)
+    Ogre::LogManager logManager;
+    Ogre::Log* log = logManager.createLog("BowlingTunnelingBench.log", true, false, true);
+    log->setMinLogLevel(Ogre::LML_WARNING);
+
+    std::cout << std::right << std::setw(7) << "power" << std::setw(7) << "hz" << std::setw(12) << "m/step"
+              << std::setw(6) << "ccd" << std::setw(11) << "incidents" << std::setw(11) << "pins_down"
+              << std::setw(10) << "step_us" << std::endl;
+
+    int ccdIncidents = 0;
+    for (float power : options.powers) {
+        for (float rate : options.rates) {
+            for (bool ccd : {false, true}) {
+                Result result;
+                for (float aim : options.aims) {
+                    runThrow(power, rate, aim, ccd, options, result);
+                }
+                if (ccd) ccdIncidents += result.incidents;
+
+                std::cout << std::fixed << std::setprecision(0) << std::setw(7) << power << std::setw(7) << rate
+                          << std::setprecision(3) << std::setw(12) << power / rate
+                          << std::setw(6) << (ccd ? "on" : "off") << std::setw(11) << result.incidents
+                          << std::setprecision(1) << std::setw(11) << result.pinsDown / result.throws
+                          << std::setw(10) << result.stepUs / result.throws << std::endl;
+            }
+        }
+    }
+
+    // Code de retour non nul : la détection continue laisse encore passer des quilles
+    return ccdIncidents == 0 ? 0 : 2;
+}